@@ -0,0 +1,21 @@
+// Performance scene, run after main.js by the performance harness
+// Adds a field of particle systems on top of the test scene, for the particle simulation and vertex building
+
+var initialiseScene = Game.Initialise;
+
+Game.Initialise = function()
+{
+	initialiseScene();
+
+	Game.particles = [];
+	for (var i = 0; i < 16; ++i)
+	{
+		var particles = new ParticleSystem("particle.pfx");
+		particles.spawn("Diffuse");
+		particles.setDiffuseMap("pfx.png");
+		particles.setEffect("pfx.effect");
+		particles.setTranslation((i % 4) * 20 - 30, 0, Math.floor(i / 4) * 20 - 30);
+
+		Game.particles.push(particles);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+// Leak check, run after main.js with 'perf_scene' set to this file
+// Creates and drops polygons that alias their vertex and index data every frame, the native allocations should level off after every full collection
+// A leak quits the game before the report is written, which fails the performance harness
+
+var initialiseScene = Game.Initialise;
+var updateScene = Game.Update;
+
+Game.Initialise = function()
+{
+	initialiseScene();
+
+	Game.polygonFrames = 0;
+	Game.polygonAllocations = -1;
+}
+
+Game.Update = function(dt)
+{
+	updateScene(dt);
+
+	for (var i = 0; i < 32; ++i)
+	{
+		var polygon = new Polygon();
+		var vertices = polygon.vertexData(3);
+		var indices = polygon.indexData(3);
+
+		vertices[0] = i;
+		indices[1] = 1;
+		indices[2] = 2;
+
+		polygon.create();
+		polygon.flush();
+	}
+
+	if (++Game.polygonFrames % 120 != 0)
+	{
+		return;
+	}
+
+	Game.cleanUp();
+
+	var allocations = Profiler.gcStats().nativeAllocations;
+	if (Game.polygonAllocations >= 0 && allocations > Game.polygonAllocations)
+	{
+		Log.error("Native allocations grew from " + Game.polygonAllocations + " to " + allocations + " after " + Game.polygonFrames + " frames of polygons");
+		Game.quit();
+		return;
+	}
+
+	Game.polygonAllocations = allocations;
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+// Performance scene without rendering, for the null render device where it runs instead of main.js
+// Updates a few thousand script objects every frame and keeps a set of timers busy, for the per-object script updates and the scheduler
+
+var Agent = function(i)
+{
+	this._position = {x: i % 64, y: 0, z: Math.floor(i / 64)}
+	this._velocity = {x: Math.cos(i), y: 0, z: Math.sin(i)}
+
+	this.update = function(dt, t)
+	{
+		this._velocity.y = Math.sin(t + this._position.x) * 0.5;
+
+		this._position.x += this._velocity.x * dt;
+		this._position.y += this._velocity.y * dt;
+		this._position.z += this._velocity.z * dt;
+	}
+}
+
+Game.Initialise = function()
+{
+	Game.agents = [];
+	Game.ticks = 0;
+
+	for (var i = 0; i < 4096; ++i)
+	{
+		Game.agents.push(new Agent(i));
+	}
+
+	for (var i = 0; i < 64; ++i)
+	{
+		setInterval(function() { ++Game.ticks; }, 16 + i);
+	}
+}
+
+Game.Update = function(dt)
+{
+	var time = Game.time();
+	for (var i = 0; i < Game.agents.length; ++i)
+	{
+		Game.agents[i].update(dt, time);
+	}
+}
+
+Game.FixedUpdate = function(timeSteps, fixedDelta)
+{
+
+}
+
+Game.Draw = function(dt)
+{
+
+}
+
+Game.Shutdown = function()
+{
+
+}
+
+Game.OnReload = function(path)
+{
+
+}
\ No newline at end of file
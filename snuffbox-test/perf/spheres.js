@@ -0,0 +1,17 @@
+// Performance scene, run after main.js by the performance harness
+// Adds a grid of lit spheres on top of the test scene, for the deferred lighting and the per-object script updates
+
+var initialiseScene = Game.Initialise;
+
+Game.Initialise = function()
+{
+	initialiseScene();
+
+	for (var x = 0; x < 8; ++x)
+	{
+		for (var y = 0; y < 8; ++y)
+		{
+			Game.spheres.push(new TestSphere(x * 12 - 42, 0, y * 12 - 42));
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,582 @@
+#include "../application/binary_log.h"
+#include "../application/game.h"
+
+#include "../cvar/cvar.h"
+
+#ifdef SNUFF_WIN32
+#include <Windows.h>
+#endif
+
+#include <csignal>
+#include <exception>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+namespace snuffbox
+{
+	//-------------------------------------------------------------------------------------------
+	static thread_local bool echoing = false;
+
+#ifdef SNUFF_WIN32
+	//-------------------------------------------------------------------------------------------
+	static LPTOP_LEVEL_EXCEPTION_FILTER previous_filter = nullptr;
+
+	//-------------------------------------------------------------------------------------------
+	static LONG WINAPI OnUnhandledException(EXCEPTION_POINTERS* info)
+	{
+		BinaryLog::Instance()->Flush(true);
+		return previous_filter != nullptr ? previous_filter(info) : EXCEPTION_CONTINUE_SEARCH;
+	}
+#endif
+
+	//-------------------------------------------------------------------------------------------
+	BinaryLog::BinaryLog() :
+		open_(false),
+		echo_(true),
+		start_(std::chrono::steady_clock::now()),
+		start_seconds_(static_cast<int64_t>(std::time(nullptr))),
+		max_size_(0),
+		max_files_(0),
+		file_index_(0),
+		size_(0),
+		file_(nullptr),
+		running_(false),
+		previous_terminate_(nullptr)
+	{
+		// Plain text messages are recorded as a single string argument
+		for (int i = 0; i < DebugLogging::LogType::kRGB; ++i)
+		{
+			text_formats_[i] = Register(static_cast<DebugLogging::LogType>(i), "text", "{}");
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	BinaryLog* BinaryLog::Instance()
+	{
+		// Not allocated through AllocatedMemory, as the log has to outlive the leak check, which logs
+		static BinaryLog* log = new BinaryLog();
+		return log;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void BinaryLog::Initialise()
+	{
+		if (open_ == true)
+		{
+			return;
+		}
+
+		CVar* cvar = CVar::Instance();
+		bool found = false;
+
+		CVar::Value* path = cvar->Get("binary_log", &found);
+		if (found == false || path->IsString() == false)
+		{
+			return;
+		}
+
+		path_ = Game::Instance()->path() + "/" + path->As<CVar::String>()->value();
+
+		CVar::Value* size = cvar->Get("binary_log_size", &found);
+		max_size_ = found == true && size->IsNumber() == true && size->As<CVar::Number>()->value() >= 64.0 ? static_cast<unsigned int>(size->As<CVar::Number>()->value()) * 1024 : 8 * 1024 * 1024;
+
+		CVar::Value* files = cvar->Get("binary_log_files", &found);
+		max_files_ = found == true && files->IsNumber() == true && files->As<CVar::Number>()->value() >= 1.0 ? static_cast<unsigned int>(files->As<CVar::Number>()->value()) : 4;
+
+		CVar::Value* echo = cvar->Get("binary_log_echo", &found);
+		echo_ = found == false || echo->IsBool() == false || echo->As<CVar::Boolean>()->value() == true;
+
+		{
+			std::lock_guard<std::mutex> lock(file_mutex_);
+			if (Open() == false)
+			{
+				SNUFF_LOG_ERROR("Could not open binary log '" + FilePath(0) + "'");
+				return;
+			}
+		}
+
+		size_ = static_cast<unsigned int>(ftell(file_));
+		defined_.clear();
+		buffer_.reserve(kChunkSize);
+
+		running_ = true;
+		open_ = true;
+
+		thread_ = std::thread(&BinaryLog::Loop, this);
+
+		previous_terminate_ = std::set_terminate(OnTerminate);
+
+#ifdef SNUFF_WIN32
+		previous_filter = SetUnhandledExceptionFilter(OnUnhandledException);
+#else
+		signal(SIGSEGV, OnSignal);
+		signal(SIGFPE, OnSignal);
+		signal(SIGILL, OnSignal);
+#endif
+		signal(SIGABRT, OnSignal);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void BinaryLog::Shutdown()
+	{
+		if (open_ == false)
+		{
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(wake_mutex_);
+			running_ = false;
+		}
+
+		wake_.notify_one();
+		thread_.join();
+
+		Flush();
+		open_ = false;
+
+		std::lock_guard<std::mutex> lock(file_mutex_);
+		if (file_ != nullptr)
+		{
+			fclose(file_);
+			file_ = nullptr;
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	uint16_t BinaryLog::Register(const DebugLogging::LogType& type, const std::string& category, const std::string& format)
+	{
+		std::lock_guard<std::mutex> lock(format_mutex_);
+
+		for (size_t i = 0; i < formats_.size(); ++i)
+		{
+			const Format& existing = formats_.at(i);
+			if (existing.type == type && existing.category == category && existing.format == format)
+			{
+				return static_cast<uint16_t>(i);
+			}
+		}
+
+		// The last id is reserved, messages using it are logged as text only
+		if (formats_.size() >= 0xFFFF)
+		{
+			return 0xFFFF;
+		}
+
+		formats_.push_back({ type, category, format });
+		return static_cast<uint16_t>(formats_.size() - 1);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void BinaryLog::Text(const DebugLogging::LogType& type, const std::string& message)
+	{
+		if (open_ == false || echoing == true || type >= DebugLogging::LogType::kRGB)
+		{
+			return;
+		}
+
+		static thread_local std::string record;
+		record.clear();
+
+		uint16_t id = text_formats_[type];
+
+		Put(&record, static_cast<uint8_t>(BinaryLogFormat::RecordTypes::kMessage));
+		Put(&record, id);
+		Put(&record, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_).count()));
+		Put(&record, static_cast<uint8_t>(1));
+		Encode(&record, message);
+
+		Append(id, record);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void BinaryLog::Flush(const bool& crash)
+	{
+		if (open_ == false)
+		{
+			return;
+		}
+
+		std::vector<Chunk> chunks;
+
+		std::unique_lock<std::mutex> buffer_lock(buffer_mutex_, std::defer_lock);
+		std::unique_lock<std::mutex> file_lock(file_mutex_, std::defer_lock);
+
+		if (crash == true)
+		{
+			// The crashing thread might be holding a lock, give up on the buffer or the file instead of deadlocking
+			for (int i = 0; i < 100 && buffer_lock.try_lock() == false; ++i)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+
+			for (int i = 0; i < 100 && file_lock.try_lock() == false; ++i)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+
+			if (file_lock.owns_lock() == false)
+			{
+				return;
+			}
+		}
+		else
+		{
+			file_lock.lock();
+			buffer_lock.lock();
+		}
+
+		if (buffer_lock.owns_lock() == true)
+		{
+			chunks.swap(chunks_);
+			chunks.push_back({ std::move(buffer_), false });
+			buffer_.clear();
+			buffer_lock.unlock();
+		}
+
+		WriteChunks(chunks);
+
+		if (file_ != nullptr)
+		{
+			fflush(file_);
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool BinaryLog::is_open() const
+	{
+		return open_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void BinaryLog::Append(const uint16_t& id, const std::string& record)
+	{
+		if (id == 0xFFFF)
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(buffer_mutex_);
+
+		if (open_ == false)
+		{
+			return;
+		}
+
+		if (size_ + record.size() > max_size_ && size_ > sizeof(uint32_t) * 3 + sizeof(int64_t))
+		{
+			chunks_.push_back({ std::move(buffer_), true });
+			buffer_.clear();
+			buffer_.reserve(kChunkSize);
+
+			defined_.clear();
+			size_ = sizeof(uint32_t) * 3 + sizeof(int64_t);
+		}
+
+		size_t before = buffer_.size();
+
+		if (id >= defined_.size() || defined_[id] == false)
+		{
+			const Format* format = nullptr;
+			{
+				std::lock_guard<std::mutex> format_lock(format_mutex_);
+				format = &formats_.at(id);
+			}
+
+			uint16_t category = static_cast<uint16_t>(format->category.size() < BinaryLogFormat::kMaxString ? format->category.size() : BinaryLogFormat::kMaxString);
+			uint16_t length = static_cast<uint16_t>(format->format.size() < BinaryLogFormat::kMaxString ? format->format.size() : BinaryLogFormat::kMaxString);
+
+			Put(&buffer_, static_cast<uint8_t>(BinaryLogFormat::RecordTypes::kFormat));
+			Put(&buffer_, id);
+			Put(&buffer_, static_cast<uint8_t>(format->type));
+			Put(&buffer_, category);
+			buffer_.append(format->category.c_str(), category);
+			Put(&buffer_, length);
+			buffer_.append(format->format.c_str(), length);
+
+			if (id >= defined_.size())
+			{
+				defined_.resize(id + 1, false);
+			}
+
+			defined_[id] = true;
+		}
+
+		buffer_ += record;
+		size_ += static_cast<unsigned int>(buffer_.size() - before);
+
+		if (buffer_.size() >= kChunkSize)
+		{
+			chunks_.push_back({ std::move(buffer_), false });
+			buffer_.clear();
+			buffer_.reserve(kChunkSize);
+
+			wake_.notify_one();
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void BinaryLog::Echo(const uint16_t& id, const std::vector<std::string>& args)
+	{
+		const Format* format = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(format_mutex_);
+			if (id >= formats_.size())
+			{
+				return;
+			}
+
+			format = &formats_.at(id);
+		}
+
+		// Keeps the text message from being recorded a second time
+		echoing = true;
+		DebugLogging::Log(format->type, BinaryLogFormat::Substitute(format->format, args));
+		echoing = false;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void BinaryLog::WriteChunks(const std::vector<Chunk>& chunks)
+	{
+		for (size_t i = 0; i < chunks.size(); ++i)
+		{
+			const Chunk& chunk = chunks.at(i);
+
+			if (file_ != nullptr && chunk.data.empty() == false)
+			{
+				fwrite(chunk.data.c_str(), 1, chunk.data.size(), file_);
+			}
+
+			if (chunk.rotate == true)
+			{
+				Rotate();
+			}
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void BinaryLog::Rotate()
+	{
+		if (file_ != nullptr)
+		{
+			fclose(file_);
+			file_ = nullptr;
+		}
+
+		std::remove(FilePath(max_files_ - 1).c_str());
+
+		for (int i = static_cast<int>(max_files_) - 2; i >= 0; --i)
+		{
+			std::rename(FilePath(i).c_str(), FilePath(i + 1).c_str());
+		}
+
+		Open();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool BinaryLog::Open()
+	{
+		file_ = fopen(FilePath(0).c_str(), "wb");
+
+		if (file_ == nullptr)
+		{
+			return false;
+		}
+
+		uint32_t header[] = { BinaryLogFormat::kMagic, BinaryLogFormat::kVersion, file_index_++ };
+		fwrite(header, sizeof(uint32_t), 3, file_);
+		fwrite(&start_seconds_, sizeof(int64_t), 1, file_);
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void BinaryLog::Loop()
+	{
+		std::vector<Chunk> chunks;
+
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(wake_mutex_);
+				if (running_ == false)
+				{
+					break;
+				}
+
+				wake_.wait_for(lock, std::chrono::milliseconds(100));
+			}
+
+			std::lock_guard<std::mutex> file_lock(file_mutex_);
+			{
+				std::lock_guard<std::mutex> lock(buffer_mutex_);
+				chunks.swap(chunks_);
+
+				if (buffer_.empty() == false)
+				{
+					chunks.push_back({ std::move(buffer_), false });
+					buffer_.clear();
+					buffer_.reserve(kChunkSize);
+				}
+			}
+
+			WriteChunks(chunks);
+			chunks.clear();
+
+			if (file_ != nullptr)
+			{
+				fflush(file_);
+			}
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	std::string BinaryLog::FilePath(const int& index) const
+	{
+		return path_ + "." + std::to_string(index) + ".snlog";
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void BinaryLog::OnTerminate()
+	{
+		BinaryLog* log = Instance();
+		log->Flush(true);
+
+		if (log->previous_terminate_ != nullptr)
+		{
+			log->previous_terminate_();
+		}
+
+		std::abort();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void BinaryLog::OnSignal(int sig)
+	{
+		Instance()->Flush(true);
+
+		signal(sig, SIG_DFL);
+		raise(sig);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void BinaryLog::Encode(std::string* out, const bool& value)
+	{
+		Put(out, static_cast<uint8_t>(BinaryLogFormat::ArgumentTypes::kBool));
+		Put(out, static_cast<uint8_t>(value == true ? 1 : 0));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void BinaryLog::Encode(std::string* out, const int& value)
+	{
+		Put(out, static_cast<uint8_t>(BinaryLogFormat::ArgumentTypes::kInt));
+		Put(out, static_cast<int64_t>(value));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void BinaryLog::Encode(std::string* out, const long& value)
+	{
+		Put(out, static_cast<uint8_t>(BinaryLogFormat::ArgumentTypes::kInt));
+		Put(out, static_cast<int64_t>(value));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void BinaryLog::Encode(std::string* out, const long long& value)
+	{
+		Put(out, static_cast<uint8_t>(BinaryLogFormat::ArgumentTypes::kInt));
+		Put(out, static_cast<int64_t>(value));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void BinaryLog::Encode(std::string* out, const unsigned int& value)
+	{
+		Put(out, static_cast<uint8_t>(BinaryLogFormat::ArgumentTypes::kUInt));
+		Put(out, static_cast<uint64_t>(value));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void BinaryLog::Encode(std::string* out, const unsigned long& value)
+	{
+		Put(out, static_cast<uint8_t>(BinaryLogFormat::ArgumentTypes::kUInt));
+		Put(out, static_cast<uint64_t>(value));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void BinaryLog::Encode(std::string* out, const unsigned long long& value)
+	{
+		Put(out, static_cast<uint8_t>(BinaryLogFormat::ArgumentTypes::kUInt));
+		Put(out, static_cast<uint64_t>(value));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void BinaryLog::Encode(std::string* out, const float& value)
+	{
+		Put(out, static_cast<uint8_t>(BinaryLogFormat::ArgumentTypes::kDouble));
+		Put(out, static_cast<double>(value));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void BinaryLog::Encode(std::string* out, const double& value)
+	{
+		Put(out, static_cast<uint8_t>(BinaryLogFormat::ArgumentTypes::kDouble));
+		Put(out, value);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void BinaryLog::Encode(std::string* out, const char* value)
+	{
+		size_t length = value != nullptr ? strlen(value) : 0;
+		uint16_t clamped = static_cast<uint16_t>(length < BinaryLogFormat::kMaxString ? length : BinaryLogFormat::kMaxString);
+
+		Put(out, static_cast<uint8_t>(BinaryLogFormat::ArgumentTypes::kString));
+		Put(out, clamped);
+		out->append(value != nullptr ? value : "", clamped);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void BinaryLog::Encode(std::string* out, const std::string& value)
+	{
+		uint16_t clamped = static_cast<uint16_t>(value.size() < BinaryLogFormat::kMaxString ? value.size() : BinaryLogFormat::kMaxString);
+
+		Put(out, static_cast<uint8_t>(BinaryLogFormat::ArgumentTypes::kString));
+		Put(out, clamped);
+		out->append(value.c_str(), clamped);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void BinaryLog::EncodeAll(std::string* out)
+	{
+
+	}
+
+	//-------------------------------------------------------------------------------------------
+	std::string BinaryLog::ToText(const bool& value)
+	{
+		return value == true ? "true" : "false";
+	}
+
+	//-------------------------------------------------------------------------------------------
+	std::string BinaryLog::ToText(const char* value)
+	{
+		return value != nullptr ? value : "";
+	}
+
+	//-------------------------------------------------------------------------------------------
+	std::string BinaryLog::ToText(const std::string& value)
+	{
+		return value;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void BinaryLog::ToTextAll(std::vector<std::string>* out)
+	{
+
+	}
+
+	//-------------------------------------------------------------------------------------------
+	BinaryLog::~BinaryLog()
+	{
+		Shutdown();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,307 @@
+#pragma once
+
+#include "../application/logging.h"
+#include "../application/binary_log_format.h"
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <vector>
+
+// Logs a format id and the raw arguments to the binary log, the format is only registered once per call site
+#define SNUFF_BLOG(severity, category, type, format, ...) do { if ((severity) >= SNUFF_LOG_MIN_LEVEL) { static snuffbox::DebugLogging::Category* snuff_log_category = snuffbox::DebugLogging::FindCategory(category); if ((severity) >= snuff_log_category->level.load(std::memory_order_relaxed)) { static const uint16_t snuff_log_format = snuffbox::BinaryLog::Instance()->Register(type, category, format); snuffbox::BinaryLog::Instance()->Log(snuff_log_format,##__VA_ARGS__); } } } while (false)
+
+#define SNUFF_BLOG_DEBUG(category, format, ...) SNUFF_BLOG(SNUFF_LOG_LEVEL_DEBUG, category, snuffbox::DebugLogging::LogType::kDebug, format,##__VA_ARGS__)
+#define SNUFF_BLOG_INFO(category, format, ...) SNUFF_BLOG(SNUFF_LOG_LEVEL_INFO, category, snuffbox::DebugLogging::LogType::kInfo, format,##__VA_ARGS__)
+#define SNUFF_BLOG_SUCCESS(category, format, ...) SNUFF_BLOG(SNUFF_LOG_LEVEL_SUCCESS, category, snuffbox::DebugLogging::LogType::kSuccess, format,##__VA_ARGS__)
+#define SNUFF_BLOG_WARNING(category, format, ...) SNUFF_BLOG(SNUFF_LOG_LEVEL_WARNING, category, snuffbox::DebugLogging::LogType::kWarning, format,##__VA_ARGS__)
+#define SNUFF_BLOG_ERROR(category, format, ...) SNUFF_BLOG(SNUFF_LOG_LEVEL_ERROR, category, snuffbox::DebugLogging::LogType::kError, format,##__VA_ARGS__)
+
+namespace snuffbox
+{
+	/**
+	* @class snuffbox::BinaryLog
+	* @brief An optional log sink that writes a format id and the raw arguments of every message instead of the formatted text, rotating files by size
+	* @remarks Enabled with the 'binary_log' CVar, which is the path of the files without an extension. The current file is '<path>.0.snlog', older files are
+	* shifted up to '<path>.<binary_log_files - 1>.snlog' when the current file exceeds 'binary_log_size' kilobytes. Messages are buffered in memory and written
+	* by a background thread, the buffer is flushed on fatal errors, unhandled exceptions and crashes. Messages logged with SNUFF_BLOG_* are also
+	* formatted and logged as text, unless 'binary_log_echo' is false. The files are turned back into text with the snuffbox-log-decoder tool
+	* @author Danil Konings
+	*/
+	class BinaryLog
+	{
+	public:
+		/**
+		* @struct snuffbox::BinaryLog::Format
+		* @brief A registered message format
+		* @author Danil Konings
+		*/
+		struct Format
+		{
+			DebugLogging::LogType type; //!< The type to log the message with
+			std::string category; //!< The category of the message
+			std::string format; //!< The format, '{}' is replaced by the next argument
+		};
+
+		/**
+		* @struct snuffbox::BinaryLog::Chunk
+		* @brief A block of records waiting to be written
+		* @author Danil Konings
+		*/
+		struct Chunk
+		{
+			std::string data; //!< The records
+			bool rotate; //!< Should the file be rotated after writing this chunk?
+		};
+
+		static const unsigned int kChunkSize = 64 * 1024; //!< The size at which the writer thread is woken early
+
+	public:
+		/// Default constructor
+		BinaryLog();
+
+		/**
+		* @brief Retrieves the singleton instance of this class
+		* @return snuffbox::BinaryLog* The pointer to the singleton
+		*/
+		static BinaryLog* Instance();
+
+		/// Opens the log if the 'binary_log' CVar is set, using the 'binary_log_size', 'binary_log_files' and 'binary_log_echo' CVars
+		void Initialise();
+
+		/// Writes every buffered record, closes the log and stops the writer thread
+		void Shutdown();
+
+		/**
+		* @brief Registers a message format
+		* @param[in] type (const snuffbox::DebugLogging::LogType&) The type to log the message with
+		* @param[in] category (const std::string&) The category of the message
+		* @param[in] format (const std::string&) The format, '{}' is replaced by the next argument
+		* @return uint16_t The id of the format
+		*/
+		uint16_t Register(const DebugLogging::LogType& type, const std::string& category, const std::string& format);
+
+		/**
+		* @brief Logs a message with a registered format
+		* @param[in] id (const uint16_t&) The id of the format
+		* @param[in] args (const Args&...) The arguments, booleans, integers, floating point numbers and strings are supported
+		*/
+		template<typename... Args>
+		void Log(const uint16_t& id, const Args&... args);
+
+		/**
+		* @brief Records an already formatted text message, does nothing if the log isn't open
+		* @param[in] type (const snuffbox::DebugLogging::LogType&) The type of the message
+		* @param[in] message (const std::string&) The message
+		*/
+		void Text(const DebugLogging::LogType& type, const std::string& message);
+
+		/**
+		* @brief Writes every buffered record on the calling thread
+		* @param[in] crash (const bool&) Is the process going down? The locks are then only waited on for a short while, in case the crashing thread holds them
+		*/
+		void Flush(const bool& crash = false);
+
+		/**
+		* @return bool Is the log open?
+		*/
+		bool is_open() const;
+
+		/// Default destructor
+		~BinaryLog();
+
+	private:
+		/**
+		* @brief Appends a message record to the buffer, preceded by its format record if the current file doesn't have it yet
+		* @param[in] id (const uint16_t&) The id of the format
+		* @param[in] record (const std::string&) The message record
+		*/
+		void Append(const uint16_t& id, const std::string& record);
+
+		/**
+		* @brief Logs the text of a message that was also recorded
+		* @param[in] id (const uint16_t&) The id of the format
+		* @param[in] args (const std::vector<std::string>&) The arguments as text
+		*/
+		void Echo(const uint16_t& id, const std::vector<std::string>& args);
+
+		/**
+		* @brief Writes chunks to the file, rotating where requested
+		* @param[in] chunks (const std::vector<snuffbox::BinaryLog::Chunk>&) The chunks to write
+		*/
+		void WriteChunks(const std::vector<Chunk>& chunks);
+
+		/// Closes the current file, shifts the older files up and opens a new current file
+		void Rotate();
+
+		/**
+		* @brief Opens a file and writes the header
+		* @return bool Could the file be opened?
+		*/
+		bool Open();
+
+		/// The loop of the writer thread
+		void Loop();
+
+		/**
+		* @brief Builds the path of a file
+		* @param[in] index (const int&) The index of the file, 0 for the current file
+		* @return std::string The path
+		*/
+		std::string FilePath(const int& index) const;
+
+		/// Flushes the log before the process is terminated
+		static void OnTerminate();
+
+		/**
+		* @brief Flushes the log when a fatal signal is raised
+		* @param[in] sig (int) The signal
+		*/
+		static void OnSignal(int sig);
+
+		/**
+		* @brief Appends a value to a record in its binary representation
+		* @param[out] out (std::string*) The record to append to
+		* @param[in] value (const T&) The value to append
+		*/
+		template<typename T>
+		static void Put(std::string* out, const T& value);
+
+		// Each argument is encoded as its BinaryLogFormat::ArgumentTypes byte, followed by its value
+		static void Encode(std::string* out, const bool& value);
+		static void Encode(std::string* out, const int& value);
+		static void Encode(std::string* out, const long& value);
+		static void Encode(std::string* out, const long long& value);
+		static void Encode(std::string* out, const unsigned int& value);
+		static void Encode(std::string* out, const unsigned long& value);
+		static void Encode(std::string* out, const unsigned long long& value);
+		static void Encode(std::string* out, const float& value);
+		static void Encode(std::string* out, const double& value);
+		static void Encode(std::string* out, const char* value);
+		static void Encode(std::string* out, const std::string& value);
+
+		/// Ends the recursion of EncodeAll
+		static void EncodeAll(std::string* out);
+
+		/**
+		* @brief Encodes every argument into a record
+		* @param[out] out (std::string*) The record to append to
+		* @param[in] first (const T&) The first argument
+		* @param[in] rest (const Args&...) The remaining arguments
+		*/
+		template<typename T, typename... Args>
+		static void EncodeAll(std::string* out, const T& first, const Args&... rest);
+
+		// Converts an argument to the text it is echoed with
+		static std::string ToText(const bool& value);
+		static std::string ToText(const char* value);
+		static std::string ToText(const std::string& value);
+
+		template<typename T>
+		static std::string ToText(const T& value);
+
+		/// Ends the recursion of ToTextAll
+		static void ToTextAll(std::vector<std::string>* out);
+
+		/**
+		* @brief Converts every argument to text, for echoing
+		* @param[out] out (std::vector<std::string>*) The converted arguments
+		* @param[in] first (const T&) The first argument
+		* @param[in] rest (const Args&...) The remaining arguments
+		*/
+		template<typename T, typename... Args>
+		static void ToTextAll(std::vector<std::string>* out, const T& first, const Args&... rest);
+
+	private:
+		std::atomic<bool> open_; //!< Is the log open?
+		bool echo_; //!< Are messages with a registered format also logged as text?
+		std::chrono::steady_clock::time_point start_; //!< The time the session started
+		int64_t start_seconds_; //!< The time the session started in seconds since the epoch
+		std::string path_; //!< The path of the files without the index and extension
+		unsigned int max_size_; //!< The size in bytes a file may grow to before it is rotated
+		unsigned int max_files_; //!< The number of files to keep
+		uint32_t file_index_; //!< The number of files opened this session
+
+		std::mutex format_mutex_; //!< Guards the registered formats
+		std::deque<Format> formats_; //!< The registered formats, elements are never moved
+		uint16_t text_formats_[DebugLogging::LogType::kRGB]; //!< The formats plain text messages are recorded with, per log type
+
+		std::mutex buffer_mutex_; //!< Guards the buffer, the chunks and the written formats
+		std::string buffer_; //!< The chunk being filled
+		std::vector<Chunk> chunks_; //!< The full chunks waiting to be written
+		std::vector<bool> defined_; //!< Which formats have been written to the current file
+		unsigned int size_; //!< The size of the current file, including what is still buffered
+
+		std::mutex file_mutex_; //!< Serialises writes to the file
+		FILE* file_; //!< The current file
+
+		std::thread thread_; //!< The writer thread
+		std::mutex wake_mutex_; //!< The mutex the writer thread sleeps on
+		std::condition_variable wake_; //!< Wakes the writer thread early
+		std::atomic<bool> running_; //!< Is the writer thread running?
+
+		void (*previous_terminate_)(); //!< The terminate handler that was installed before ours
+	};
+
+	//-------------------------------------------------------------------------------------------
+	template<typename... Args>
+	inline void BinaryLog::Log(const uint16_t& id, const Args&... args)
+	{
+		if (open_ == true)
+		{
+			static thread_local std::string record;
+			record.clear();
+
+			Put(&record, static_cast<uint8_t>(BinaryLogFormat::RecordTypes::kMessage));
+			Put(&record, id);
+			Put(&record, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_).count()));
+			Put(&record, static_cast<uint8_t>(sizeof...(Args)));
+			EncodeAll(&record, args...);
+
+			Append(id, record);
+
+			if (echo_ == false)
+			{
+				return;
+			}
+		}
+
+		std::vector<std::string> text;
+		ToTextAll(&text, args...);
+		Echo(id, text);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	template<typename T>
+	inline void BinaryLog::Put(std::string* out, const T& value)
+	{
+		out->append(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	template<typename T, typename... Args>
+	inline void BinaryLog::EncodeAll(std::string* out, const T& first, const Args&... rest)
+	{
+		Encode(out, first);
+		EncodeAll(out, rest...);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	template<typename T>
+	inline std::string BinaryLog::ToText(const T& value)
+	{
+		return std::to_string(value);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	template<typename T, typename... Args>
+	inline void BinaryLog::ToTextAll(std::vector<std::string>* out, const T& first, const Args&... rest)
+	{
+		out->push_back(ToText(first));
+		ToTextAll(out, rest...);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace snuffbox
+{
+	/**
+	* @struct snuffbox::BinaryLogFormat
+	* @brief The layout of a binary log file, shared by the engine and the log decoder
+	* @remarks A file starts with the magic, the version, the index of the file within the session and the session start time in seconds since the epoch.
+	* It is followed by records that start with a RecordTypes byte. A format record (uint16 id, uint8 log type, uint16 length + category, uint16 length + format)
+	* is written before the first message that uses it in every file, so each file can be decoded on its own. A message record stores the format id,
+	* the uint64 time in microseconds since the session started, a uint8 argument count and every argument as an ArgumentTypes byte followed by its raw value.
+	* Values are stored in the byte order of the machine that wrote them
+	* @author Danil Konings
+	*/
+	struct BinaryLogFormat
+	{
+		/**
+		* @enum snuffbox::BinaryLogFormat::RecordTypes
+		* @brief The different records in a binary log file
+		* @author Danil Konings
+		*/
+		enum RecordTypes : uint8_t
+		{
+			kFormat,
+			kMessage
+		};
+
+		/**
+		* @enum snuffbox::BinaryLogFormat::ArgumentTypes
+		* @brief The different argument types of a message record
+		* @author Danil Konings
+		*/
+		enum ArgumentTypes : uint8_t
+		{
+			kBool, //!< uint8
+			kInt, //!< int64
+			kUInt, //!< uint64
+			kDouble, //!< double
+			kString //!< uint16 length + characters
+		};
+
+		static const uint32_t kMagic = 0x4C424E53; //!< 'SNBL', the first 4 bytes of every binary log file
+		static const uint32_t kVersion = 1; //!< The version of the binary log format
+		static const uint16_t kMaxString = 0xFFFF; //!< The maximum length of a string, longer strings are truncated
+
+		/**
+		* @brief Replaces every '{}' in a format with the next argument, surplus arguments are appended
+		* @param[in] format (const std::string&) The format
+		* @param[in] args (const std::vector<std::string>&) The arguments as text
+		* @return std::string The formatted message
+		*/
+		static std::string Substitute(const std::string& format, const std::vector<std::string>& args);
+	};
+
+	//-------------------------------------------------------------------------------------------
+	inline std::string BinaryLogFormat::Substitute(const std::string& format, const std::vector<std::string>& args)
+	{
+		std::string result;
+		result.reserve(format.size() + args.size() * 8);
+
+		unsigned int arg = 0;
+		for (size_t i = 0; i < format.size(); ++i)
+		{
+			if (format[i] == '{' && i + 1 < format.size() && format[i + 1] == '}' && arg < args.size())
+			{
+				result += args.at(arg++);
+				++i;
+				continue;
+			}
+
+			result += format[i];
+		}
+
+		for (; arg < args.size(); ++arg)
+		{
+			result += " " + args.at(arg);
+		}
+
+		return result;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,332 @@
+#include "../application/cpu_profiler.h"
+#include "../application/logging.h"
+
+#include "../io/io_manager.h"
+
+#include "../memory/allocated_memory.h"
+
+#include <chrono>
+
+namespace snuffbox
+{
+	//-------------------------------------------------------------------------------------------
+	static thread_local CPUProfiler::ThreadBuffer* current_buffer = nullptr;
+	static thread_local bool current_ignored = false;
+	static thread_local std::string current_name;
+
+	//-------------------------------------------------------------------------------------------
+	/**
+	* @struct snuffbox::ThreadExit
+	* @brief Releases the buffer of a thread when the thread exits, constructed once the thread creates its buffer
+	* @author Danil Konings
+	*/
+	struct ThreadExit
+	{
+		/// Default destructor
+		~ThreadExit()
+		{
+			CPUProfiler::Instance()->Release();
+		}
+	};
+
+	//-------------------------------------------------------------------------------------------
+	CPUProfiler::Scope::Scope(const char* name) :
+		name_(name),
+		start_(-1)
+	{
+		CPUProfiler* profiler = CPUProfiler::Instance();
+
+		if (profiler->enabled_ == false)
+		{
+			// The capture has ended, the buffer it was recorded into is no longer needed
+			if (current_buffer != nullptr)
+			{
+				profiler->Release();
+			}
+			return;
+		}
+
+		if (current_ignored == true)
+		{
+			return;
+		}
+
+		++profiler->Buffer()->depth;
+		start_ = profiler->Now();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	CPUProfiler::Scope::~Scope()
+	{
+		if (start_ < 0 || current_buffer == nullptr)
+		{
+			return;
+		}
+
+		CPUProfiler* profiler = CPUProfiler::Instance();
+		ThreadBuffer* buffer = current_buffer;
+
+		--buffer->depth;
+		profiler->Write(buffer, { name_, start_, profiler->Now(), buffer->depth });
+	}
+
+	//-------------------------------------------------------------------------------------------
+	CPUProfiler::CPUProfiler() :
+		enabled_(false),
+		frames_(0),
+		epoch_(0),
+		next_id_(0)
+	{
+		epoch_ = Now();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	CPUProfiler* CPUProfiler::Instance()
+	{
+		static SharedPtr<CPUProfiler> profiler = AllocatedMemory::Instance().Construct<CPUProfiler>();
+		return profiler.get();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool CPUProfiler::Capture(const int& frames, const std::string& path)
+	{
+		if (enabled_ == true)
+		{
+			SNUFF_LOG_WARNING("Attempted to start a CPU capture, but there is already a capture running");
+			return false;
+		}
+
+		if (frames <= 0)
+		{
+			SNUFF_LOG_WARNING("Attempted to capture " + std::to_string(frames) + " frames");
+			return false;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			for (unsigned int i = 0; i < buffers_.size(); ++i)
+			{
+				buffers_.at(i)->head = 0;
+				buffers_.at(i)->frame_start = 0;
+			}
+		}
+
+		last_frame_.clear();
+		frames_ = frames;
+		path_ = path;
+		enabled_ = true;
+
+		SNUFF_LOG_INFO("Capturing " + std::to_string(frames) + " frames to '" + path + "'");
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void CPUProfiler::EndFrame()
+	{
+		if (enabled_ == false)
+		{
+			return;
+		}
+
+		int64_t now = Now();
+		Write(Buffer(), { nullptr, now, now, 0 });
+
+		last_frame_.clear();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+
+			ThreadBuffer* buffer = nullptr;
+			unsigned int head, start;
+
+			for (unsigned int i = 0; i < buffers_.size(); ++i)
+			{
+				buffer = buffers_.at(i).get();
+				head = buffer->head.load(std::memory_order_acquire);
+				start = head - buffer->frame_start > kCapacity ? head - kCapacity : buffer->frame_start;
+
+				for (unsigned int j = start; j < head; ++j)
+				{
+					const Event& event = buffer->events.at(j % kCapacity);
+
+					if (event.name == nullptr)
+					{
+						continue;
+					}
+
+					Stat& stat = last_frame_[event.name];
+					stat.time += (event.end - event.start) * 1e-6;
+					++stat.calls;
+				}
+
+				buffer->frame_start = head;
+			}
+		}
+
+		if (--frames_ > 0)
+		{
+			return;
+		}
+
+		// Serialised before disabling, threads release their buffers as soon as they see the capture has ended
+		std::string trace = path_.empty() == true ? "" : Serialise();
+		enabled_ = false;
+
+		if (path_.empty() == true)
+		{
+			return;
+		}
+
+		if (IOManager::Instance()->Write(path_, trace) == false)
+		{
+			SNUFF_LOG_ERROR("Could not write the CPU capture to '" + path_ + "'");
+			return;
+		}
+
+		SNUFF_LOG_SUCCESS("Wrote the CPU capture to '" + path_ + "'");
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void CPUProfiler::SetThreadName(const std::string& name)
+	{
+		current_name = name;
+
+		if (current_buffer == nullptr)
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(mutex_);
+		current_buffer->name = name;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void CPUProfiler::IgnoreThread()
+	{
+		current_ignored = true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool CPUProfiler::capturing() const
+	{
+		return enabled_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	const std::map<std::string, CPUProfiler::Stat>& CPUProfiler::last_frame() const
+	{
+		return last_frame_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	int64_t CPUProfiler::Now() const
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count() - epoch_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	CPUProfiler::ThreadBuffer* CPUProfiler::Buffer()
+	{
+		if (current_buffer != nullptr)
+		{
+			return current_buffer;
+		}
+
+		static thread_local ThreadExit exit;
+
+		SharedPtr<ThreadBuffer> buffer = AllocatedMemory::Instance().Construct<ThreadBuffer>();
+		buffer->events.resize(kCapacity);
+
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		buffer->id = next_id_++;
+		buffer->name = current_name.empty() == true ? "Thread " + std::to_string(buffer->id) : current_name;
+		buffers_.push_back(buffer);
+
+		current_buffer = buffer.get();
+		return current_buffer;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void CPUProfiler::Release()
+	{
+		if (current_buffer == nullptr)
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		for (unsigned int i = 0; i < buffers_.size(); ++i)
+		{
+			if (buffers_.at(i).get() == current_buffer)
+			{
+				buffers_.erase(buffers_.begin() + i);
+				break;
+			}
+		}
+
+		current_buffer = nullptr;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void CPUProfiler::Write(ThreadBuffer* buffer, const Event& event)
+	{
+		unsigned int head = buffer->head.load(std::memory_order_relaxed);
+		buffer->events.at(head % kCapacity) = event;
+		buffer->head.store(head + 1, std::memory_order_release);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	std::string CPUProfiler::Serialise()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		std::string result = "{\"traceEvents\":[";
+		bool first = true;
+
+		ThreadBuffer* buffer = nullptr;
+		unsigned int head, start;
+		std::string tid;
+
+		for (unsigned int i = 0; i < buffers_.size(); ++i)
+		{
+			buffer = buffers_.at(i).get();
+			tid = std::to_string(buffer->id);
+
+			if (first == false)
+			{
+				result += ",";
+			}
+			first = false;
+
+			result += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" + tid + ",\"args\":{\"name\":\"" + buffer->name + "\"}}";
+
+			head = buffer->head.load(std::memory_order_acquire);
+			start = head > kCapacity ? head - kCapacity : 0;
+
+			for (unsigned int j = start; j < head; ++j)
+			{
+				const Event& event = buffer->events.at(j % kCapacity);
+
+				if (event.name == nullptr)
+				{
+					result += ",{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":" + tid + ",\"ts\":" + std::to_string(event.start * 1e-3) + "}";
+					continue;
+				}
+
+				result += ",{\"name\":\"" + std::string(event.name) + "\",\"cat\":\"snuffbox\",\"ph\":\"X\",\"pid\":0,\"tid\":" + tid;
+				result += ",\"ts\":" + std::to_string(event.start * 1e-3) + ",\"dur\":" + std::to_string((event.end - event.start) * 1e-3) + "}";
+			}
+		}
+
+		result += "],\"displayTimeUnit\":\"ms\"}";
+		return result;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	CPUProfiler::~CPUProfiler()
+	{
+
+	}
+}
\ No newline at end of file
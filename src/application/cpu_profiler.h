@@ -0,0 +1,187 @@
+#pragma once
+
+#include "../memory/shared_ptr.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <atomic>
+
+#define SNUFF_PROFILE_CONCAT_IMPL(a, b) a##b
+#define SNUFF_PROFILE_CONCAT(a, b) SNUFF_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef SNUFF_BUILD_SHIPPING
+#define SNUFF_PROFILE_SCOPE(name)
+#define SNUFF_PROFILE_THREAD(name)
+#define SNUFF_PROFILE_IGNORE_THREAD()
+#else
+#define SNUFF_PROFILE_SCOPE(name) snuffbox::CPUProfiler::Scope SNUFF_PROFILE_CONCAT(snuff_profile_scope_, __LINE__)(name)
+#define SNUFF_PROFILE_THREAD(name) snuffbox::CPUProfiler::Instance()->SetThreadName(name)
+#define SNUFF_PROFILE_IGNORE_THREAD() snuffbox::CPUProfiler::Instance()->IgnoreThread()
+#endif
+
+namespace snuffbox
+{
+	/**
+	* @class snuffbox::CPUProfiler
+	* @brief An instrumenting profiler for native code, scopes are recorded into a ring buffer per thread and exported as a Chrome trace
+	* @remarks Scopes are only recorded while a capture is running, the markers compile out entirely when SNUFF_BUILD_SHIPPING is defined.
+	* A thread only gets a buffer once it records a scope during a capture, the buffer is freed by the first scope the thread enters after the capture or
+	* when the thread exits
+	* @author Danil Konings
+	*/
+	class CPUProfiler
+	{
+	public:
+		/**
+		* @struct snuffbox::CPUProfiler::Event
+		* @brief A single recorded scope, frame boundaries are stored as events without a name
+		* @author Danil Konings
+		*/
+		struct Event
+		{
+			const char* name; //!< The name of the scope, must be a string literal
+			int64_t start; //!< The start time in nanoseconds since the profiler was created
+			int64_t end; //!< The end time in nanoseconds since the profiler was created
+			int depth; //!< The nesting depth of the scope on its thread
+		};
+
+		/**
+		* @struct snuffbox::CPUProfiler::ThreadBuffer
+		* @brief The ring buffer of a single thread, only ever written to by its own thread
+		* @author Danil Konings
+		*/
+		struct ThreadBuffer
+		{
+			/// Default constructor
+			ThreadBuffer() : head(0), depth(0), frame_start(0), id(0){}
+
+			std::vector<Event> events; //!< The ring of events
+			std::atomic<unsigned int> head; //!< The total number of events written, the ring index is head % kCapacity
+			int depth; //!< The current nesting depth
+			unsigned int frame_start; //!< The head at the start of the current frame
+			int id; //!< The ID of the thread in the trace
+			std::string name; //!< The name of the thread in the trace
+		};
+
+		/**
+		* @struct snuffbox::CPUProfiler::Stat
+		* @brief The aggregated time of a scope within a single frame
+		* @author Danil Konings
+		*/
+		struct Stat
+		{
+			/// Default constructor
+			Stat() : time(0.0), calls(0){}
+
+			double time; //!< The inclusive time spent in milliseconds
+			int calls; //!< The number of times the scope was entered
+		};
+
+		/**
+		* @class snuffbox::CPUProfiler::Scope
+		* @brief Records the lifetime of a C++ scope, use SNUFF_PROFILE_SCOPE instead of constructing this directly
+		* @author Danil Konings
+		*/
+		class Scope
+		{
+		public:
+			/**
+			* @brief Starts the scope
+			* @param[in] name (const char*) The name of the scope, must be a string literal
+			*/
+			Scope(const char* name);
+
+			/// Ends the scope and records it
+			~Scope();
+
+		private:
+			const char* name_; //!< The name of the scope
+			int64_t start_; //!< The start time, or -1 if nothing is being captured
+		};
+
+		static const unsigned int kCapacity = 1 << 16; //!< The number of events per thread ring buffer
+
+	public:
+		/// Default constructor
+		CPUProfiler();
+
+		/**
+		* @brief Retrieves the singleton instance of this class
+		* @return snuffbox::CPUProfiler* The pointer to the singleton
+		*/
+		static CPUProfiler* Instance();
+
+		/**
+		* @brief Starts capturing a number of frames, the trace is written once they have been captured
+		* @param[in] frames (const int&) The number of frames to capture
+		* @param[in] path (const std::string&) The path to write the trace to, relative to the game path, an empty path only aggregates the frames
+		* @return bool Was the capture started? Returns false if a capture is already running
+		*/
+		bool Capture(const int& frames, const std::string& path);
+
+		/// Marks the end of a frame, aggregates the frame and finishes the capture after the last frame
+		void EndFrame();
+
+		/**
+		* @brief Names the calling thread in the trace, this doesn't create a buffer for the thread
+		* @param[in] name (const std::string&) The name of the thread
+		*/
+		void SetThreadName(const std::string& name);
+
+		/// Never records scopes on the calling thread, for short-lived threads that shouldn't show up in a capture
+		void IgnoreThread();
+
+		/// Removes and frees the buffer of the calling thread if it has one, called when the thread exits
+		void Release();
+
+		/**
+		* @return bool Is a capture running?
+		*/
+		bool capturing() const;
+
+		/**
+		* @return const std::map<std::string, snuffbox::CPUProfiler::Stat>& The aggregated scopes of the last captured frame
+		*/
+		const std::map<std::string, Stat>& last_frame() const;
+
+		/// Default destructor
+		~CPUProfiler();
+
+	private:
+		/**
+		* @return int64_t The current time in nanoseconds since the profiler was created
+		*/
+		int64_t Now() const;
+
+		/**
+		* @return snuffbox::CPUProfiler::ThreadBuffer* The buffer of the calling thread, created on first use
+		*/
+		ThreadBuffer* Buffer();
+
+		/**
+		* @brief Writes an event to the buffer of the calling thread
+		* @param[in] buffer (snuffbox::CPUProfiler::ThreadBuffer*) The buffer of the calling thread
+		* @param[in] event (const snuffbox::CPUProfiler::Event&) The event to write
+		*/
+		void Write(ThreadBuffer* buffer, const Event& event);
+
+		/**
+		* @brief Converts the captured events to the Chrome trace event format
+		* @return std::string The stringified trace
+		*/
+		std::string Serialise();
+
+	private:
+		std::atomic<bool> enabled_; //!< Are scopes being recorded?
+		int frames_; //!< The number of frames left to capture
+		std::string path_; //!< The path to write the capture to
+		int64_t epoch_; //!< The time the profiler was created
+		int next_id_; //!< The ID of the next thread buffer, IDs aren't reused so released threads never merge in a trace
+		std::mutex mutex_; //!< Guards the list of thread buffers
+		std::vector<SharedPtr<ThreadBuffer>> buffers_; //!< The buffers of every thread that recorded a scope
+		std::map<std::string, Stat> last_frame_; //!< The aggregated scopes of the last captured frame
+	};
+}
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include "../application/frame_pacer.h"
+
+#include <thread>
+#include <cmath>
+#include <algorithm>
+
+namespace snuffbox
+{
+	//-------------------------------------------------------------------------------------------
+	const double FramePacer::kResolution = 0.05;
+
+	//-------------------------------------------------------------------------------------------
+	FramePacer::FramePacer() :
+		max_fps_(0.0),
+		sleep_mean_(1e-3),
+		sleep_variance_(0.0),
+		sleeps_(0),
+		frames_(0),
+		total_(0.0),
+		max_(0.0)
+	{
+		buckets_.resize(kBuckets, 0);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void FramePacer::Wait()
+	{
+		if (max_fps_ <= 0.0)
+		{
+			return;
+		}
+
+		Clock::duration period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / max_fps_));
+		Clock::time_point now = Clock::now();
+
+		// Frames that ran late start the next period right away, unless they are so late that catching up would rush several frames
+		if (now >= next_frame_)
+		{
+			next_frame_ = now - next_frame_ > period ? now + period : next_frame_ + period;
+			return;
+		}
+
+		while (std::chrono::duration<double>(next_frame_ - Clock::now()).count() > sleep_mean_ + std::sqrt(sleep_variance_))
+		{
+			Sleep();
+		}
+
+		while (Clock::now() < next_frame_)
+		{
+			std::this_thread::yield();
+		}
+
+		next_frame_ += period;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void FramePacer::Sleep()
+	{
+		Clock::time_point start = Clock::now();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		double observed = std::chrono::duration<double>(Clock::now() - start).count();
+
+		// The exact mean and variance until the window is full, an exponentially weighted mean and variance after that
+		// so the estimate keeps adapting to the scheduler without the variance growing with the number of sleeps
+		sleeps_ = sleeps_ < kSleepWindow ? sleeps_ + 1 : sleeps_;
+
+		double weight = 1.0 / sleeps_;
+		double delta = observed - sleep_mean_;
+
+		sleep_mean_ += weight * delta;
+		sleep_variance_ = (1.0 - weight) * (sleep_variance_ + weight * delta * delta);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void FramePacer::Record(const double& ms)
+	{
+		int bucket = static_cast<int>(ms / kResolution);
+		bucket = bucket < 0 ? 0 : (bucket >= kBuckets ? kBuckets - 1 : bucket);
+
+		++buckets_.at(bucket);
+		++frames_;
+
+		total_ += ms;
+		max_ = ms > max_ ? ms : max_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void FramePacer::Reset()
+	{
+		std::fill(buckets_.begin(), buckets_.end(), 0);
+
+		frames_ = 0;
+		total_ = 0.0;
+		max_ = 0.0;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	double FramePacer::Percentile(const double& p) const
+	{
+		if (frames_ == 0)
+		{
+			return 0.0;
+		}
+
+		double rank = std::ceil(p * 0.01 * frames_);
+		unsigned int target = rank < 1.0 ? 1 : static_cast<unsigned int>(rank);
+		unsigned int count = 0;
+
+		for (int i = 0; i < kBuckets - 1; ++i)
+		{
+			count += buckets_.at(i);
+
+			if (count >= target)
+			{
+				double upper = (i + 1) * kResolution;
+				return upper < max_ ? upper : max_;
+			}
+		}
+
+		return max_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	const double& FramePacer::max_fps() const
+	{
+		return max_fps_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	const double& FramePacer::max_frame_time() const
+	{
+		return max_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	double FramePacer::average() const
+	{
+		return frames_ > 0 ? total_ / frames_ : 0.0;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	const unsigned int& FramePacer::frames() const
+	{
+		return frames_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	double FramePacer::remaining() const
+	{
+		if (max_fps_ <= 0.0)
+		{
+			return 0.0;
+		}
+
+		double ms = std::chrono::duration<double, std::milli>(next_frame_ - Clock::now()).count();
+		return ms > 0.0 ? ms : 0.0;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void FramePacer::set_max_fps(const double& fps)
+	{
+		max_fps_ = fps < 0.0 ? 0.0 : fps;
+		next_frame_ = Clock::time_point();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	FramePacer::~FramePacer()
+	{
+
+	}
+}
\ No newline at end of file
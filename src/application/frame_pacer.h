@@ -0,0 +1,96 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+namespace snuffbox
+{
+	/**
+	* @class snuffbox::FramePacer
+	* @brief Limits the frame rate and keeps a histogram of the measured frame times
+	* @remarks Waiting sleeps in steps of a millisecond for as long as the measured accuracy of a sleep allows and spins for the remainder,
+	* which keeps frames accurate to a few microseconds without burning a core for the whole frame
+	* @author Danil Konings
+	*/
+	class FramePacer
+	{
+	public:
+		typedef std::chrono::steady_clock Clock;
+
+		static const int kBuckets = 4000; //!< The number of histogram buckets, frame times above kBuckets * kResolution go into the last bucket
+		static const double kResolution; //!< The width of a histogram bucket in milliseconds
+		static const unsigned int kSleepWindow = 1000; //!< The number of sleeps after which older sleeps start to weigh exponentially less
+
+	public:
+		/// Default constructor
+		FramePacer();
+
+		/// Waits until the next frame should start, returns immediately if the frame rate is unlimited
+		void Wait();
+
+		/**
+		* @brief Adds a frame time to the histogram
+		* @param[in] ms (const double&) The frame time in milliseconds
+		*/
+		void Record(const double& ms);
+
+		/// Clears the histogram
+		void Reset();
+
+		/**
+		* @brief Calculates a percentile of the recorded frame times
+		* @param[in] p (const double&) The percentile in the range [0, 100]
+		* @return double The upper bound of the bucket the percentile falls in, in milliseconds
+		*/
+		double Percentile(const double& p) const;
+
+		/**
+		* @return const double& The frame rate to limit to, 0 if the frame rate is unlimited
+		*/
+		const double& max_fps() const;
+
+		/**
+		* @return const double& The longest recorded frame time in milliseconds
+		*/
+		const double& max_frame_time() const;
+
+		/**
+		* @return double The average recorded frame time in milliseconds
+		*/
+		double average() const;
+
+		/**
+		* @return const unsigned int& The number of recorded frames
+		*/
+		const unsigned int& frames() const;
+
+		/**
+		* @return double The time left until the next frame should start in milliseconds, 0 if the frame rate is unlimited or the frame ran late
+		*/
+		double remaining() const;
+
+		/**
+		* @brief Sets the frame rate to limit to
+		* @param[in] fps (const double&) The frames per second, 0 or less for an unlimited frame rate
+		*/
+		void set_max_fps(const double& fps);
+
+		/// Default destructor
+		~FramePacer();
+
+	private:
+		/// Sleeps for a millisecond and updates the estimate of how long such a sleep really takes
+		void Sleep();
+
+	private:
+		double max_fps_; //!< The frame rate to limit to
+		Clock::time_point next_frame_; //!< The time the next frame should start at
+		double sleep_mean_; //!< The weighted mean of a millisecond sleep in seconds
+		double sleep_variance_; //!< The weighted variance of a millisecond sleep in seconds squared
+		unsigned int sleeps_; //!< The number of sleeps measured, capped at kSleepWindow
+		std::vector<unsigned int> buckets_; //!< The frame time histogram
+		unsigned int frames_; //!< The number of recorded frames
+		double total_; //!< The sum of all recorded frame times
+		double max_; //!< The longest recorded frame time
+	};
+}
\ No newline at end of file
@@ -1,7 +1,14 @@
 #include "../application/game.h"
 #include "../application/logging.h"
+#include "../application/scheduler.h"
+#include "../application/system_scheduler.h"
+#include "../application/cpu_profiler.h"
+#include "../application/replay.h"
+#include "../application/perf_harness.h"
 
+#ifndef SNUFF_BUILD_NULL
 #include "../platform/platform_window.h"
+#endif
 
 #include "../input/keyboard.h"
 #include "../input/mouse.h"
@@ -24,6 +31,7 @@
 #endif
 
 #include <chrono>
+#include <cmath>
 
 using namespace std::chrono;
 
@@ -34,6 +42,7 @@ namespace snuffbox
     window_(nullptr),
     keyboard_(nullptr),
     mouse_(nullptr),
+    sound_system_(nullptr),
     render_device_(nullptr),
     started_(true),
     delta_time_(0.0),
@@ -41,7 +50,14 @@ namespace snuffbox
     left_over_delta_(0.0),
     accumulated_time_(0.0),
     time_(0.0),
-    sound_system_(nullptr)
+    max_fixed_steps_(2),
+    fixed_step_policy_(FixedStepPolicy::kDrop),
+    fixed_alpha_(0.0),
+    fixed_steps_(0),
+    paused_(false),
+    delta_smoothing_(1),
+    delta_index_(0),
+    delta_count_(0)
 	{
 		CVar* cvar = CVar::Instance();
 		bool found_dir = false;
@@ -51,6 +67,54 @@ namespace snuffbox
 		SNUFF_XASSERT(src_directory != nullptr && src_directory->IsString() == true, "The 'src_directory' CVar is corrupt or is not of a string type!", "Game::Game");
 
 		path_ = src_directory->As<CVar::String>()->value();
+
+		// The tunables are applied when they change, so they can be tuned live without reading the CVars every frame
+		CVar::ChangeCallback on_max_fps = [this](const std::string& name, CVar::Value* value)
+		{
+			if (value->IsNumber() == true)
+			{
+				pacer_.set_max_fps(value->As<CVar::Number>()->value());
+			}
+		};
+
+		CVar::ChangeCallback on_max_fixed_steps = [this](const std::string& name, CVar::Value* value)
+		{
+			if (value->IsNumber() == true)
+			{
+				set_max_fixed_steps(static_cast<int>(value->As<CVar::Number>()->value()));
+			}
+		};
+
+		CVar::ChangeCallback on_fixed_step_policy = [this](const std::string& name, CVar::Value* value)
+		{
+			if (value->IsString() == true)
+			{
+				set_fixed_step_policy(value->As<CVar::String>()->value() == "carry" ? FixedStepPolicy::kCarry : FixedStepPolicy::kDrop);
+			}
+		};
+
+		CVar::ChangeCallback on_delta_smoothing = [this](const std::string& name, CVar::Value* value)
+		{
+			if (value->IsNumber() == true)
+			{
+				set_delta_smoothing(static_cast<int>(value->As<CVar::Number>()->value()));
+			}
+		};
+
+		const std::string names[] = { "max_fps", "max_fixed_steps", "fixed_step_policy", "delta_smoothing" };
+		const CVar::ChangeCallback callbacks[] = { on_max_fps, on_max_fixed_steps, on_fixed_step_policy, on_delta_smoothing };
+
+		bool found = false;
+		for (unsigned int i = 0; i < sizeof(names) / sizeof(std::string); ++i)
+		{
+			cvar->Listen(names[i], callbacks[i]);
+
+			CVar::Value* value = cvar->Get(names[i], &found);
+			if (found == true)
+			{
+				callbacks[i](names[i], value);
+			}
+		}
 	}
 
 	//-------------------------------------------------------------------------------------------
@@ -63,11 +127,15 @@ namespace snuffbox
 	//-------------------------------------------------------------------------------------------
 	void Game::Verify()
 	{
-		SNUFF_ASSERT_NOTNULL(window_, "Game::Verify::Window");
 		SNUFF_ASSERT_NOTNULL(keyboard_, "Game::Verify::Keyboard");
 		SNUFF_ASSERT_NOTNULL(mouse_, "Game::Verify::Mouse");
 		SNUFF_ASSERT_NOTNULL(render_device_, "Game::Verify::RenderDevice");
 
+		if (render_device_->headless() == false)
+		{
+			SNUFF_ASSERT_NOTNULL(window_, "Game::Verify::Window");
+		}
+
     js_init_.Set("Game", "Initialise");
     js_update_.Set("Game", "Update");
 		js_fixed_update_.Set("Game", "FixedUpdate");
@@ -86,14 +154,26 @@ namespace snuffbox
 	//-------------------------------------------------------------------------------------------
 	void Game::UpdateInput()
 	{
-		window_->ProcessMessages();
+#ifndef SNUFF_BUILD_NULL
+		if (window_ != nullptr)
+		{
+			window_->ProcessMessages();
+		}
+#endif
+		Replay::Instance()->EndInput();
+
 		keyboard_->Update();
 		mouse_->Update();
+
+		SystemScheduler::Instance()->Run(SystemScheduler::Phases::kInput, delta_time_);
 	}
 
 	//-------------------------------------------------------------------------------------------
 	void Game::Update()
 	{
+		SNUFF_PROFILE_SCOPE("Game::Update");
+
+		SystemScheduler::Instance()->Run(SystemScheduler::Phases::kUpdate, delta_time_);
 		js_update_.Call(delta_time_);
 
     if (started_ == false)
@@ -101,6 +181,14 @@ namespace snuffbox
       return;
     }
 
+		double dt = delta_time_ * 1000.0;
+		Scheduler::Instance()->Update(dt, paused_ == true ? 0.0 : dt);
+
+		if (paused_ == true)
+		{
+			return;
+		}
+
 		time_ += delta_time_;
 
 		FixedUpdate();
@@ -109,19 +197,38 @@ namespace snuffbox
 	//-------------------------------------------------------------------------------------------
 	void Game::FixedUpdate()
 	{
+		SNUFF_PROFILE_SCOPE("Game::FixedUpdate");
+
 		accumulated_time_ += delta_time_ * 1000;
 		int time_steps = 0;
-		double fixed_delta = 1000.0f / fixed_step_;
-
-		accumulated_time_ = std::min(accumulated_time_, static_cast<double>(fixed_delta * 2));
+		double fixed_delta = 1000.0 / fixed_step_;
 
-		while (accumulated_time_ > fixed_delta)
+		while (accumulated_time_ >= fixed_delta && time_steps < max_fixed_steps_)
 		{
 			++time_steps;
+			++fixed_steps_;
+			SystemScheduler::Instance()->Run(SystemScheduler::Phases::kFixedUpdate, fixed_delta / 1000.0);
 			js_fixed_update_.Call(time_steps, fixed_delta);
 
 			accumulated_time_ -= fixed_delta;
 		}
+
+		if (accumulated_time_ >= fixed_delta)
+		{
+			switch (fixed_step_policy_)
+			{
+			case FixedStepPolicy::kDrop:
+				accumulated_time_ = std::fmod(accumulated_time_, fixed_delta);
+				break;
+
+			case FixedStepPolicy::kCarry:
+				// A backlog of more than a second is never caught up with, so a long hitch can't stall the following frames
+				accumulated_time_ = std::min(accumulated_time_, std::max(1000.0, fixed_delta * max_fixed_steps_));
+				break;
+			}
+		}
+
+		fixed_alpha_ = std::min(accumulated_time_ / fixed_delta, 1.0);
 	}
 
 	//-------------------------------------------------------------------------------------------
@@ -143,8 +250,8 @@ namespace snuffbox
 	//-------------------------------------------------------------------------------------------
 	void Game::SetTimePoint()
 	{
-		last_time_ = high_resolution_clock::now();
-		current_time_ = high_resolution_clock::now();
+		last_time_ = steady_clock::now();
+		current_time_ = steady_clock::now();
 	}
 
 	//-------------------------------------------------------------------------------------------
@@ -154,6 +261,9 @@ namespace snuffbox
 		{
 			return;
 		}
+
+		SNUFF_PROFILE_SCOPE("Game::Run");
+
     sound_system_->Update();
 		CalculateDeltaTime();
     UpdateConsole();
@@ -165,9 +275,39 @@ namespace snuffbox
 	//-------------------------------------------------------------------------------------------
 	void Game::CalculateDeltaTime()
 	{
-		current_time_ = high_resolution_clock::now();
-		delta_time_ = duration_cast<duration<float, std::milli>>(current_time_ - last_time_).count() * 1e-3f;
+		current_time_ = steady_clock::now();
+		double measured = duration<double>(current_time_ - last_time_).count();
 		last_time_ = current_time_;
+
+		pacer_.Record(measured * 1e3);
+		delta_time_ = SmoothDelta(PerfHarness::Instance()->DeltaTime(Replay::Instance()->DeltaTime(measured)));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	double Game::SmoothDelta(const double& dt)
+	{
+		if (delta_smoothing_ <= 1)
+		{
+			return dt;
+		}
+
+		deltas_[delta_index_] = dt;
+		delta_index_ = (delta_index_ + 1) % delta_smoothing_;
+		delta_count_ = delta_count_ < delta_smoothing_ ? delta_count_ + 1 : delta_count_;
+
+		double total = 0.0;
+		for (int i = 0; i < delta_count_; ++i)
+		{
+			total += deltas_[i];
+		}
+
+		return total / delta_count_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Game::WaitForFrame()
+	{
+		pacer_.Wait();
 	}
 
 	//-------------------------------------------------------------------------------------------
@@ -191,11 +331,16 @@ namespace snuffbox
 	//-------------------------------------------------------------------------------------------
 	void Game::Draw()
 	{
+		SNUFF_PROFILE_SCOPE("Game::Draw");
+
+		SystemScheduler::Instance()->Run(SystemScheduler::Phases::kPreRender, delta_time_);
+
     render_device_->StartDraw();
-		js_draw_.Call(delta_time_);
+		js_draw_.Call(delta_time_, fixed_alpha_);
     render_device_->Draw();
 	}
 
+#ifndef SNUFF_BUILD_NULL
 	//-------------------------------------------------------------------------------------------
 	void Game::Render(D3D11Camera* camera, D3D11RenderTarget* target)
 	{
@@ -214,6 +359,7 @@ namespace snuffbox
 
     render_device_->ReceiveCommand(cmd);
 	}
+#endif
 
 	//-------------------------------------------------------------------------------------------
 	void Game::Notify(const Game::GameNotifications& evt)
@@ -292,6 +438,48 @@ namespace snuffbox
 		return delta_time_;
 	}
 
+	//-------------------------------------------------------------------------------------------
+	const bool& Game::paused() const
+	{
+		return paused_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	const int& Game::max_fixed_steps() const
+	{
+		return max_fixed_steps_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	const Game::FixedStepPolicy& Game::fixed_step_policy() const
+	{
+		return fixed_step_policy_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	const double& Game::fixed_alpha() const
+	{
+		return fixed_alpha_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	const unsigned int& Game::fixed_steps() const
+	{
+		return fixed_steps_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	const int& Game::delta_smoothing() const
+	{
+		return delta_smoothing_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	FramePacer* Game::pacer()
+	{
+		return &pacer_;
+	}
+
 	//-------------------------------------------------------------------------------------------
 	void Game::set_window(Window* window)
 	{
@@ -332,6 +520,32 @@ namespace snuffbox
 		time_ = time;
 	}
 
+	//-------------------------------------------------------------------------------------------
+	void Game::set_paused(const bool& paused)
+	{
+		paused_ = paused;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Game::set_max_fixed_steps(const int& steps)
+	{
+		max_fixed_steps_ = steps < 1 ? 1 : steps;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Game::set_fixed_step_policy(const FixedStepPolicy& policy)
+	{
+		fixed_step_policy_ = policy;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Game::set_delta_smoothing(const int& frames)
+	{
+		delta_smoothing_ = frames < 1 ? 1 : (frames > kMaxSmoothing ? kMaxSmoothing : frames);
+		delta_index_ = 0;
+		delta_count_ = 0;
+	}
+
 	//-------------------------------------------------------------------------------------------
 	Game::~Game()
 	{
@@ -345,8 +559,21 @@ namespace snuffbox
 			{ "quit", JSQuit },
 			{ "time", JSTime },
 			{ "setTime", JSSetTime },
+			{ "paused", JSPaused },
+			{ "setPaused", JSSetPaused },
 			{ "fixedStep", JSFixedStep },
 			{ "setFixedStep", JSSetFixedStep },
+			{ "maxFixedSteps", JSMaxFixedSteps },
+			{ "setMaxFixedSteps", JSSetMaxFixedSteps },
+			{ "fixedStepPolicy", JSFixedStepPolicy },
+			{ "setFixedStepPolicy", JSSetFixedStepPolicy },
+			{ "fixedAlpha", JSFixedAlpha },
+			{ "maxFPS", JSMaxFPS },
+			{ "setMaxFPS", JSSetMaxFPS },
+			{ "deltaSmoothing", JSDeltaSmoothing },
+			{ "setDeltaSmoothing", JSSetDeltaSmoothing },
+			{ "frameStats", JSFrameStats },
+			{ "resetFrameStats", JSResetFrameStats },
 			{ "render", JSRender },
       { "cleanUp", JSCleanUp }
 		};
@@ -375,6 +602,21 @@ namespace snuffbox
 		Game::Instance()->set_time(wrapper.GetValue<double>(0, 0.0));
 	}
 
+	//-------------------------------------------------------------------------------------------
+	void Game::JSPaused(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		wrapper.ReturnValue<bool>(Game::Instance()->paused());
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Game::JSSetPaused(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		wrapper.Check("B");
+		Game::Instance()->set_paused(wrapper.GetValue<bool>(0, false));
+	}
+
 	//-------------------------------------------------------------------------------------------
 	void Game::JSFixedStep(JS_ARGS args)
 	{
@@ -390,13 +632,115 @@ namespace snuffbox
 		Game::Instance()->set_fixed_step(wrapper.GetValue<double>(0, 0.0));
 	}
 
+	//-------------------------------------------------------------------------------------------
+	void Game::JSMaxFixedSteps(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		wrapper.ReturnValue<int>(Game::Instance()->max_fixed_steps());
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Game::JSSetMaxFixedSteps(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		wrapper.Check("N");
+		Game::Instance()->set_max_fixed_steps(wrapper.GetValue<int>(0, 2));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Game::JSFixedStepPolicy(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		wrapper.ReturnValue<std::string>(Game::Instance()->fixed_step_policy() == FixedStepPolicy::kCarry ? "carry" : "drop");
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Game::JSSetFixedStepPolicy(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		if (wrapper.Check("S") == false)
+		{
+			return;
+		}
+
+		std::string policy = wrapper.GetValue<std::string>(0, "drop");
+		if (policy != "drop" && policy != "carry")
+		{
+			SNUFF_LOG_WARNING("Unknown fixed step policy '" + policy + "', expected 'drop' or 'carry'");
+			return;
+		}
+
+		Game::Instance()->set_fixed_step_policy(policy == "carry" ? FixedStepPolicy::kCarry : FixedStepPolicy::kDrop);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Game::JSFixedAlpha(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		wrapper.ReturnValue<double>(Game::Instance()->fixed_alpha());
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Game::JSMaxFPS(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		wrapper.ReturnValue<double>(Game::Instance()->pacer()->max_fps());
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Game::JSSetMaxFPS(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		wrapper.Check("N");
+		Game::Instance()->pacer()->set_max_fps(wrapper.GetValue<double>(0, 0.0));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Game::JSDeltaSmoothing(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		wrapper.ReturnValue<int>(Game::Instance()->delta_smoothing());
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Game::JSSetDeltaSmoothing(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		wrapper.Check("N");
+		Game::Instance()->set_delta_smoothing(wrapper.GetValue<int>(0, 1));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Game::JSFrameStats(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		FramePacer* pacer = Game::Instance()->pacer();
+
+		v8::Handle<v8::Object> obj = JSWrapper::CreateObject();
+		JSWrapper::SetObjectValue<double>(obj, "frames", pacer->frames());
+		JSWrapper::SetObjectValue<double>(obj, "average", pacer->average());
+		JSWrapper::SetObjectValue<double>(obj, "p50", pacer->Percentile(50.0));
+		JSWrapper::SetObjectValue<double>(obj, "p99", pacer->Percentile(99.0));
+		JSWrapper::SetObjectValue<double>(obj, "max", pacer->max_frame_time());
+
+		wrapper.ReturnValue<v8::Handle<v8::Object>>(obj);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Game::JSResetFrameStats(JS_ARGS args)
+	{
+		Game::Instance()->pacer()->Reset();
+	}
+
 	//-------------------------------------------------------------------------------------------
 	void Game::JSRender(JS_ARGS args)
 	{
+#ifndef SNUFF_BUILD_NULL
 		JSWrapper wrapper(args);
 		wrapper.Check("OO");
 
     Game::Instance()->Render(wrapper.GetPointer<D3D11Camera>(0), wrapper.GetPointer<D3D11RenderTarget>(1));
+#endif
 	}
 
   //-------------------------------------------------------------------------------------------
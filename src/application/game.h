@@ -5,6 +5,8 @@
 
 #include <chrono>
 
+#include "../application/frame_pacer.h"
+
 #include "../platform/platform_render_device.h"
 
 namespace snuffbox
@@ -27,6 +29,16 @@ namespace snuffbox
 			kReload
 		};
 
+		/**
+		* @enum snuffbox::Game::FixedStepPolicy
+		* @brief What to do with the time that is left once the maximum number of fixed steps has been taken in a frame
+		*/
+		enum FixedStepPolicy
+		{
+			kDrop, //!< Drops the whole steps that are left, gameplay slows down under load but never has to catch up
+			kCarry //!< Carries the steps that are left over to the next frames, gameplay keeps real time by catching up over several frames
+		};
+
 	public:
 		/// Default constructor
 		Game();
@@ -64,18 +76,23 @@ namespace snuffbox
 		/// Calculates the delta time
 		void CalculateDeltaTime();
 
+		/// Waits for the frame limiter, should be called at the very end of a frame
+		void WaitForFrame();
+
 		/// Reloads the game
 		void Reload();
 
 		/// Draws the game
 		void Draw();
 
+#ifndef SNUFF_BUILD_NULL
 		/**
 		* @brief Renders to the window from a specified camera
 		* @param[in] camera snuffbox::D3D11Camera* The camera to render from
     * @param[in] target snuffbox::D3D11RenderTarget* The target to render from
 		*/
     void Render(D3D11Camera* camera, D3D11RenderTarget* target);
+#endif
 
 		/**
 		* @brief Sends a notification to the game instance
@@ -97,7 +114,7 @@ namespace snuffbox
 		const bool& started() const;
 
 		/**
-		* @return snuffbox::Window* The window associated with this instance of the engine
+		* @return snuffbox::Window* The window associated with this instance of the engine, nullptr when running headless
 		*/
 		Window* window();
 
@@ -131,6 +148,41 @@ namespace snuffbox
 		*/
 		const double& delta_time() const;
 
+		/**
+		* @return const bool& Is the game paused? Game time and fixed updates stand still while paused
+		*/
+		const bool& paused() const;
+
+		/**
+		* @return const int& The maximum number of fixed steps taken in a single frame
+		*/
+		const int& max_fixed_steps() const;
+
+		/**
+		* @return const snuffbox::Game::FixedStepPolicy& What happens to the time left after the maximum number of fixed steps
+		*/
+		const FixedStepPolicy& fixed_step_policy() const;
+
+		/**
+		* @return const double& How far the game is between the last and the next fixed step, in the range [0, 1]
+		*/
+		const double& fixed_alpha() const;
+
+		/**
+		* @return const unsigned int& The number of fixed steps taken since the game started, used to detect whether state changed during the last step
+		*/
+		const unsigned int& fixed_steps() const;
+
+		/**
+		* @return const int& The number of frames the delta time is averaged over, 1 disables smoothing
+		*/
+		const int& delta_smoothing() const;
+
+		/**
+		* @return snuffbox::FramePacer* The frame limiter and frame time histogram of the game
+		*/
+		FramePacer* pacer();
+
 		/**
 		* @brief Sets the window of this object
 		* @param[in] window (snuffbox::Window*) The window to be associated with this instance of the engine
@@ -167,9 +219,43 @@ namespace snuffbox
 		*/
 		void set_time(const double& time);
 
+		/**
+		* @brief Pauses or resumes the game
+		* @param[in] paused (const bool&) Should the game be paused?
+		*/
+		void set_paused(const bool& paused);
+
+		/**
+		* @brief Sets the maximum number of fixed steps taken in a single frame
+		* @param[in] steps (const int&) The number of steps, at least 1
+		*/
+		void set_max_fixed_steps(const int& steps);
+
+		/**
+		* @brief Sets what happens to the time left after the maximum number of fixed steps
+		* @param[in] policy (const snuffbox::Game::FixedStepPolicy&) The policy to use
+		*/
+		void set_fixed_step_policy(const FixedStepPolicy& policy);
+
+		/**
+		* @brief Sets the number of frames the delta time is averaged over
+		* @param[in] frames (const int&) The number of frames, clamped to [1, kMaxSmoothing]
+		*/
+		void set_delta_smoothing(const int& frames);
+
 		/// Default destructor
 		~Game();
 
+	private:
+		/**
+		* @brief Averages a delta time with the delta times of previous frames
+		* @param[in] dt (const double&) The delta time of this frame
+		* @return double The smoothed delta time
+		*/
+		double SmoothDelta(const double& dt);
+
+		static const int kMaxSmoothing = 32; //!< The maximum number of frames the delta time can be averaged over
+
 	private:
 		std::string path_; //!< The path the game is running in
 		Window* window_; //!< The window the game is running in
@@ -179,17 +265,27 @@ namespace snuffbox
 		PlatformRenderDevice* render_device_; //!< The render device the game currently uses
 		bool started_; //!< Is the game started?
 		double delta_time_; //!< The delta time since the previous frame
-		std::chrono::high_resolution_clock::time_point last_time_; //!< What was the time the last time?
-		std::chrono::high_resolution_clock::time_point current_time_; //!< What was the time the last time?
+		std::chrono::steady_clock::time_point last_time_; //!< What was the time the last time?
+		std::chrono::steady_clock::time_point current_time_; //!< What was the time the last time?
 		double fixed_step_; //!< The current fixed time step
 		double left_over_delta_; //!< The unused delta time since last frame
 		double accumulated_time_; //!< The total accumulated time since last frame
 		double time_; //!< The current game time
+		int max_fixed_steps_; //!< The maximum number of fixed steps per frame
+		FixedStepPolicy fixed_step_policy_; //!< What happens to the time left after the maximum number of fixed steps
+		double fixed_alpha_; //!< How far the game is between the last and the next fixed step
+		unsigned int fixed_steps_; //!< The number of fixed steps taken since the game started
+		bool paused_; //!< Is the game paused?
+		FramePacer pacer_; //!< The frame limiter and frame time histogram
+		int delta_smoothing_; //!< The number of frames the delta time is averaged over
+		double deltas_[kMaxSmoothing]; //!< The delta times of the previous frames, used for smoothing
+		int delta_index_; //!< The index to write the next delta time to
+		int delta_count_; //!< The number of delta times in the smoothing window
 
     JSCallback<> js_init_; //!< The initialisation callback
     JSCallback<double> js_update_;  //!< The update callback
 		JSCallback<int, double> js_fixed_update_; //!< The fixed update callback
-		JSCallback<double> js_draw_; //!< The draw callback
+		JSCallback<double, double> js_draw_; //!< The draw callback, receives the delta time and the fixed step interpolation alpha
 		JSCallback<> js_shutdown_; //!< The shutdown callback
 		JSCallback<std::string> js_on_reload_; //!< The on-reload callback
 
@@ -199,8 +295,21 @@ namespace snuffbox
 		static void JSQuit(JS_ARGS args);
 		static void JSTime(JS_ARGS args);
 		static void JSSetTime(JS_ARGS args);
+		static void JSPaused(JS_ARGS args);
+		static void JSSetPaused(JS_ARGS args);
 		static void JSFixedStep(JS_ARGS args);
 		static void JSSetFixedStep(JS_ARGS args);
+		static void JSMaxFixedSteps(JS_ARGS args);
+		static void JSSetMaxFixedSteps(JS_ARGS args);
+		static void JSFixedStepPolicy(JS_ARGS args);
+		static void JSSetFixedStepPolicy(JS_ARGS args);
+		static void JSFixedAlpha(JS_ARGS args);
+		static void JSMaxFPS(JS_ARGS args);
+		static void JSSetMaxFPS(JS_ARGS args);
+		static void JSDeltaSmoothing(JS_ARGS args);
+		static void JSSetDeltaSmoothing(JS_ARGS args);
+		static void JSFrameStats(JS_ARGS args);
+		static void JSResetFrameStats(JS_ARGS args);
 		static void JSRender(JS_ARGS args);
     static void JSCleanUp(JS_ARGS args);
 	};
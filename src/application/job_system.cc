@@ -0,0 +1,386 @@
+#include "../application/job_system.h"
+#include "../application/logging.h"
+#include "../application/cpu_profiler.h"
+
+#include "../cvar/cvar.h"
+
+#include "../memory/allocated_memory.h"
+
+#include <chrono>
+#include <cmath>
+
+namespace snuffbox
+{
+	//-------------------------------------------------------------------------------------------
+	static thread_local int current_worker = -1;
+
+	//-------------------------------------------------------------------------------------------
+	JobSystem::JobSystem() :
+		workers_(1),
+		pending_(0),
+		running_(false),
+		profiled_(true)
+	{
+
+	}
+
+	//-------------------------------------------------------------------------------------------
+	JobSystem* JobSystem::Instance()
+	{
+		static SharedPtr<JobSystem> job_system = AllocatedMemory::Instance().Construct<JobSystem>();
+		return job_system.get();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JobSystem::Initialise(const int& workers, const bool& profiled)
+	{
+		if (running_ == true)
+		{
+			Shutdown();
+		}
+
+		workers_ = workers;
+		profiled_ = profiled;
+
+		if (workers_ <= 0)
+		{
+			bool found = false;
+			CVar::Value* value = CVar::Instance()->Get("job_workers", &found);
+
+			if (found == true && value->IsNumber() == true)
+			{
+				workers_ = static_cast<int>(value->As<CVar::Number>()->value());
+			}
+			else
+			{
+				workers_ = static_cast<int>(std::thread::hardware_concurrency());
+			}
+		}
+
+		workers_ = workers_ < 1 ? 1 : workers_;
+
+		queues_.clear();
+		for (int i = 0; i < workers_; ++i)
+		{
+			queues_.push_back(AllocatedMemory::Instance().Construct<Worker>());
+		}
+
+		current_worker = 0;
+		running_ = true;
+
+		for (int i = 1; i < workers_; ++i)
+		{
+			threads_.push_back(std::thread(&JobSystem::Loop, this, i));
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JobSystem::Shutdown()
+	{
+		if (running_ == false)
+		{
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(sleep_mutex_);
+			running_ = false;
+		}
+
+		signal_.notify_all();
+
+		for (unsigned int i = 0; i < threads_.size(); ++i)
+		{
+			threads_.at(i).join();
+		}
+
+		threads_.clear();
+
+		Job job;
+		while (Find(0, &job) == true)
+		{
+			Execute(job);
+		}
+
+		workers_ = 1;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JobSystem::Run(JobFunction func, void* data, const int& start, const int& end, Counter* counter)
+	{
+		Job job = { func, data, start, end, counter };
+
+		if (counter != nullptr)
+		{
+			++counter->value;
+		}
+
+		int index = WorkerIndex();
+		if (running_ == false || workers_ == 1 || index < 0)
+		{
+			Execute(job);
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(sleep_mutex_);
+			++pending_;
+		}
+
+		Worker* worker = queues_.at(index).get();
+		{
+			std::lock_guard<std::mutex> lock(worker->mutex);
+			worker->jobs.push_back(job);
+		}
+
+		signal_.notify_one();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JobSystem::Dispatch(JobFunction func, void* data, const int& count, const int& grain, Counter* counter)
+	{
+		if (count <= 0)
+		{
+			return;
+		}
+
+		int size = grain < 1 ? 1 : grain;
+		int index = WorkerIndex();
+
+		if (running_ == false || workers_ == 1 || index < 0 || count <= size)
+		{
+			func(data, 0, count);
+			return;
+		}
+
+		Job job = { func, data, 0, 0, counter };
+		int jobs = (count + size - 1) / size;
+
+		if (counter != nullptr)
+		{
+			counter->value += jobs;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(sleep_mutex_);
+			pending_ += jobs;
+		}
+
+		Worker* worker = queues_.at(index).get();
+		{
+			std::lock_guard<std::mutex> lock(worker->mutex);
+			for (int start = 0; start < count; start += size)
+			{
+				job.start = start;
+				job.end = start + size < count ? start + size : count;
+
+				worker->jobs.push_back(job);
+			}
+		}
+
+		signal_.notify_all();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JobSystem::Wait(Counter* counter)
+	{
+		int index = WorkerIndex();
+		Job job;
+
+		while (counter->value.load() > 0)
+		{
+			if (index >= 0 && Find(index, &job) == true)
+			{
+				Execute(job);
+				continue;
+			}
+
+			std::this_thread::yield();
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	std::vector<double> JobSystem::Benchmark(const int& items, const int& iterations)
+	{
+		typedef std::chrono::high_resolution_clock Clock;
+
+		int current = JobSystem::Instance()->workers();
+		int max = static_cast<int>(std::thread::hardware_concurrency());
+		max = max < current ? current : max;
+		max = max < 1 ? 1 : max;
+
+		std::vector<float> results(items);
+		std::vector<double> timings;
+
+		auto workload = [&results](const int& start, const int& end)
+		{
+			float value;
+			for (int i = start; i < end; ++i)
+			{
+				value = static_cast<float>(i);
+				for (int j = 0; j < 64; ++j)
+				{
+					value = std::sqrt(value * value + 1.0f) * std::sin(value);
+				}
+				results[i] = value;
+			}
+		};
+
+		int grain = items / (max * 4);
+		grain = grain < 64 ? 64 : grain;
+
+		Clock::time_point start;
+		for (int workers = 1; workers <= max; ++workers)
+		{
+			SharedPtr<JobSystem> system = AllocatedMemory::Instance().Construct<JobSystem>();
+			system->Initialise(workers, false);
+
+			start = Clock::now();
+			for (int i = 0; i < iterations; ++i)
+			{
+				system->ParallelFor(items, grain, workload);
+			}
+
+			timings.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count() / iterations);
+			system->Shutdown();
+		}
+
+		return timings;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	const int& JobSystem::workers() const
+	{
+		return workers_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JobSystem::Loop(const int& index)
+	{
+		current_worker = index;
+
+		if (profiled_ == true)
+		{
+			SNUFF_PROFILE_THREAD("Worker " + std::to_string(index));
+		}
+		else
+		{
+			SNUFF_PROFILE_IGNORE_THREAD();
+		}
+
+		Job job;
+
+		while (running_ == true)
+		{
+			if (Find(index, &job) == true)
+			{
+				Execute(job);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(sleep_mutex_);
+			signal_.wait(lock, [this]{ return pending_ > 0 || running_ == false; });
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool JobSystem::Find(const int& index, Job* job)
+	{
+		Worker* worker = queues_.at(index).get();
+		{
+			std::lock_guard<std::mutex> lock(worker->mutex);
+			if (worker->jobs.empty() == false)
+			{
+				*job = worker->jobs.back();
+				worker->jobs.pop_back();
+				--pending_;
+				return true;
+			}
+		}
+
+		for (int i = 1; i < workers_; ++i)
+		{
+			worker = queues_.at((index + i) % workers_).get();
+
+			std::lock_guard<std::mutex> lock(worker->mutex);
+			if (worker->jobs.empty() == false)
+			{
+				*job = worker->jobs.front();
+				worker->jobs.pop_front();
+				--pending_;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JobSystem::Execute(const Job& job)
+	{
+		SNUFF_PROFILE_SCOPE("JobSystem::Execute");
+
+		job.func(job.data, job.start, job.end);
+
+		if (job.counter != nullptr)
+		{
+			--job.counter->value;
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	int JobSystem::WorkerIndex()
+	{
+		return current_worker;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	JobSystem::~JobSystem()
+	{
+		Shutdown();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JobSystem::RegisterJS(JS_SINGLETON obj)
+	{
+		JSFunctionRegister funcs[] = {
+			{ "workers", JSWorkers },
+			{ "benchmark", JSBenchmark }
+		};
+
+		JSFunctionRegister::Register(funcs, sizeof(funcs) / sizeof(JSFunctionRegister), obj);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JobSystem::JSWorkers(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		wrapper.ReturnValue<int>(JobSystem::Instance()->workers());
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JobSystem::JSBenchmark(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+
+		int items = wrapper.GetValue<int>(0, 1 << 16);
+		int iterations = wrapper.GetValue<int>(1, 10);
+
+		if (items <= 0 || iterations <= 0)
+		{
+			SNUFF_LOG_WARNING("Attempted to benchmark the job system with " + std::to_string(items) + " items and " + std::to_string(iterations) + " iterations");
+			return;
+		}
+
+		std::vector<double> timings = JobSystem::Benchmark(items, iterations);
+		v8::Handle<v8::Array> arr = JSWrapper::CreateArray();
+
+		for (unsigned int i = 0; i < timings.size(); ++i)
+		{
+			SNUFF_LOG_INFO(std::to_string(i + 1) + " worker(s): " + std::to_string(timings.at(i)) + " ms, " + std::to_string(timings.front() / timings.at(i)) + "x");
+			JSWrapper::SetArrayValue<double>(arr, i, timings.at(i));
+		}
+
+		wrapper.ReturnValue<v8::Handle<v8::Array>>(arr);
+	}
+}
\ No newline at end of file
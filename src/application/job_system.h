@@ -0,0 +1,208 @@
+#pragma once
+
+#include "../js/js_object.h"
+#include "../memory/shared_ptr.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <vector>
+
+namespace snuffbox
+{
+	/**
+	* @class snuffbox::JobSystem
+	* @brief A work-stealing job system, every worker owns a deque it pushes to and pops from while idle workers steal from the other end
+	* @remarks The main thread is worker 0 and only runs jobs while it waits for a counter, jobs must not touch JavaScript or the render device
+	* @author Danil Konings
+	*/
+	class JobSystem : public JSObject
+	{
+	public:
+		/**
+		* @brief The signature of a job, processes the range [start, end)
+		* @param[in] data (void*) The user data of the job
+		* @param[in] start (const int&) The first index to process
+		* @param[in] end (const int&) One past the last index to process
+		*/
+		typedef void(*JobFunction)(void* data, const int& start, const int& end);
+
+		/**
+		* @struct snuffbox::JobSystem::Counter
+		* @brief Counts the jobs that still have to finish, jobs can be waited on through their counter
+		* @author Danil Konings
+		*/
+		struct Counter
+		{
+			/// Default constructor
+			Counter() : value(0){}
+
+			std::atomic<int> value; //!< The number of jobs that haven't finished yet
+		};
+
+		/**
+		* @struct snuffbox::JobSystem::Job
+		* @brief A single job, small enough to be copied into a deque without allocating
+		* @author Danil Konings
+		*/
+		struct Job
+		{
+			JobFunction func; //!< The function to run
+			void* data; //!< The user data passed to the function
+			int start; //!< The first index of the range
+			int end; //!< One past the last index of the range
+			Counter* counter; //!< The counter to decrement once the job finishes, can be nullptr
+		};
+
+		/**
+		* @struct snuffbox::JobSystem::Worker
+		* @brief The deque of a single worker
+		* @author Danil Konings
+		*/
+		struct Worker
+		{
+			std::mutex mutex; //!< The mutex guarding the deque
+			std::deque<Job> jobs; //!< The jobs of this worker, the owner uses the back while thieves use the front
+		};
+
+	public:
+		/// Default constructor
+		JobSystem();
+
+		/**
+		* @brief Retrieves the singleton instance of this class
+		* @return snuffbox::JobSystem* The pointer to the singleton
+		*/
+		static JobSystem* Instance();
+
+		/**
+		* @brief Starts the worker threads, should be called from the main thread
+		* @param[in] workers (const int&) The number of workers including the main thread, 0 uses the 'job_workers' CVar or the hardware concurrency
+		* @param[in] profiled (const bool&) Should the worker threads show up in CPU captures? Default = true
+		*/
+		void Initialise(const int& workers = 0, const bool& profiled = true);
+
+		/// Stops and joins all worker threads, remaining jobs are run on the main thread
+		void Shutdown();
+
+		/**
+		* @brief Schedules a job
+		* @param[in] func (snuffbox::JobSystem::JobFunction) The function to run
+		* @param[in] data (void*) The user data passed to the function
+		* @param[in] start (const int&) The first index of the range
+		* @param[in] end (const int&) One past the last index of the range
+		* @param[in] counter (snuffbox::JobSystem::Counter*) The counter to increment now and decrement once the job finishes, can be nullptr
+		*/
+		void Run(JobFunction func, void* data, const int& start, const int& end, Counter* counter);
+
+		/**
+		* @brief Splits a range into jobs of at most 'grain' indices each and schedules them
+		* @param[in] func (snuffbox::JobSystem::JobFunction) The function to run for every chunk
+		* @param[in] data (void*) The user data passed to the function
+		* @param[in] count (const int&) The number of indices
+		* @param[in] grain (const int&) The maximum number of indices per job
+		* @param[in] counter (snuffbox::JobSystem::Counter*) The counter of the jobs
+		*/
+		void Dispatch(JobFunction func, void* data, const int& count, const int& grain, Counter* counter);
+
+		/**
+		* @brief Waits for a counter to reach zero, running jobs on the calling thread while it waits
+		* @param[in] counter (snuffbox::JobSystem::Counter*) The counter to wait for
+		*/
+		void Wait(Counter* counter);
+
+		/**
+		* @brief Runs a function over a range in parallel and waits for it to finish
+		* @param[in] count (const int&) The number of indices
+		* @param[in] grain (const int&) The maximum number of indices per job
+		* @param[in] func (const T&) The function to call with (start, end) for every chunk
+		*/
+		template<typename T>
+		void ParallelFor(const int& count, const int& grain, const T& func);
+
+		/**
+		* @brief Measures how a workload scales from 1 to the maximum number of workers, runs on a private job system per worker count so the global one keeps running
+		* @param[in] items (const int&) The number of items in the workload
+		* @param[in] iterations (const int&) The number of times the workload is run per worker count
+		* @return std::vector<double> The average time in milliseconds per worker count, index 0 is a single worker
+		*/
+		static std::vector<double> Benchmark(const int& items, const int& iterations);
+
+		/**
+		* @return const int& The number of workers, including the main thread
+		*/
+		const int& workers() const;
+
+		/// Default destructor
+		virtual ~JobSystem();
+
+	private:
+		/**
+		* @brief Invokes a callable stored in the user data of a job
+		* @param[in] data (void*) The callable
+		* @param[in] start (const int&) The first index to process
+		* @param[in] end (const int&) One past the last index to process
+		*/
+		template<typename T>
+		static void Invoke(void* data, const int& start, const int& end);
+
+		/**
+		* @brief The loop of a worker thread
+		* @param[in] index (const int&) The index of the worker
+		*/
+		void Loop(const int& index);
+
+		/**
+		* @brief Finds a job to run, from the worker's own deque first and otherwise by stealing from another worker
+		* @param[in] index (const int&) The index of the worker looking for a job
+		* @param[out] job (snuffbox::JobSystem::Job*) The found job
+		* @return bool Was a job found?
+		*/
+		bool Find(const int& index, Job* job);
+
+		/**
+		* @brief Runs a job and decrements its counter
+		* @param[in] job (const snuffbox::JobSystem::Job&) The job to run
+		*/
+		void Execute(const Job& job);
+
+		/**
+		* @return int The index of the worker on the calling thread, or -1 if the thread is not a worker
+		*/
+		static int WorkerIndex();
+
+	private:
+		int workers_; //!< The number of workers, including the main thread
+		std::vector<SharedPtr<Worker>> queues_; //!< The deques of every worker
+		std::vector<std::thread> threads_; //!< The worker threads, the main thread is not in here
+		std::mutex sleep_mutex_; //!< The mutex idle workers sleep on
+		std::condition_variable signal_; //!< Wakes idle workers when jobs are scheduled or the system shuts down
+		std::atomic<int> pending_; //!< The number of jobs that are scheduled but not yet picked up
+		std::atomic<bool> running_; //!< Are the worker threads running?
+		bool profiled_; //!< Do the worker threads show up in CPU captures?
+
+	public:
+		JS_NAME("Jobs");
+		static void RegisterJS(JS_SINGLETON obj);
+		static void JSWorkers(JS_ARGS args);
+		static void JSBenchmark(JS_ARGS args);
+	};
+
+	//-------------------------------------------------------------------------------------------
+	template<typename T>
+	inline void JobSystem::ParallelFor(const int& count, const int& grain, const T& func)
+	{
+		Counter counter;
+		Dispatch(&JobSystem::Invoke<T>, const_cast<T*>(&func), count, grain, &counter);
+		Wait(&counter);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	template<typename T>
+	inline void JobSystem::Invoke(void* data, const int& start, const int& end)
+	{
+		(*static_cast<const T*>(data))(start, end);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,361 @@
+#include "../application/log_writer.h"
+#include "../application/game.h"
+
+#include "../cvar/cvar.h"
+
+#ifdef SNUFF_WIN32
+#include <Windows.h>
+#endif
+
+#ifdef SNUFF_BUILD_CONSOLE
+#include "../console/console.h"
+#endif
+
+#include <chrono>
+#include <cstdio>
+
+namespace snuffbox
+{
+	//-------------------------------------------------------------------------------------------
+	LogWriter::LogWriter() :
+		mask_(0),
+		tail_(0),
+		head_(0),
+		written_(0),
+		dropped_(0),
+		overflow_(OverflowPolicy::kDrop),
+		running_(false)
+	{
+
+	}
+
+	//-------------------------------------------------------------------------------------------
+	LogWriter* LogWriter::Instance()
+	{
+		// Not allocated through AllocatedMemory, as the writer has to outlive the leak check, which logs
+		static LogWriter* writer = new LogWriter();
+		return writer;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void LogWriter::Initialise()
+	{
+		if (running_ == true)
+		{
+			return;
+		}
+
+		CVar* cvar = CVar::Instance();
+		bool found = false;
+
+		unsigned int capacity = 8192;
+		CVar::Value* size = cvar->Get("log_buffer", &found);
+
+		if (found == true && size->IsNumber() == true && size->As<CVar::Number>()->value() >= 2.0)
+		{
+			capacity = static_cast<unsigned int>(size->As<CVar::Number>()->value());
+		}
+
+		unsigned int rounded = 2;
+		while (rounded < capacity)
+		{
+			rounded <<= 1;
+		}
+
+		std::vector<Slot> slots(rounded);
+		slots_.swap(slots);
+
+		for (unsigned int i = 0; i < rounded; ++i)
+		{
+			slots_.at(i).sequence.store(i, std::memory_order_relaxed);
+		}
+
+		mask_ = rounded - 1;
+		tail_ = 0;
+		head_ = 0;
+		written_ = 0;
+		dropped_ = 0;
+
+		CVar::Value* overflow = cvar->Get("log_overflow", &found);
+		overflow_ = found == true && overflow->IsString() == true && overflow->As<CVar::String>()->value() == "block" ? OverflowPolicy::kBlock : OverflowPolicy::kDrop;
+
+		CVar::Value* file = cvar->Get("log_file", &found);
+		if (found == true && file->IsString() == true)
+		{
+			std::string path = file->As<CVar::String>()->value();
+			file_.open(Game::Instance()->path() + "/" + path, std::ios::out | std::ios::trunc);
+
+			if (!file_)
+			{
+				Write(DebugLogging::TypeToColour(DebugLogging::LogType::kWarning), DebugLogging::TypeToString(DebugLogging::LogType::kWarning) + " Could not open log file '" + path + "'\n");
+			}
+		}
+
+		main_thread_ = std::this_thread::get_id();
+		running_ = true;
+
+		thread_ = std::thread(&LogWriter::Loop, this);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void LogWriter::Shutdown()
+	{
+		if (running_ == false)
+		{
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(wake_mutex_);
+			running_ = false;
+		}
+
+		wake_.notify_one();
+		thread_.join();
+
+		Update();
+
+		if (file_.is_open() == true)
+		{
+			file_.close();
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool LogWriter::Push(const DebugLogging::LogColour& colour, std::string&& message)
+	{
+		if (running_ == false)
+		{
+			return false;
+		}
+
+		unsigned int pos = tail_.load(std::memory_order_relaxed);
+		Slot* slot = nullptr;
+		int diff;
+
+		while (true)
+		{
+			slot = &slots_[pos & mask_];
+			diff = static_cast<int>(slot->sequence.load(std::memory_order_acquire) - pos);
+
+			if (diff == 0)
+			{
+				if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed) == true)
+				{
+					break;
+				}
+
+				continue;
+			}
+
+			if (diff < 0)
+			{
+				if (overflow_ == OverflowPolicy::kDrop)
+				{
+					++dropped_;
+					return true;
+				}
+
+				if (running_ == false)
+				{
+					return false;
+				}
+
+				wake_.notify_one();
+				std::this_thread::yield();
+			}
+
+			pos = tail_.load(std::memory_order_relaxed);
+		}
+
+		slot->entry.colour = colour;
+		slot->entry.message = std::move(message);
+		slot->sequence.store(pos + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void LogWriter::Flush()
+	{
+		if (running_ == false || std::this_thread::get_id() == thread_.get_id())
+		{
+			return;
+		}
+
+		unsigned int target = tail_.load();
+		wake_.notify_one();
+
+		while (static_cast<int>(written_.load() - target) < 0)
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool LogWriter::IsMainThread() const
+	{
+		return std::this_thread::get_id() == main_thread_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void LogWriter::Update()
+	{
+#ifdef SNUFF_BUILD_CONSOLE
+		if (std::this_thread::get_id() != main_thread_)
+		{
+			return;
+		}
+
+		std::vector<Entry> entries;
+		{
+			std::lock_guard<std::mutex> lock(console_mutex_);
+			entries.swap(console_);
+		}
+
+		if (entries.empty() == true)
+		{
+			return;
+		}
+
+		Console* console = Console::Instance();
+		for (unsigned int i = 0; i < entries.size(); ++i)
+		{
+			console->Log(entries.at(i).colour, entries.at(i).message);
+		}
+
+		qApp->processEvents();
+#endif
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void LogWriter::Write(const DebugLogging::LogColour& colour, const std::string& message)
+	{
+		{
+			std::lock_guard<std::mutex> lock(output_mutex_);
+			WriteOutput(message);
+		}
+
+#ifdef SNUFF_BUILD_CONSOLE
+		if (running_ == true && std::this_thread::get_id() != main_thread_)
+		{
+			std::lock_guard<std::mutex> lock(console_mutex_);
+			console_.push_back({ colour, message });
+			return;
+		}
+
+		Console::Instance()->Log(colour, message);
+		qApp->processEvents();
+#endif
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void LogWriter::Loop()
+	{
+		std::string text;
+		Entry entry;
+		unsigned int count, dropped;
+
+#ifdef SNUFF_BUILD_CONSOLE
+		std::vector<Entry> batch;
+#endif
+
+		while (true)
+		{
+			text.clear();
+			count = 0;
+
+			dropped = dropped_.exchange(0);
+			if (dropped > 0)
+			{
+				entry.colour = DebugLogging::TypeToColour(DebugLogging::LogType::kWarning);
+				entry.message = DebugLogging::TypeToString(DebugLogging::LogType::kWarning) + " Dropped " + std::to_string(dropped) + " log message(s), the log buffer is full\n";
+
+				text += entry.message;
+#ifdef SNUFF_BUILD_CONSOLE
+				batch.push_back(entry);
+#endif
+			}
+
+			while (count <= mask_ && Pop(&entry) == true)
+			{
+				text += entry.message;
+				++count;
+
+#ifdef SNUFF_BUILD_CONSOLE
+				batch.push_back(std::move(entry));
+#endif
+			}
+
+			if (text.empty() == false)
+			{
+				std::lock_guard<std::mutex> lock(output_mutex_);
+				WriteOutput(text);
+			}
+
+#ifdef SNUFF_BUILD_CONSOLE
+			if (batch.empty() == false)
+			{
+				std::lock_guard<std::mutex> lock(console_mutex_);
+				console_.insert(console_.end(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+				batch.clear();
+			}
+#endif
+
+			written_ += count;
+
+			if (count > 0)
+			{
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(wake_mutex_);
+			if (running_ == false)
+			{
+				break;
+			}
+
+			wake_.wait_for(lock, std::chrono::milliseconds(10));
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool LogWriter::Pop(Entry* entry)
+	{
+		Slot& slot = slots_[head_ & mask_];
+
+		if (static_cast<int>(slot.sequence.load(std::memory_order_acquire) - (head_ + 1)) < 0)
+		{
+			return false;
+		}
+
+		*entry = std::move(slot.entry);
+		slot.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+		++head_;
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void LogWriter::WriteOutput(const std::string& text)
+	{
+		fputs(text.c_str(), stdout);
+		fflush(stdout);
+
+		if (file_.is_open() == true)
+		{
+			file_ << text;
+			file_.flush();
+		}
+
+#if defined SNUFF_WIN32 && _DEBUG
+		OutputDebugStringA(text.c_str());
+#endif
+	}
+
+	//-------------------------------------------------------------------------------------------
+	LogWriter::~LogWriter()
+	{
+		Shutdown();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "../application/logging.h"
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <fstream>
+#include <vector>
+
+namespace snuffbox
+{
+	/**
+	* @class snuffbox::LogWriter
+	* @brief Writes log messages on a background thread, messages are queued in a bounded lock-free ring buffer that any thread can push to
+	* @remarks The writer thread writes to stdout, the 'log_file' and the debugger output in batches. The Qt console is not thread safe,
+	* so console messages are handed back to the main thread and shown by Update
+	* @author Danil Konings
+	*/
+	class LogWriter
+	{
+	public:
+		/**
+		* @enum snuffbox::LogWriter::OverflowPolicy
+		* @brief What to do when a message is pushed while the ring buffer is full
+		* @author Danil Konings
+		*/
+		enum OverflowPolicy
+		{
+			kDrop, //!< Drops the message, the number of dropped messages is logged once there is room again
+			kBlock //!< Waits for the writer thread to make room
+		};
+
+		/**
+		* @struct snuffbox::LogWriter::Entry
+		* @brief A single queued message
+		* @author Danil Konings
+		*/
+		struct Entry
+		{
+			DebugLogging::LogColour colour; //!< The colour to show the message with in the console
+			std::string message; //!< The message, including the type prefix and the trailing newline
+		};
+
+		/**
+		* @struct snuffbox::LogWriter::Slot
+		* @brief A slot in the ring buffer, the sequence tells producers and the consumer whose turn it is
+		* @author Danil Konings
+		*/
+		struct Slot
+		{
+			std::atomic<unsigned int> sequence; //!< Equal to the position for a free slot and to the position + 1 for a filled slot
+			Entry entry; //!< The queued message
+		};
+
+	public:
+		/// Default constructor
+		LogWriter();
+
+		/**
+		* @brief Retrieves the singleton instance of this class
+		* @return snuffbox::LogWriter* The pointer to the singleton
+		*/
+		static LogWriter* Instance();
+
+		/**
+		* @brief Starts the writer thread, using the 'log_buffer', 'log_overflow' and 'log_file' CVars
+		* @remarks Should be called from the main thread, messages are written synchronously before this and after Shutdown
+		*/
+		void Initialise();
+
+		/// Writes every queued message and stops the writer thread
+		void Shutdown();
+
+		/**
+		* @brief Queues a message
+		* @param[in] colour (const snuffbox::DebugLogging::LogColour&) The colour to show the message with in the console
+		* @param[in] message (std::string&&) The message to queue
+		* @return bool Was the message taken? Returns false if the writer isn't running, the message should be written synchronously in that case
+		*/
+		bool Push(const DebugLogging::LogColour& colour, std::string&& message);
+
+		/// Blocks until every message pushed before this call has been written
+		void Flush();
+
+		/// Shows the messages the writer thread has written in the console, does nothing when not called from the main thread
+		void Update();
+
+		/**
+		* @brief Writes a message synchronously on the calling thread
+		* @param[in] colour (const snuffbox::DebugLogging::LogColour&) The colour to show the message with in the console
+		* @param[in] message (const std::string&) The message to write
+		*/
+		void Write(const DebugLogging::LogColour& colour, const std::string& message);
+
+		/**
+		* @return bool Is the calling thread the main thread, which owns the JavaScript isolate? Always false before snuffbox::LogWriter::Initialise
+		*/
+		bool IsMainThread() const;
+
+		/// Default destructor
+		~LogWriter();
+
+	private:
+		/// The loop of the writer thread
+		void Loop();
+
+		/**
+		* @brief Takes the oldest message out of the ring buffer, may only be called by the writer thread
+		* @param[out] entry (snuffbox::LogWriter::Entry*) The message
+		* @return bool Was there a message?
+		*/
+		bool Pop(Entry* entry);
+
+		/**
+		* @brief Writes a batch of messages to stdout, the log file and the debugger output
+		* @param[in] text (const std::string&) The concatenated messages
+		*/
+		void WriteOutput(const std::string& text);
+
+	private:
+		std::vector<Slot> slots_; //!< The ring buffer
+		unsigned int mask_; //!< The size of the ring buffer minus one, the size is always a power of two
+		std::atomic<unsigned int> tail_; //!< The position the next message is pushed to
+		unsigned int head_; //!< The position the next message is popped from, only touched by the writer thread
+		std::atomic<unsigned int> written_; //!< The number of messages written so far
+		std::atomic<unsigned int> dropped_; //!< The number of messages dropped since the last report
+		OverflowPolicy overflow_; //!< What to do when the ring buffer is full
+		std::atomic<bool> running_; //!< Is the writer thread running?
+		std::thread thread_; //!< The writer thread
+		std::thread::id main_thread_; //!< The ID of the main thread
+		std::mutex wake_mutex_; //!< The mutex the writer thread sleeps on
+		std::condition_variable wake_; //!< Wakes the writer thread early
+		std::mutex output_mutex_; //!< Keeps batches and synchronous messages from interleaving
+		std::ofstream file_; //!< The log file, not open if there is none
+		std::mutex console_mutex_; //!< Guards the messages waiting to be shown in the console
+		std::vector<Entry> console_; //!< The written messages waiting to be shown in the console
+	};
+}
\ No newline at end of file
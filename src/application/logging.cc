@@ -1,39 +1,51 @@
 #include "../application/logging.h"
+#include "../application/log_writer.h"
+#include "../application/binary_log.h"
 #include "../application/game.h"
 
-#ifdef SNUFF_WIN32
-#include <Windows.h>
-#endif
-
+#include "../cvar/cvar.h"
 
 #ifdef SNUFF_BUILD_CONSOLE
 #include "../console/console.h"
 #endif
 
+#include <map>
+#include <mutex>
+
 namespace snuffbox
 {
 	//---------------------------------------------------------------------------------------------------------
 	void DebugLogging::Log(const DebugLogging::LogType& type, const std::string& message, const bool& dump)
 	{
+    BinaryLog::Instance()->Text(type, message);
+
     std::string msg = TypeToString(type) + " " + message + "\n";
 
-		bool can_dump = JSStateWrapper::StackDumpAvailable();
+		LogWriter* writer = LogWriter::Instance();
+
+		// Messages are logged from any thread, but only the main thread may enter the isolate
+		bool can_dump = JSStateWrapper::StackDumpAvailable() == true && writer->IsMainThread() == true;
 		if (can_dump == true && (type == LogType::kError || type == LogType::kFatal) && dump == true)
 		{
 			msg += JSStateWrapper::Instance()->StackDump();
 		}
 
-#ifdef SNUFF_BUILD_CONSOLE
-    Console* console = Console::Instance();
-    console->Log(TypeToColour(type), msg);
-		qApp->processEvents();
-#endif
+		LogColour colour = TypeToColour(type);
 
-    printf(msg.c_str());
+		// Fatal messages are usually followed by a break, so everything before them has to be written first
+		if (type == LogType::kFatal)
+		{
+			writer->Flush();
+			writer->Update();
+			writer->Write(colour, msg);
+			BinaryLog::Instance()->Flush();
+			return;
+		}
 
-#if defined SNUFF_WIN32 && _DEBUG
-		OutputDebugStringA(std::string(msg).c_str());
-#endif
+		if (writer->Push(colour, std::move(msg)) == false)
+		{
+			writer->Write(colour, msg);
+		}
 	}
 
 	//---------------------------------------------------------------------------------------------------------
@@ -41,16 +53,13 @@ namespace snuffbox
 	{
     std::string msg = message + "\n";
 		
-#ifdef SNUFF_BUILD_CONSOLE
-    Console* console = Console::Instance();
-    console->Log(DebugLogging::LogColour{ rf, gf, bf, rb, gb, bb, a}, msg);
-#endif
-    
-    printf(msg.c_str());
+		LogWriter* writer = LogWriter::Instance();
+		LogColour colour = { rf, gf, bf, rb, gb, bb, a };
 
-#if defined SNUFF_WIN32 && _DEBUG
-    OutputDebugStringA(std::string(msg).c_str());
-#endif
+		if (writer->Push(colour, std::move(msg)) == false)
+		{
+			writer->Write(colour, msg);
+		}
 	}
 
 	//---------------------------------------------------------------------------------------------------------
@@ -62,6 +71,10 @@ namespace snuffbox
   //---------------------------------------------------------------------------------------------------------
   void DebugLogging::Break()
   {
+    LogWriter::Instance()->Flush();
+    LogWriter::Instance()->Update();
+    BinaryLog::Instance()->Flush();
+
 #ifdef SNUFF_BUILD_CONSOLE
     Console* console = Console::Instance(); 
     while (console->IsVisible() == true && console->enabled() == true){ 
@@ -75,6 +88,118 @@ namespace snuffbox
     }
   }
 
+	//---------------------------------------------------------------------------------------------------------
+	static std::mutex& category_mutex()
+	{
+		static std::mutex* mutex = new std::mutex();
+		return *mutex;
+	}
+
+	//---------------------------------------------------------------------------------------------------------
+	static std::map<std::string, DebugLogging::Category*>& categories()
+	{
+		// Allocated once and never freed, logging has to keep working during the leak check at shutdown
+		static std::map<std::string, DebugLogging::Category*>* map = new std::map<std::string, DebugLogging::Category*>();
+		return *map;
+	}
+
+	//---------------------------------------------------------------------------------------------------------
+	static int CategoryLevel(const std::string& name)
+	{
+		CVar* cvar = CVar::Instance();
+		bool found = false;
+
+		CVar::Value* value = cvar->Get("log_level_" + name, &found);
+		if (found == false || value->IsString() == false)
+		{
+			value = cvar->Get("log_level", &found);
+		}
+
+		int level = found == true && value->IsString() == true ? DebugLogging::LevelFromString(value->As<CVar::String>()->value()) : -1;
+		return level < 0 ? SNUFF_LOG_LEVEL_DEBUG : level;
+	}
+
+	//---------------------------------------------------------------------------------------------------------
+	DebugLogging::Category* DebugLogging::FindCategory(const std::string& name)
+	{
+		{
+			std::lock_guard<std::mutex> lock(category_mutex());
+			std::map<std::string, Category*>::iterator it = categories().find(name);
+
+			if (it != categories().end())
+			{
+				return it->second;
+			}
+		}
+
+		// The level is looked up outside of the lock, reading a CVar could log
+		int level = CategoryLevel(name);
+
+		std::lock_guard<std::mutex> lock(category_mutex());
+		std::map<std::string, Category*>::iterator it = categories().find(name);
+
+		if (it != categories().end())
+		{
+			return it->second;
+		}
+
+		Category* category = new Category();
+		category->name = name;
+		category->level = level;
+
+		categories().emplace(name, category);
+		return category;
+	}
+
+	//---------------------------------------------------------------------------------------------------------
+	void DebugLogging::SetLevel(const std::string& name, const int& level)
+	{
+		if (name.empty() == true)
+		{
+			std::lock_guard<std::mutex> lock(category_mutex());
+			for (std::map<std::string, Category*>::iterator it = categories().begin(); it != categories().end(); ++it)
+			{
+				it->second->level = level;
+			}
+
+			return;
+		}
+
+		FindCategory(name)->level = level;
+	}
+
+	//---------------------------------------------------------------------------------------------------------
+	void DebugLogging::ReloadLevels()
+	{
+		std::vector<Category*> list;
+		{
+			std::lock_guard<std::mutex> lock(category_mutex());
+			for (std::map<std::string, Category*>::iterator it = categories().begin(); it != categories().end(); ++it)
+			{
+				list.push_back(it->second);
+			}
+		}
+
+		for (unsigned int i = 0; i < list.size(); ++i)
+		{
+			list.at(i)->level = CategoryLevel(list.at(i)->name);
+		}
+	}
+
+	//---------------------------------------------------------------------------------------------------------
+	int DebugLogging::LevelFromString(const std::string& name)
+	{
+		if (name == "debug") return SNUFF_LOG_LEVEL_DEBUG;
+		if (name == "info") return SNUFF_LOG_LEVEL_INFO;
+		if (name == "success") return SNUFF_LOG_LEVEL_SUCCESS;
+		if (name == "warning") return SNUFF_LOG_LEVEL_WARNING;
+		if (name == "error") return SNUFF_LOG_LEVEL_ERROR;
+		if (name == "fatal") return SNUFF_LOG_LEVEL_FATAL;
+		if (name == "none") return SNUFF_LOG_LEVEL_NONE;
+
+		return -1;
+	}
+
 	//---------------------------------------------------------------------------------------------------------
 	std::string DebugLogging::TypeToString(const LogType& type)
 	{
@@ -115,7 +240,9 @@ namespace snuffbox
       { "success", JSLogSuccess },
       { "error", JSLogError },
       { "fatal", JSLogFatal },
-      { "rgb", JSLogRGB }
+      { "rgb", JSLogRGB },
+      { "setLevel", JSSetLevel },
+      { "level", JSLevel }
     };
 
 		JSFunctionRegister::Register(funcs, sizeof(funcs) / sizeof(JSFunctionRegister), obj);
@@ -125,35 +252,35 @@ namespace snuffbox
   void DebugLogging::JSLogDebug(JS_ARGS args)
   {
     JSWrapper wrapper(args);
-    Log(LogType::kDebug, wrapper.GetValue<std::string>(0, "undefined"));
+    SNUFF_CLOG_DEBUG("js", wrapper.GetValue<std::string>(0, "undefined"));
   }
 
   //---------------------------------------------------------------------------------------------------------
   void DebugLogging::JSLogInfo(JS_ARGS args)
   {
     JSWrapper wrapper(args);
-    Log(LogType::kInfo, wrapper.GetValue<std::string>(0, "undefined"));
+    SNUFF_CLOG_INFO("js", wrapper.GetValue<std::string>(0, "undefined"));
   }
 
   //---------------------------------------------------------------------------------------------------------
   void DebugLogging::JSLogWarning(JS_ARGS args)
   {
     JSWrapper wrapper(args);
-    Log(LogType::kWarning, wrapper.GetValue<std::string>(0, "undefined"));
+    SNUFF_CLOG_WARNING("js", wrapper.GetValue<std::string>(0, "undefined"));
   }
 
   //---------------------------------------------------------------------------------------------------------
   void DebugLogging::JSLogSuccess(JS_ARGS args)
   {
     JSWrapper wrapper(args);
-    Log(LogType::kSuccess, wrapper.GetValue<std::string>(0, "undefined"));
+    SNUFF_CLOG_SUCCESS("js", wrapper.GetValue<std::string>(0, "undefined"));
   }
 
   //---------------------------------------------------------------------------------------------------------
   void DebugLogging::JSLogError(JS_ARGS args)
   {
     JSWrapper wrapper(args);
-    Log(LogType::kError, wrapper.GetValue<std::string>(0, "undefined"));
+    SNUFF_CLOG_ERROR("js", wrapper.GetValue<std::string>(0, "undefined"));
   }
 
   //---------------------------------------------------------------------------------------------------------
@@ -176,4 +303,38 @@ namespace snuffbox
       wrapper.GetValue<int>(6, 128),
       wrapper.GetValue<int>(7, 255));
   }
+
+  //---------------------------------------------------------------------------------------------------------
+  void DebugLogging::JSSetLevel(JS_ARGS args)
+  {
+    JSWrapper wrapper(args);
+    if (wrapper.Check("SS") == false)
+    {
+      return;
+    }
+
+    std::string name = wrapper.GetValue<std::string>(1, "debug");
+    int level = LevelFromString(name);
+
+    if (level < 0)
+    {
+      SNUFF_LOG_WARNING("Unknown log level '" + name + "'");
+      return;
+    }
+
+    SetLevel(wrapper.GetValue<std::string>(0, ""), level);
+  }
+
+  //---------------------------------------------------------------------------------------------------------
+  void DebugLogging::JSLevel(JS_ARGS args)
+  {
+    JSWrapper wrapper(args);
+    if (wrapper.Check("S") == false)
+    {
+      return;
+    }
+
+    static const char* names[] = { "debug", "info", "success", "warning", "error", "fatal", "none" };
+    wrapper.ReturnValue<std::string>(names[FindCategory(wrapper.GetValue<std::string>(0, "general"))->level.load()]);
+  }
 }
\ No newline at end of file
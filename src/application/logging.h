@@ -2,16 +2,39 @@
 
 #include <assert.h>
 #include <string>
+#include <atomic>
 
 #include "../js/js_object.h"
 
-#define SNUFF_LOG_INFO(msg) snuffbox::DebugLogging::Log(snuffbox::DebugLogging::LogType::kInfo,##msg)
-#define SNUFF_LOG_DEBUG(msg) snuffbox::DebugLogging::Log(snuffbox::DebugLogging::LogType::kDebug,##msg)
-#define SNUFF_LOG_WARNING(msg) snuffbox::DebugLogging::Log(snuffbox::DebugLogging::LogType::kWarning,##msg)
-#define SNUFF_LOG_SUCCESS(msg) snuffbox::DebugLogging::Log(snuffbox::DebugLogging::LogType::kSuccess,##msg)
-#define SNUFF_LOG_ERROR(msg) snuffbox::DebugLogging::Log(snuffbox::DebugLogging::LogType::kError,##msg)
-#define SNUFF_LOG_FATAL(msg) snuffbox::DebugLogging::Log(snuffbox::DebugLogging::LogType::kFatal,##msg)
-#define SNUFF_LOG_RGB(msg, r1, g1, b1, r2, g2, b2, a) snuffbox::DebugLogging::Log(##msg,##r1,##g1,##b1,##r2,##g2,##b2,##a)
+#define SNUFF_LOG_LEVEL_DEBUG 0
+#define SNUFF_LOG_LEVEL_INFO 1
+#define SNUFF_LOG_LEVEL_SUCCESS 2
+#define SNUFF_LOG_LEVEL_WARNING 3
+#define SNUFF_LOG_LEVEL_ERROR 4
+#define SNUFF_LOG_LEVEL_FATAL 5
+#define SNUFF_LOG_LEVEL_NONE 6
+
+// Messages below this level are compiled out entirely
+#ifndef SNUFF_LOG_MIN_LEVEL
+#define SNUFF_LOG_MIN_LEVEL SNUFF_LOG_LEVEL_DEBUG
+#endif
+
+// The message is only constructed if it passes both the compile-time minimum and the runtime threshold of its category
+#define SNUFF_CLOG(severity, category, type, msg) do { if ((severity) >= SNUFF_LOG_MIN_LEVEL) { static snuffbox::DebugLogging::Category* snuff_log_category = snuffbox::DebugLogging::FindCategory(category); if ((severity) >= snuff_log_category->level.load(std::memory_order_relaxed)) { snuffbox::DebugLogging::Log(type, msg); } } } while (false)
+
+#define SNUFF_CLOG_DEBUG(category, msg) SNUFF_CLOG(SNUFF_LOG_LEVEL_DEBUG, category, snuffbox::DebugLogging::LogType::kDebug, msg)
+#define SNUFF_CLOG_INFO(category, msg) SNUFF_CLOG(SNUFF_LOG_LEVEL_INFO, category, snuffbox::DebugLogging::LogType::kInfo, msg)
+#define SNUFF_CLOG_SUCCESS(category, msg) SNUFF_CLOG(SNUFF_LOG_LEVEL_SUCCESS, category, snuffbox::DebugLogging::LogType::kSuccess, msg)
+#define SNUFF_CLOG_WARNING(category, msg) SNUFF_CLOG(SNUFF_LOG_LEVEL_WARNING, category, snuffbox::DebugLogging::LogType::kWarning, msg)
+#define SNUFF_CLOG_ERROR(category, msg) SNUFF_CLOG(SNUFF_LOG_LEVEL_ERROR, category, snuffbox::DebugLogging::LogType::kError, msg)
+
+#define SNUFF_LOG_INFO(msg) SNUFF_CLOG_INFO("general", msg)
+#define SNUFF_LOG_DEBUG(msg) SNUFF_CLOG_DEBUG("general", msg)
+#define SNUFF_LOG_WARNING(msg) SNUFF_CLOG_WARNING("general", msg)
+#define SNUFF_LOG_SUCCESS(msg) SNUFF_CLOG_SUCCESS("general", msg)
+#define SNUFF_LOG_ERROR(msg) SNUFF_CLOG_ERROR("general", msg)
+#define SNUFF_LOG_FATAL(msg) snuffbox::DebugLogging::Log(snuffbox::DebugLogging::LogType::kFatal, msg)
+#define SNUFF_LOG_RGB(msg, r1, g1, b1, r2, g2, b2, a) snuffbox::DebugLogging::Log(msg, r1, g1, b1, r2, g2, b2, a)
 
 #ifdef SNUFF_OSX
 #define SNUFF_BREAK
@@ -22,7 +45,7 @@
 #define SNUFF_BREAK
 #endif
 
-#define SNUFF_ASSERT(msg, ctx) {std::string message = ##msg; std::string result = "\n\nSnuffbox assertion!\n----------------------\n" + message + "\n\n" + ##ctx + ":" + std::to_string(__LINE__); SNUFF_LOG_FATAL(result); DebugLogging::Break();}
+#define SNUFF_ASSERT(msg, ctx) {std::string message = msg; std::string result = "\n\nSnuffbox assertion!\n----------------------\n" + message + "\n\n" + ctx + ":" + std::to_string(__LINE__); SNUFF_LOG_FATAL(result); DebugLogging::Break();}
 #define SNUFF_XASSERT(expr, msg, ctx) if (!(expr)){ SNUFF_ASSERT(msg, ctx) }
 #define SNUFF_ASSERT_NOTNULL(ptr, ctx) SNUFF_XASSERT(ptr != nullptr, "Attempt to get a null pointer!", ctx)
 
@@ -63,6 +86,18 @@ namespace snuffbox
 			kFatal,
 			kRGB
 		};
+
+		/**
+		* @struct snuffbox::DebugLogging::Category
+		* @brief A log category with its own runtime threshold, categories are never destroyed so call sites can cache them
+		* @author Danil Konings
+		*/
+		struct Category
+		{
+			std::string name; //!< The name of the category
+			std::atomic<int> level; //!< The minimum level a message needs to be logged, one of the SNUFF_LOG_LEVEL_* values
+		};
+
 	public:
 		/**
 		* @brief Logs with a given logging type and a message
@@ -94,6 +129,31 @@ namespace snuffbox
     /// Halts the runtime
     static void Break();
 
+		/**
+		* @brief Finds a category, creating it if it doesn't exist yet
+		* @remarks A new category takes its level from the 'log_level_<name>' CVar, or from the 'log_level' CVar if that isn't set
+		* @param[in] name (const std::string&) The name of the category
+		* @return snuffbox::DebugLogging::Category* The category
+		*/
+		static Category* FindCategory(const std::string& name);
+
+		/**
+		* @brief Sets the level of a category
+		* @param[in] name (const std::string&) The name of the category, an empty name sets the level of every category
+		* @param[in] level (const int&) The minimum level a message needs to be logged
+		*/
+		static void SetLevel(const std::string& name, const int& level);
+
+		/// Reads the levels of every existing category from the CVars again, should be called once the command line has been parsed
+		static void ReloadLevels();
+
+		/**
+		* @brief Converts a level name to a level
+		* @param[in] name (const std::string&) The name, 'debug', 'info', 'success', 'warning', 'error', 'fatal' or 'none'
+		* @return int The level, or -1 if the name is unknown
+		*/
+		static int LevelFromString(const std::string& name);
+
 		/**
 		* @brief Converts a logging type to a string
 		* @param[in] type (const snuffbox::DebugLogging::LogType&) The type to convert
@@ -119,5 +179,7 @@ namespace snuffbox
     static void JSLogError(JS_ARGS args);
     static void JSLogFatal(JS_ARGS args);
     static void JSLogRGB(JS_ARGS args);
+    static void JSSetLevel(JS_ARGS args);
+    static void JSLevel(JS_ARGS args);
 	};
 }
\ No newline at end of file
@@ -2,9 +2,21 @@
 #include "../memory/shared_ptr.h"
 
 #include "../application/game.h"
+#include "../application/scheduler.h"
+#include "../application/job_system.h"
+#include "../application/cpu_profiler.h"
+#include "../application/replay.h"
+#include "../application/log_writer.h"
+#include "../application/binary_log.h"
+#include "../application/startup.h"
+#include "../application/perf_harness.h"
 #include "../js/js_state_wrapper.h"
+#include "../js/js_profiler.h"
+#include "../js/js_worker.h"
 
+#ifndef SNUFF_BUILD_NULL
 #include "../platform/platform_window.h"
+#endif
 
 #include "../input/keyboard.h"
 #include "../input/mouse.h"
@@ -17,9 +29,11 @@
 
 #include "../platform/platform_file_watch.h"
 
+#ifndef SNUFF_BUILD_NULL
 #include "../fbx/fbx_loader.h"
 
 #include "../freetype/freetype_font_manager.h"
+#endif
 #include "../fmod/fmod_sound_system.h"
 
 #ifdef SNUFF_BUILD_CONSOLE
@@ -44,7 +58,9 @@ int main(int argc, char** argv)
 
 	std::string name = "Snuffbox_";
 
-#ifdef SNUFF_BUILD_OPENGL
+#ifdef SNUFF_BUILD_NULL
+	name += "Null_";
+#elif defined SNUFF_BUILD_OPENGL
 	name += "OGL_";
 #else
 	name += "D3D11_";
@@ -60,6 +76,8 @@ int main(int argc, char** argv)
 	
 	CVar* cvar = CVar::Instance();
 	cvar->RegisterCommandLine(argc, argv);
+	cvar->LoadConfig();
+	DebugLogging::ReloadLevels();
 
 	JSStateWrapper* js_state_wrapper = JSStateWrapper::Instance();
 	Game* game = Game::Instance();
@@ -77,63 +95,137 @@ int main(int argc, char** argv)
   }
 #endif
 
+  LogWriter* log_writer = LogWriter::Instance();
+  log_writer->Initialise();
+
+  BinaryLog* binary_log = BinaryLog::Instance();
+  binary_log->Initialise();
+
   SNUFF_LOG_INFO(name);
   cvar->LogCVars();
 	
-	SharedPtr<Window> window = memory.Construct<Window>(SNUFF_WINDOW_CENTERED, SNUFF_WINDOW_CENTERED, 640, 480, name);
+	// Headless runs never create a window, so they can run on hosts without a window system
+#ifdef SNUFF_BUILD_NULL
+	bool headless = true;
+#else
+	bool headless = CVarRef<bool>("headless", false).get();
+
+	SharedPtr<Window> window;
+	if (headless == false)
+	{
+		window = memory.Construct<Window>(SNUFF_WINDOW_CENTERED, SNUFF_WINDOW_CENTERED, 640, 480, name);
+		game->set_window(window.get());
+	}
+#endif
   
 	Keyboard* keyboard = Keyboard::Instance();
   Mouse* mouse = Mouse::Instance();
 	PlatformRenderDevice* render_device = PlatformRenderDevice::Instance();
 
-	game->set_window(window.get());
 	game->set_keyboard(keyboard);
 	game->set_mouse(mouse);
 	game->set_render_device(render_device);
 
 	IOManager* io_manager = IOManager::Instance();
-	FBXLoader* fbx_loader = FBXLoader::Instance();
+	Replay* replay = Replay::Instance();
+	JobSystem* job_system = JobSystem::Instance();
+	JSProfiler* profiler = JSProfiler::Instance();
 
-	fbx_loader->Initialise();
+	SNUFF_PROFILE_THREAD("Main");
 
-	js_state_wrapper->Initialise();
-	js_state_wrapper->OpenStack();
-  render_device->Initialise();
+	// V8, the render device and the job system are bound to the thread that creates them, the other subsystems only need their dependencies
+	Startup* startup = Startup::Instance();
 
+#ifndef SNUFF_BUILD_NULL
+	FBXLoader* fbx_loader = FBXLoader::Instance();
 	FontManager* font_manager = FontManager::Instance();
-	font_manager->Initialise();
 
+	startup->Add("fbx", Startup::Threads::kAny, {}, [fbx_loader]() { fbx_loader->Initialise(); });
+	startup->Add("fonts", Startup::Threads::kMain, { "render_device" }, [font_manager]() { font_manager->Initialise(); });
+#endif
+	startup->Add("fmod", Startup::Threads::kAny, {}, []() { SoundSystem::Instance(); });
+	startup->Add("replay", Startup::Threads::kMain, {}, [replay]() { replay->Initialise(); });
+	startup->Add("v8", Startup::Threads::kMain, { "replay" }, [js_state_wrapper]() { js_state_wrapper->Initialise(); js_state_wrapper->OpenStack(); });
+	startup->Add("render_device", Startup::Threads::kMain, {}, [render_device]() { render_device->Initialise(); });
+	startup->Add("jobs", Startup::Threads::kMain, {}, [job_system]() { job_system->Initialise(); });
+	startup->Add("profiler", Startup::Threads::kMain, { "v8" }, [profiler]() { profiler->Initialise(); });
+
+	startup->Run();
+
+	PerfHarness* perf_harness = PerfHarness::Instance();
+	perf_harness->Initialise();
+
+#ifdef SNUFF_BUILD_NULL
+	// main.js sets up a scene to draw, which the null render device can't do, so a performance scene replaces it
+	if (perf_harness->scene().empty() == true)
+	{
+		js_state_wrapper->CompileAndRun("main.js");
+	}
+#else
 	js_state_wrapper->CompileAndRun("main.js");
+#endif
 
-	game->Verify();
+	if (perf_harness->scene().empty() == false)
+	{
+		js_state_wrapper->CompileAndRun(perf_harness->scene());
+	}
 
-	window->Show();
+	startup->Mark("main.js");
+
+	game->Verify();
 
-  SoundSystem* sound_system = SoundSystem::Instance();
+#ifndef SNUFF_BUILD_NULL
+	if (headless == false)
+	{
+		window->Show();
+	}
+#endif
 
 	game->Initialise();
 
-	bool found;
-	CVar::Value* reload = cvar->Get("reload", &found);
-	bool should_reload = found != false && reload->IsBool() && reload->As<CVar::Boolean>()->value() == true;
+	cvar->WatchConfig();
+
+	// Read every frame, so it can be changed while running
+	CVarRef<bool> should_reload("reload", false);
 
 	game->SetTimePoint();
 	while (game->started())
 	{
-		game->Run();
-    js_state_wrapper->isolate()->IdleNotification(16);
+		{
+			JSFrameScope frame_scope(js_state_wrapper->isolate());
+			game->Run();
+		}
+		profiler->Update();
+		CPUProfiler::Instance()->EndFrame();
+		perf_harness->EndFrame();
+		JSWorker::Update();
+		log_writer->Update();
+		cvar->Update();
 
 		ContentManager::Instance()->UnloadAll();
 
-		if (should_reload)
+		if (should_reload.get() == true)
 		{
 			file_watch->Update();
 			file_watch->Process();
 		}
+
+		startup->FirstFrame();
+
+		// The garbage collector gets the time the pacer would otherwise sleep, the wait then only sleeps off what it left
+		js_state_wrapper->IdleNotification(game->pacer()->remaining());
+		game->WaitForFrame();
 	}
 
 	SNUFF_LOG_INFO("Shutting down");
+	cvar->Update();
+	replay->Dispose();
   render_device->Dispose();
+	JSWorker::TerminateAll();
+	Scheduler::Instance()->Clear();
+	job_system->Shutdown();
 	js_state_wrapper->Dispose();
+	binary_log->Shutdown();
+	log_writer->Shutdown();
 	return 0;
 }
\ No newline at end of file
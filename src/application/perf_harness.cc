@@ -0,0 +1,246 @@
+#include "../application/perf_harness.h"
+#include "../application/logging.h"
+#include "../application/cpu_profiler.h"
+#include "../application/job_system.h"
+#include "../application/game.h"
+
+#include "../platform/platform_render_device.h"
+
+#include "../cvar/cvar.h"
+#include "../io/io_manager.h"
+
+#include "../memory/allocated_memory.h"
+#include "../memory/shared_ptr.h"
+
+#include <algorithm>
+
+namespace snuffbox
+{
+	//-------------------------------------------------------------------------------------------
+	PerfHarness::PerfHarness() :
+		active_(false),
+		frames_(0),
+		warmup_(30),
+		step_(1.0 / 60.0),
+		report_("perf_report.json"),
+		frame_(0),
+		measured_(0),
+		allocations_(0),
+		draw_calls_(0),
+		indices_(0),
+		state_changes_(0)
+	{
+
+	}
+
+	//-------------------------------------------------------------------------------------------
+	PerfHarness* PerfHarness::Instance()
+	{
+		static SharedPtr<PerfHarness> perf_harness = AllocatedMemory::Instance().Construct<PerfHarness>();
+		return perf_harness.get();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void PerfHarness::Initialise()
+	{
+		CVar* cvar = CVar::Instance();
+		bool found = false;
+
+		CVar::Value* frames = cvar->Get("perf_frames", &found);
+		if (found == false || frames->IsNumber() == false || frames->As<CVar::Number>()->value() < 1.0)
+		{
+			return;
+		}
+
+		frames_ = static_cast<int>(frames->As<CVar::Number>()->value());
+
+		CVar::Value* warmup = cvar->Get("perf_warmup", &found);
+		if (found == true && warmup->IsNumber() == true)
+		{
+			warmup_ = std::max(static_cast<int>(warmup->As<CVar::Number>()->value()), 0);
+		}
+
+		CVar::Value* step = cvar->Get("perf_step", &found);
+		if (found == true && step->IsNumber() == true && step->As<CVar::Number>()->value() > 0.0)
+		{
+			step_ = step->As<CVar::Number>()->value() / 1000.0;
+		}
+
+		CVar::Value* scene = cvar->Get("perf_scene", &found);
+		if (found == true && scene->IsString() == true)
+		{
+			scene_ = scene->As<CVar::String>()->value();
+		}
+
+		CVar::Value* report = cvar->Get("perf_report", &found);
+		if (found == true && report->IsString() == true)
+		{
+			report_ = report->As<CVar::String>()->value();
+		}
+
+		CVar::Value* trace = cvar->Get("perf_trace", &found);
+		if (found == true && trace->IsString() == true)
+		{
+			trace_ = trace->As<CVar::String>()->value();
+		}
+
+		active_ = true;
+
+		SNUFF_LOG_INFO("Measuring " + std::to_string(frames_) + " frames of '" + (scene_.empty() == true ? "main.js" : scene_) + "' after " + std::to_string(warmup_) + " warm-up frames");
+
+		if (PlatformRenderDevice::Instance()->headless() == false)
+		{
+			SNUFF_LOG_WARNING("The performance harness is not running headless, the timings include presenting to the window");
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	double PerfHarness::DeltaTime(const double& measured) const
+	{
+		return active_ == true ? step_ : measured;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void PerfHarness::EndFrame()
+	{
+		if (active_ == false)
+		{
+			return;
+		}
+
+		++frame_;
+
+		const PlatformRenderDevice::DrawStats& stats = PlatformRenderDevice::Instance()->draw_stats();
+		size_t allocations = AllocatedMemory::Instance().total_allocations();
+
+		if (frame_ > warmup_ + 1)
+		{
+			for (std::map<std::string, CPUProfiler::Stat>::const_iterator it = CPUProfiler::Instance()->last_frame().begin(); it != CPUProfiler::Instance()->last_frame().end(); ++it)
+			{
+				Sample("cpu/" + it->first, it->second.time);
+			}
+
+			Sample("allocations", static_cast<double>(allocations - allocations_));
+			Sample("draw_calls", stats.draw_calls - draw_calls_);
+			Sample("indices", stats.indices - indices_);
+			Sample("state_changes", stats.state_changes - state_changes_);
+
+			++measured_;
+		}
+		else if (frame_ == warmup_ + 1)
+		{
+			// The capture aggregates the scopes of every frame that ends after it was started
+			if (CPUProfiler::Instance()->Capture(frames_, trace_) == false)
+			{
+				SNUFF_LOG_ERROR("Could not start measuring, stop the running CPU capture first");
+				active_ = false;
+				return;
+			}
+		}
+
+		allocations_ = allocations;
+		draw_calls_ = stats.draw_calls;
+		indices_ = stats.indices;
+		state_changes_ = stats.state_changes;
+
+		if (measured_ < frames_)
+		{
+			return;
+		}
+
+		WriteReport();
+		active_ = false;
+
+		Game::Instance()->Notify(Game::GameNotifications::kQuit);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	const bool& PerfHarness::active() const
+	{
+		return active_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	const std::string& PerfHarness::scene() const
+	{
+		return scene_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void PerfHarness::Sample(const std::string& metric, const double& value)
+	{
+		std::vector<double>& samples = samples_[metric];
+		samples.resize(measured_, 0.0);
+		samples.push_back(value);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	PerfHarness::Summary PerfHarness::Summarise(std::vector<double> samples)
+	{
+		Summary summary = { 0.0, 0.0, 0.0 };
+
+		if (samples.empty() == true)
+		{
+			return summary;
+		}
+
+		std::sort(samples.begin(), samples.end());
+
+		size_t count = samples.size();
+		summary.median = count % 2 == 1 ? samples.at(count / 2) : (samples.at(count / 2 - 1) + samples.at(count / 2)) * 0.5;
+		summary.max = samples.back();
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			summary.mean += samples.at(i);
+		}
+
+		summary.mean /= count;
+
+		return summary;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void PerfHarness::WriteReport()
+	{
+		std::string result = "{\"version\":1";
+		result += ",\"scene\":\"" + (scene_.empty() == true ? std::string("main.js") : scene_) + "\"";
+		result += ",\"frames\":" + std::to_string(measured_);
+		result += ",\"warmup\":" + std::to_string(warmup_);
+		result += ",\"step\":" + std::to_string(step_ * 1000.0);
+		result += ",\"workers\":" + std::to_string(JobSystem::Instance()->workers());
+		result += std::string(",\"headless\":") + (PlatformRenderDevice::Instance()->headless() == true ? "true" : "false");
+		result += ",\"metrics\":{";
+
+		bool first = true;
+		for (std::map<std::string, std::vector<double>>::iterator it = samples_.begin(); it != samples_.end(); ++it)
+		{
+			it->second.resize(measured_, 0.0);
+			Summary summary = Summarise(it->second);
+
+			result += first == true ? "" : ",";
+			result += "\"" + it->first + "\":{\"unit\":\"" + (it->first.compare(0, 4, "cpu/") == 0 ? "ms" : "count") + "\"";
+			result += ",\"median\":" + std::to_string(summary.median);
+			result += ",\"mean\":" + std::to_string(summary.mean);
+			result += ",\"max\":" + std::to_string(summary.max) + "}";
+
+			first = false;
+		}
+
+		result += "}}";
+
+		if (IOManager::Instance()->Write(report_, result) == false)
+		{
+			SNUFF_LOG_ERROR("Could not write the performance report to '" + report_ + "'");
+			return;
+		}
+
+		SNUFF_LOG_SUCCESS("Wrote the performance report of " + std::to_string(measured_) + " frames to '" + report_ + "'");
+	}
+
+	//-------------------------------------------------------------------------------------------
+	PerfHarness::~PerfHarness()
+	{
+
+	}
+}
\ No newline at end of file
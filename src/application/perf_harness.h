@@ -0,0 +1,104 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+
+namespace snuffbox
+{
+	/**
+	* @class snuffbox::PerfHarness
+	* @brief Runs a scene for a fixed number of frames and writes the per-frame CPU timings, allocations and draw submissions to a report
+	* @remarks Enabled by setting 'perf_frames' to the number of frames to measure. The script in 'perf_scene' is run after main.js, so it can
+	* set up or replace the scene. The first 'perf_warmup' frames are skipped, every frame advances the game by 'perf_step' milliseconds so
+	* the amount of work per frame doesn't depend on the speed of the machine. Once every frame has been measured the report is written to
+	* 'perf_report' and the game quits. Combine with 'headless' to run without a GPU, and compare reports with the snuffbox-perf-compare tool.
+	* Builds with SNUFF_BUILD_NULL run the scene instead of main.js, as they can't draw it
+	* @author Danil Konings
+	*/
+	class PerfHarness
+	{
+	public:
+		/**
+		* @struct snuffbox::PerfHarness::Summary
+		* @brief The summary of a metric over every measured frame
+		* @author Danil Konings
+		*/
+		struct Summary
+		{
+			double median; //!< The median value
+			double mean; //!< The mean value
+			double max; //!< The maximum value
+		};
+
+	public:
+		/// Default constructor
+		PerfHarness();
+
+		/**
+		* @brief Retrieves the singleton instance of this class
+		* @return snuffbox::PerfHarness* The pointer to the singleton
+		*/
+		static PerfHarness* Instance();
+
+		/// Reads the 'perf_*' CVars, the harness stays inactive if 'perf_frames' isn't set
+		void Initialise();
+
+		/**
+		* @brief Overrides the delta time of a frame while the harness is active
+		* @param[in] measured (const double&) The delta time in seconds
+		* @return double The fixed step in seconds if the harness is active, the measured delta time otherwise
+		*/
+		double DeltaTime(const double& measured) const;
+
+		/// Marks the end of a frame, should be called after snuffbox::CPUProfiler::EndFrame
+		void EndFrame();
+
+		/**
+		* @return const bool& Is the harness active?
+		*/
+		const bool& active() const;
+
+		/**
+		* @return const std::string& The path of the scene script, relative to the game path
+		*/
+		const std::string& scene() const;
+
+		/// Default destructor
+		~PerfHarness();
+
+	private:
+		/**
+		* @brief Adds a sample of a metric for the current frame, frames in which the metric wasn't sampled count as 0
+		* @param[in] metric (const std::string&) The name of the metric
+		* @param[in] value (const double&) The value
+		*/
+		void Sample(const std::string& metric, const double& value);
+
+		/**
+		* @brief Summarises the samples of a metric
+		* @param[in] samples (std::vector<double>) The samples
+		* @return snuffbox::PerfHarness::Summary The summary
+		*/
+		static Summary Summarise(std::vector<double> samples);
+
+		/// Writes the report to the path in 'perf_report'
+		void WriteReport();
+
+	private:
+		bool active_; //!< Is the harness active?
+		int frames_; //!< The number of frames to measure
+		int warmup_; //!< The number of frames to skip before measuring
+		double step_; //!< The fixed delta time in seconds
+		std::string scene_; //!< The path of the scene script
+		std::string report_; //!< The path to write the report to
+		std::string trace_; //!< The path to write a Chrome trace of the measured frames to, empty to skip
+		int frame_; //!< The number of frames that have ended
+		int measured_; //!< The number of frames that have been measured
+		size_t allocations_; //!< The total number of allocations at the end of the previous frame
+		int draw_calls_; //!< The total number of draw calls at the end of the previous frame
+		int indices_; //!< The total number of drawn indices at the end of the previous frame
+		int state_changes_; //!< The total number of state changes at the end of the previous frame
+		std::map<std::string, std::vector<double>> samples_; //!< The samples of every metric, one per measured frame
+	};
+}
\ No newline at end of file
@@ -0,0 +1,362 @@
+#include "../application/replay.h"
+#include "../application/game.h"
+#include "../application/logging.h"
+
+#include "../cvar/cvar.h"
+#include "../io/io_manager.h"
+
+#include "../memory/allocated_memory.h"
+
+#include <chrono>
+#include <cstdlib>
+
+namespace snuffbox
+{
+	//-------------------------------------------------------------------------------------------
+	Replay::Replay() :
+		mode_(Modes::kNone),
+		frame_(0),
+		injecting_(false),
+		fixed_step_(0.0)
+	{
+
+	}
+
+	//-------------------------------------------------------------------------------------------
+	Replay* Replay::Instance()
+	{
+		static SharedPtr<Replay> replay = AllocatedMemory::Instance().Construct<Replay>();
+		return replay.get();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Replay::Initialise()
+	{
+		CVar* cvar = CVar::Instance();
+		bool found = false;
+
+		std::string root = Game::Instance()->path() + "/";
+		uint32_t seed = 0;
+
+		CVar::Value* replay = cvar->Get("replay", &found);
+		if (found == true && replay->IsString() == true)
+		{
+			std::string path = replay->As<CVar::String>()->value();
+
+			std::ifstream in(root + path, std::ios::binary);
+			uint32_t magic = 0, version = 0;
+
+			if (!in || Read(in, &magic) == false || magic != kMagic || Read(in, &version) == false || version != kVersion || Read(in, &seed) == false)
+			{
+				SNUFF_LOG_ERROR("Could not load replay '" + path + "', it does not exist or is not a version " + std::to_string(kVersion) + " replay");
+				return;
+			}
+
+			if (Load(in) == false)
+			{
+				SNUFF_LOG_WARNING("Replay '" + path + "' is truncated, replaying the " + std::to_string(frames_.size()) + " complete frame(s)");
+			}
+
+			CVar::Value* step = cvar->Get("replay_fixed_step", &found);
+			fixed_step_ = found == true && step->IsNumber() == true ? step->As<CVar::Number>()->value() * 1e-3 : 0.0;
+
+			CVar::Value* timings = cvar->Get("replay_timings", &found);
+			timings_path_ = found == true && timings->IsString() == true ? timings->As<CVar::String>()->value() : "";
+
+			mode_ = Modes::kReplaying;
+			SNUFF_LOG_INFO("Replaying " + std::to_string(frames_.size()) + " frame(s) from '" + path + "'");
+		}
+		else
+		{
+			CVar::Value* record = cvar->Get("record", &found);
+			if (found == false || record->IsString() == false)
+			{
+				return;
+			}
+
+			std::string path = record->As<CVar::String>()->value();
+			out_.open(root + path, std::ios::binary | std::ios::trunc);
+
+			if (!out_)
+			{
+				SNUFF_LOG_ERROR("Could not open '" + path + "' to record to");
+				return;
+			}
+
+			seed = static_cast<uint32_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+			seed = (seed & 0x7FFFFFFF) == 0 ? 1 : seed & 0x7FFFFFFF;
+
+			Write(kMagic);
+			Write(kVersion);
+			Write(seed);
+
+			frames_.resize(1);
+			mode_ = Modes::kRecording;
+			SNUFF_LOG_INFO("Recording to '" + path + "'");
+		}
+
+		srand(seed);
+
+		// V8 only reads this flag when an isolate is created, seeding Math.random
+		std::string flag = "--random_seed=" + std::to_string(seed);
+		v8::V8::SetFlagsFromString(flag.c_str(), static_cast<int>(flag.size()));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool Replay::Filter(const Keyboard::KeyData& data)
+	{
+		switch (mode_)
+		{
+		case Modes::kRecording:
+			frames_.back().keys.push_back(data);
+			return true;
+
+		case Modes::kReplaying:
+			return injecting_;
+
+		default:
+			return true;
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool Replay::Filter(const Mouse::MouseData& data)
+	{
+		switch (mode_)
+		{
+		case Modes::kRecording:
+			frames_.back().mouse.push_back(data);
+			return true;
+
+		case Modes::kReplaying:
+			return injecting_;
+
+		default:
+			return true;
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	double Replay::DeltaTime(const double& measured)
+	{
+		switch (mode_)
+		{
+		case Modes::kRecording:
+			frames_.back().delta_time = measured;
+			return measured;
+
+		case Modes::kReplaying:
+			// The delta time of a frame is the duration of the frame before it
+			if (frame_ > 0)
+			{
+				timings_.push_back(measured * 1e3);
+			}
+
+			if (frame_ >= frames_.size())
+			{
+				Dispose();
+				Game::Instance()->Notify(Game::GameNotifications::kQuit);
+				return measured;
+			}
+
+			return fixed_step_ > 0.0 ? fixed_step_ : frames_.at(frame_).delta_time;
+
+		default:
+			return measured;
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Replay::EndInput()
+	{
+		if (mode_ == Modes::kRecording)
+		{
+			Frame& frame = frames_.back();
+
+			Write(frame.delta_time);
+			Write(static_cast<uint16_t>(frame.keys.size()));
+			Write(static_cast<uint16_t>(frame.mouse.size()));
+
+			for (unsigned int i = 0; i < frame.keys.size(); ++i)
+			{
+				const Keyboard::KeyData& key = frame.keys.at(i);
+				Write(static_cast<uint8_t>(key.evt));
+				Write(static_cast<uint8_t>(key.keycode));
+			}
+
+			for (unsigned int i = 0; i < frame.mouse.size(); ++i)
+			{
+				const Mouse::MouseData& mouse = frame.mouse.at(i);
+				Write(static_cast<uint8_t>(mouse.evt));
+				Write(static_cast<uint8_t>(mouse.button));
+				Write(static_cast<int16_t>(mouse.x));
+				Write(static_cast<int16_t>(mouse.y));
+			}
+
+			frame.keys.clear();
+			frame.mouse.clear();
+			++frame_;
+		}
+		else if (mode_ == Modes::kReplaying && frame_ < frames_.size())
+		{
+			const Frame& frame = frames_.at(frame_);
+			Game* game = Game::Instance();
+
+			injecting_ = true;
+
+			for (unsigned int i = 0; i < frame.keys.size(); ++i)
+			{
+				game->keyboard()->Notify(frame.keys.at(i));
+			}
+
+			for (unsigned int i = 0; i < frame.mouse.size(); ++i)
+			{
+				game->mouse()->Notify(frame.mouse.at(i));
+			}
+
+			injecting_ = false;
+			++frame_;
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Replay::Dispose()
+	{
+		if (mode_ == Modes::kRecording)
+		{
+			out_.close();
+			SNUFF_LOG_SUCCESS("Recorded " + std::to_string(frame_) + " frame(s)");
+		}
+		else if (mode_ == Modes::kReplaying && timings_.empty() == false)
+		{
+			double total = 0.0;
+			double max = 0.0;
+
+			std::string csv = "frame,delta_time,frame_time\n";
+			for (unsigned int i = 0; i < timings_.size(); ++i)
+			{
+				total += timings_.at(i);
+				max = timings_.at(i) > max ? timings_.at(i) : max;
+
+				csv += std::to_string(i) + "," + std::to_string((fixed_step_ > 0.0 ? fixed_step_ : frames_.at(i).delta_time) * 1e3) + "," + std::to_string(timings_.at(i)) + "\n";
+			}
+
+			SNUFF_LOG_SUCCESS("Replayed " + std::to_string(timings_.size()) + " frame(s), average " + std::to_string(total / timings_.size()) + " ms, max " + std::to_string(max) + " ms");
+
+			if (timings_path_.empty() == false)
+			{
+				if (IOManager::Instance()->Write(timings_path_, csv) == false)
+				{
+					SNUFF_LOG_ERROR("Could not write the replay timings to '" + timings_path_ + "'");
+				}
+			}
+		}
+
+		mode_ = Modes::kNone;
+		frames_.clear();
+		timings_.clear();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	const Replay::Modes& Replay::mode() const
+	{
+		return mode_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	const unsigned int& Replay::frame() const
+	{
+		return frame_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool Replay::Load(std::ifstream& in)
+	{
+		Frame frame;
+		uint16_t keys, mouse;
+		uint8_t evt, code;
+		int16_t x, y;
+
+		while (Read(in, &frame.delta_time) == true)
+		{
+			if (Read(in, &keys) == false || Read(in, &mouse) == false)
+			{
+				return false;
+			}
+
+			frame.keys.resize(keys);
+			frame.mouse.resize(mouse);
+
+			for (unsigned int i = 0; i < keys; ++i)
+			{
+				if (Read(in, &evt) == false || Read(in, &code) == false)
+				{
+					return false;
+				}
+
+				frame.keys.at(i).evt = static_cast<Keyboard::KeyEvent>(evt);
+				frame.keys.at(i).keycode = static_cast<Key::Keys>(code);
+			}
+
+			for (unsigned int i = 0; i < mouse; ++i)
+			{
+				if (Read(in, &evt) == false || Read(in, &code) == false || Read(in, &x) == false || Read(in, &y) == false)
+				{
+					return false;
+				}
+
+				Mouse::MouseData& data = frame.mouse.at(i);
+				data.evt = static_cast<Mouse::MouseEvent>(evt);
+				data.button = static_cast<Mouse::MouseButton>(code);
+				data.x = x;
+				data.y = y;
+			}
+
+			frames_.push_back(frame);
+		}
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	Replay::~Replay()
+	{
+		if (out_.is_open() == true)
+		{
+			out_.close();
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Replay::RegisterJS(JS_SINGLETON obj)
+	{
+		JSFunctionRegister funcs[] = {
+			{ "recording", JSRecording },
+			{ "replaying", JSReplaying },
+			{ "frame", JSFrame }
+		};
+
+		JSFunctionRegister::Register(funcs, sizeof(funcs) / sizeof(JSFunctionRegister), obj);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Replay::JSRecording(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		wrapper.ReturnValue<bool>(Replay::Instance()->mode() == Modes::kRecording);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Replay::JSReplaying(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		wrapper.ReturnValue<bool>(Replay::Instance()->mode() == Modes::kReplaying);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Replay::JSFrame(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		wrapper.ReturnValue<double>(Replay::Instance()->frame());
+	}
+}
\ No newline at end of file
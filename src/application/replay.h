@@ -0,0 +1,163 @@
+#pragma once
+
+#include "../js/js_object.h"
+
+#include "../input/keyboard.h"
+#include "../input/mouse.h"
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+namespace snuffbox
+{
+	/**
+	* @class snuffbox::Replay
+	* @brief Records the input, delta times and random seed of a session to a binary file and feeds them back deterministically
+	* @remarks Recording is enabled with the 'record' CVar, replaying with the 'replay' CVar. While replaying, input from the window is ignored and
+	* the game quits after the last recorded frame. 'replay_fixed_step' replaces the recorded delta times and 'replay_timings' writes the measured frame times as CSV
+	* @author Danil Konings
+	*/
+	class Replay : public JSObject
+	{
+	public:
+		/**
+		* @enum snuffbox::Replay::Modes
+		* @brief The different modes the replay system can be in
+		* @author Danil Konings
+		*/
+		enum Modes
+		{
+			kNone,
+			kRecording,
+			kReplaying
+		};
+
+		/**
+		* @struct snuffbox::Replay::Frame
+		* @brief The recorded data of a single frame
+		* @author Danil Konings
+		*/
+		struct Frame
+		{
+			double delta_time; //!< The delta time of the frame in seconds
+			std::vector<Keyboard::KeyData> keys; //!< The keyboard events of the frame
+			std::vector<Mouse::MouseData> mouse; //!< The mouse events of the frame
+		};
+
+		static const uint32_t kMagic = 0x50524E53; //!< 'SNRP', the first 4 bytes of every replay file
+		static const uint32_t kVersion = 1; //!< The version of the replay format
+
+	public:
+		/// Default constructor
+		Replay();
+
+		/**
+		* @brief Retrieves the singleton instance of this class
+		* @return snuffbox::Replay* The pointer to the singleton
+		*/
+		static Replay* Instance();
+
+		/**
+		* @brief Starts recording or replaying based on the 'record' and 'replay' CVars and seeds the random number generators
+		* @remarks Should be called before the JavaScript state is initialised, as the seed of V8 can only be set before the isolate is created
+		*/
+		void Initialise();
+
+		/**
+		* @brief Passes a keyboard event through the replay system
+		* @param[in] data (const snuffbox::Keyboard::KeyData&) The event sent by the window
+		* @return bool Should the keyboard process the event?
+		*/
+		bool Filter(const Keyboard::KeyData& data);
+
+		/**
+		* @brief Passes a mouse event through the replay system
+		* @param[in] data (const snuffbox::Mouse::MouseData&) The event sent by the window
+		* @return bool Should the mouse process the event?
+		*/
+		bool Filter(const Mouse::MouseData& data);
+
+		/**
+		* @brief Records or replaces the delta time of a new frame
+		* @param[in] measured (const double&) The measured delta time in seconds
+		* @return double The delta time the game should use
+		*/
+		double DeltaTime(const double& measured);
+
+		/// Writes the recorded frame or injects the replayed input, should be called after the window processed its messages
+		void EndInput();
+
+		/// Stops recording or replaying and writes the timings of a replay
+		void Dispose();
+
+		/**
+		* @return const snuffbox::Replay::Modes& The current mode
+		*/
+		const Modes& mode() const;
+
+		/**
+		* @return const unsigned int& The index of the current frame
+		*/
+		const unsigned int& frame() const;
+
+		/// Default destructor
+		virtual ~Replay();
+
+	private:
+		/**
+		* @brief Loads the frames of a replay file into memory
+		* @param[in] in (std::ifstream&) The file to read from, positioned after the header
+		* @return bool Was every frame complete? Incomplete trailing frames are dropped
+		*/
+		bool Load(std::ifstream& in);
+
+		/**
+		* @brief Writes a value to the recording in its binary representation
+		* @param[in] value (const T&) The value to write
+		*/
+		template<typename T>
+		void Write(const T& value);
+
+		/**
+		* @brief Reads a value from the replay file
+		* @param[in] in (std::ifstream&) The file to read from
+		* @param[out] value (T*) The read value
+		* @return bool Was the value read succesfully?
+		*/
+		template<typename T>
+		static bool Read(std::ifstream& in, T* value);
+
+	private:
+		Modes mode_; //!< The current mode
+		std::ofstream out_; //!< The file being recorded to
+		std::vector<Frame> frames_; //!< The frame being recorded, or every frame of the replay
+		unsigned int frame_; //!< The index of the current frame
+		bool injecting_; //!< Is recorded input being injected?
+		double fixed_step_; //!< The delta time in seconds to replay with, 0 replays the recorded delta times
+		std::string timings_path_; //!< The path to write the frame timings of a replay to
+		std::vector<double> timings_; //!< The measured frame times of a replay in milliseconds
+
+	public:
+		JS_NAME("Replay");
+		static void RegisterJS(JS_SINGLETON obj);
+		static void JSRecording(JS_ARGS args);
+		static void JSReplaying(JS_ARGS args);
+		static void JSFrame(JS_ARGS args);
+	};
+
+	//-------------------------------------------------------------------------------------------
+	template<typename T>
+	inline void Replay::Write(const T& value)
+	{
+		out_.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	template<typename T>
+	inline bool Replay::Read(std::ifstream& in, T* value)
+	{
+		in.read(reinterpret_cast<char*>(value), sizeof(T));
+		return in.gcount() == sizeof(T);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include "../application/scheduler.h"
+#include "../application/logging.h"
+
+#include "../memory/allocated_memory.h"
+#include "../memory/shared_ptr.h"
+
+namespace snuffbox
+{
+	//-------------------------------------------------------------------------------------------
+	Scheduler::Scheduler() :
+		next_id_(1)
+	{
+
+	}
+
+	//-------------------------------------------------------------------------------------------
+	Scheduler* Scheduler::Instance()
+	{
+		static SharedPtr<Scheduler> scheduler = AllocatedMemory::Instance().Construct<Scheduler>();
+		return scheduler.get();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	unsigned int Scheduler::Schedule(const v8::Handle<v8::Function>& callback, const double& delay, const bool& repeat, const bool& game_time)
+	{
+		unsigned int id = next_id_++;
+
+		if (next_id_ == 0)
+		{
+			next_id_ = 1;
+		}
+
+		TimerWheel& wheel = game_time == true ? game_time_ : real_time_;
+		wheel.Add(id, callback, delay, repeat);
+
+		return id;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Scheduler::Cancel(const unsigned int& id)
+	{
+		if (real_time_.Cancel(id) == false)
+		{
+			game_time_.Cancel(id);
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Scheduler::Update(const double& dt, const double& game_dt)
+	{
+		real_time_.Advance(dt);
+		game_time_.Advance(game_dt);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Scheduler::Clear()
+	{
+		real_time_.Clear();
+		game_time_.Clear();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	Scheduler::~Scheduler()
+	{
+
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Scheduler::RegisterJS(JS_SINGLETON obj)
+	{
+		JSFunctionRegister funcs[] = {
+			{ "setTimeout", JSSetTimeout },
+			{ "setInterval", JSSetInterval },
+			{ "setGameTimeout", JSSetGameTimeout },
+			{ "setGameInterval", JSSetGameInterval },
+			{ "clearTimeout", JSClearTimeout },
+			{ "clearInterval", JSClearTimeout },
+			{ "size", JSSize }
+		};
+
+		JSFunctionRegister::Register(funcs, sizeof(funcs) / sizeof(JSFunctionRegister), obj);
+
+		JSStateWrapper* wrapper = JSStateWrapper::Instance();
+		v8::Isolate* isolate = wrapper->isolate();
+
+		wrapper->RegisterGlobal("setTimeout", v8::Function::New(isolate, JSSetTimeout));
+		wrapper->RegisterGlobal("setInterval", v8::Function::New(isolate, JSSetInterval));
+		wrapper->RegisterGlobal("clearTimeout", v8::Function::New(isolate, JSClearTimeout));
+		wrapper->RegisterGlobal("clearInterval", v8::Function::New(isolate, JSClearTimeout));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Scheduler::JSSetTimeout(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		if (wrapper.Check("F") == false)
+		{
+			return;
+		}
+
+		wrapper.ReturnValue<double>(Scheduler::Instance()->Schedule(args[0].As<v8::Function>(), wrapper.GetValue<double>(1, 0.0), false, false));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Scheduler::JSSetInterval(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		if (wrapper.Check("F") == false)
+		{
+			return;
+		}
+
+		wrapper.ReturnValue<double>(Scheduler::Instance()->Schedule(args[0].As<v8::Function>(), wrapper.GetValue<double>(1, 0.0), true, false));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Scheduler::JSSetGameTimeout(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		if (wrapper.Check("F") == false)
+		{
+			return;
+		}
+
+		wrapper.ReturnValue<double>(Scheduler::Instance()->Schedule(args[0].As<v8::Function>(), wrapper.GetValue<double>(1, 0.0), false, true));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Scheduler::JSSetGameInterval(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		if (wrapper.Check("F") == false)
+		{
+			return;
+		}
+
+		wrapper.ReturnValue<double>(Scheduler::Instance()->Schedule(args[0].As<v8::Function>(), wrapper.GetValue<double>(1, 0.0), true, true));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Scheduler::JSClearTimeout(JS_ARGS args)
+	{
+		if (args[0]->IsUndefined() == true || args[0]->IsNull() == true)
+		{
+			return;
+		}
+
+		JSWrapper wrapper(args);
+		if (wrapper.Check("N") == false)
+		{
+			return;
+		}
+
+		Scheduler::Instance()->Cancel(static_cast<unsigned int>(wrapper.GetValue<double>(0, 0.0)));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Scheduler::JSSize(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		Scheduler* self = Scheduler::Instance();
+
+		wrapper.ReturnValue<double>(static_cast<double>(self->real_time_.size() + self->game_time_.size()));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "../application/timer_wheel.h"
+#include "../js/js_object.h"
+
+namespace snuffbox
+{
+	/**
+	* @class snuffbox::Scheduler
+	* @brief Schedules script timeouts and intervals, either on real time or on game time which stands still while the game is paused
+	* @author Danil Konings
+	*/
+	class Scheduler : public JSObject
+	{
+	public:
+		/// Default constructor
+		Scheduler();
+
+		/**
+		* @brief Retrieves the singleton instance of this class
+		* @return snuffbox::Scheduler* The pointer to the singleton
+		*/
+		static Scheduler* Instance();
+
+		/**
+		* @brief Schedules a callback
+		* @param[in] callback (const v8::Handle<v8::Function>&) The function to call
+		* @param[in] delay (const double&) The delay in milliseconds
+		* @param[in] repeat (const bool&) Should the callback be called every delay?
+		* @param[in] game_time (const bool&) Should the delay be measured in game time?
+		* @return unsigned int The ID of the timer, used to cancel it
+		*/
+		unsigned int Schedule(const v8::Handle<v8::Function>& callback, const double& delay, const bool& repeat, const bool& game_time);
+
+		/**
+		* @brief Cancels a timer
+		* @param[in] id (const unsigned int&) The ID of the timer to cancel
+		*/
+		void Cancel(const unsigned int& id);
+
+		/**
+		* @brief Advances both timer wheels
+		* @param[in] dt (const double&) The real time that passed in milliseconds
+		* @param[in] game_dt (const double&) The game time that passed in milliseconds
+		*/
+		void Update(const double& dt, const double& game_dt);
+
+		/// Cancels all timers, should be called before the JavaScript state is disposed
+		void Clear();
+
+		/// Default destructor
+		virtual ~Scheduler();
+
+	private:
+		TimerWheel real_time_; //!< The timers that run on real time
+		TimerWheel game_time_; //!< The timers that run on game time
+		unsigned int next_id_; //!< The ID of the next timer
+
+	public:
+		JS_NAME("Scheduler");
+		static void RegisterJS(JS_SINGLETON obj);
+		static void JSSetTimeout(JS_ARGS args);
+		static void JSSetInterval(JS_ARGS args);
+		static void JSSetGameTimeout(JS_ARGS args);
+		static void JSSetGameInterval(JS_ARGS args);
+		static void JSClearTimeout(JS_ARGS args);
+		static void JSSize(JS_ARGS args);
+	};
+}
\ No newline at end of file
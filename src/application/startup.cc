@@ -0,0 +1,248 @@
+#include "../application/startup.h"
+#include "../application/logging.h"
+
+#include "../cvar/cvar.h"
+#include "../io/io_manager.h"
+
+#include "../memory/allocated_memory.h"
+
+namespace snuffbox
+{
+	//-------------------------------------------------------------------------------------------
+	Startup::Startup() :
+		origin_(Clock::now()),
+		lanes_(1),
+		time_to_first_frame_(0.0)
+	{
+
+	}
+
+	//-------------------------------------------------------------------------------------------
+	Startup* Startup::Instance()
+	{
+		static SharedPtr<Startup> startup = AllocatedMemory::Instance().Construct<Startup>();
+		return startup.get();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Startup::Add(const std::string& name, const Threads& thread, const std::vector<std::string>& dependencies, const std::function<void()>& func)
+	{
+		for (unsigned int i = 0; i < dependencies.size(); ++i)
+		{
+			bool found = false;
+			for (unsigned int j = 0; j < tasks_.size() && found == false; ++j)
+			{
+				found = tasks_.at(j).name == dependencies.at(i);
+			}
+
+			// Dependencies have to be added first, which also rules out cycles
+			SNUFF_XASSERT(found == true, "Startup task '" + name + "' depends on '" + dependencies.at(i) + "', which has not been added before it", "Startup::Add");
+		}
+
+		Task task;
+		task.name = name;
+		task.thread = thread;
+		task.dependencies = dependencies;
+		task.func = func;
+		task.started = false;
+		task.done = false;
+		task.start = 0.0;
+		task.end = 0.0;
+		task.lane = 0;
+
+		tasks_.push_back(task);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Startup::Run()
+	{
+		bool found = false;
+		CVar::Value* parallel = CVar::Instance()->Get("startup_parallel", &found);
+		bool serial = found == true && parallel->IsBool() == true && parallel->As<CVar::Boolean>()->value() == false;
+
+		std::vector<std::thread> threads;
+		std::unique_lock<std::mutex> lock(mutex_);
+
+		while (true)
+		{
+			Task* main = nullptr;
+			bool remaining = false;
+
+			for (unsigned int i = 0; i < tasks_.size(); ++i)
+			{
+				Task& task = tasks_.at(i);
+				remaining = remaining == true || task.done == false;
+
+				if (task.started == true || Ready(task) == false)
+				{
+					continue;
+				}
+
+				if (task.thread == Threads::kAny && serial == false)
+				{
+					task.started = true;
+					task.lane = lanes_++;
+					threads.push_back(std::thread(&Startup::Execute, this, &task));
+				}
+				else if (main == nullptr)
+				{
+					main = &task;
+				}
+			}
+
+			if (remaining == false)
+			{
+				break;
+			}
+
+			if (main != nullptr)
+			{
+				main->started = true;
+				lock.unlock();
+				Execute(main);
+				lock.lock();
+				continue;
+			}
+
+			finished_signal_.wait(lock);
+		}
+
+		lock.unlock();
+
+		for (unsigned int i = 0; i < threads.size(); ++i)
+		{
+			threads.at(i).join();
+		}
+
+		finished_.insert(finished_.end(), tasks_.begin(), tasks_.end());
+		tasks_.clear();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Startup::Mark(const std::string& name)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		marks_.push_back(std::make_pair(name, Now()));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Startup::FirstFrame()
+	{
+		if (time_to_first_frame_ > 0.0)
+		{
+			return;
+		}
+
+		time_to_first_frame_ = Now();
+		Mark("First frame");
+
+		double busy = 0.0;
+		for (unsigned int i = 0; i < finished_.size(); ++i)
+		{
+			busy += finished_.at(i).end - finished_.at(i).start;
+		}
+
+		SNUFF_LOG_INFO("Time to first frame: " + std::to_string(time_to_first_frame_) + " ms, " + std::to_string(busy) + " ms spent in " + std::to_string(finished_.size()) + " startup task(s)");
+		WriteTimeline();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	double Startup::Now() const
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - origin_).count();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	const double& Startup::time_to_first_frame() const
+	{
+		return time_to_first_frame_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Startup::Execute(Task* task)
+	{
+		double start = Now();
+		task->func();
+		double end = Now();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			task->start = start;
+			task->end = end;
+			task->done = true;
+		}
+
+		finished_signal_.notify_one();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool Startup::Ready(const Task& task) const
+	{
+		for (unsigned int i = 0; i < task.dependencies.size(); ++i)
+		{
+			for (unsigned int j = 0; j < tasks_.size(); ++j)
+			{
+				if (tasks_.at(j).name == task.dependencies.at(i) && tasks_.at(j).done == false)
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void Startup::WriteTimeline()
+	{
+		std::string path = "startup_timeline.json";
+
+		bool found = false;
+		CVar::Value* value = CVar::Instance()->Get("startup_timeline", &found);
+
+		if (found == true && value->IsString() == true)
+		{
+			path = value->As<CVar::String>()->value();
+		}
+
+		if (path.empty() == true)
+		{
+			return;
+		}
+
+		std::string result = "{\"traceEvents\":[";
+		result += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"Main\"}}";
+
+		for (unsigned int i = 0; i < finished_.size(); ++i)
+		{
+			const Task& task = finished_.at(i);
+			std::string tid = std::to_string(task.lane);
+
+			if (task.lane > 0)
+			{
+				result += ",{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" + tid + ",\"args\":{\"name\":\"" + task.name + "\"}}";
+			}
+
+			result += ",{\"name\":\"" + task.name + "\",\"cat\":\"startup\",\"ph\":\"X\",\"pid\":0,\"tid\":" + tid;
+			result += ",\"ts\":" + std::to_string(task.start * 1e3) + ",\"dur\":" + std::to_string((task.end - task.start) * 1e3) + "}";
+		}
+
+		for (unsigned int i = 0; i < marks_.size(); ++i)
+		{
+			result += ",{\"name\":\"" + marks_.at(i).first + "\",\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":0,\"ts\":" + std::to_string(marks_.at(i).second * 1e3) + "}";
+		}
+
+		result += "],\"displayTimeUnit\":\"ms\"}";
+
+		if (IOManager::Instance()->Write(path, result) == false)
+		{
+			SNUFF_LOG_WARNING("Could not write the startup timeline to '" + path + "'");
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	Startup::~Startup()
+	{
+
+	}
+}
\ No newline at end of file
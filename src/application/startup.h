@@ -0,0 +1,125 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace snuffbox
+{
+	/**
+	* @class snuffbox::Startup
+	* @brief Initialises the engine subsystems as a dependency graph, running the ones that don't need the main thread in parallel, and records a startup timeline
+	* @remarks The timeline is written as a Chrome trace to the path in the 'startup_timeline' CVar, relative to the game path, once the first frame has finished.
+	* An empty path disables writing it. Setting 'startup_parallel' to false runs every task on the main thread, in the order they were added
+	* @author Danil Konings
+	*/
+	class Startup
+	{
+	public:
+		typedef std::chrono::steady_clock Clock;
+
+		/**
+		* @enum snuffbox::Startup::Threads
+		* @brief Where a task is allowed to run
+		* @author Danil Konings
+		*/
+		enum Threads
+		{
+			kMain, //!< On the main thread, for APIs that are bound to the thread that created them
+			kAny //!< On a thread of its own, in parallel with the other tasks
+		};
+
+		/**
+		* @struct snuffbox::Startup::Task
+		* @brief A subsystem to initialise
+		* @author Danil Konings
+		*/
+		struct Task
+		{
+			std::string name; //!< The name of the task, shown in the timeline
+			Threads thread; //!< Where the task is allowed to run
+			std::vector<std::string> dependencies; //!< The names of the tasks that have to finish first
+			std::function<void()> func; //!< The function to run
+			bool started; //!< Has the task been started?
+			bool done; //!< Has the task finished?
+			double start; //!< The time the task started, in milliseconds since the process started
+			double end; //!< The time the task finished, in milliseconds since the process started
+			unsigned int lane; //!< The timeline lane of the task, 0 is the main thread
+		};
+
+	public:
+		/// Default constructor
+		Startup();
+
+		/**
+		* @brief Retrieves the singleton instance of this class
+		* @return snuffbox::Startup* The pointer to the singleton
+		*/
+		static Startup* Instance();
+
+		/**
+		* @brief Adds a task to the graph
+		* @param[in] name (const std::string&) The unique name of the task
+		* @param[in] thread (const snuffbox::Startup::Threads&) Where the task is allowed to run
+		* @param[in] dependencies (const std::vector<std::string>&) The names of the tasks that have to finish first, they have to be added before this task
+		* @param[in] func (const std::function<void()>&) The function to run
+		*/
+		void Add(const std::string& name, const Threads& thread, const std::vector<std::string>& dependencies, const std::function<void()>& func);
+
+		/// Runs every added task and blocks until all of them have finished, the graph is cleared afterwards
+		void Run();
+
+		/**
+		* @brief Records a moment in the timeline
+		* @param[in] name (const std::string&) The name of the moment
+		*/
+		void Mark(const std::string& name);
+
+		/// Records the time to the first frame, logs it and writes the timeline, only the first call does anything
+		void FirstFrame();
+
+		/**
+		* @return double The time since the process started in milliseconds
+		*/
+		double Now() const;
+
+		/**
+		* @return double The time from the start of the process to the end of the first frame in milliseconds, 0 if there hasn't been a frame yet
+		*/
+		const double& time_to_first_frame() const;
+
+		/// Default destructor
+		~Startup();
+
+	private:
+		/**
+		* @brief Runs a single task and records its timings
+		* @param[in] task (snuffbox::Startup::Task*) The task to run
+		*/
+		void Execute(Task* task);
+
+		/**
+		* @brief Checks if every dependency of a task has finished
+		* @param[in] task (const snuffbox::Startup::Task&) The task to check
+		* @return bool Can the task be started?
+		*/
+		bool Ready(const Task& task) const;
+
+		/// Writes the recorded timeline to the path in the 'startup_timeline' CVar
+		void WriteTimeline();
+
+	private:
+		Clock::time_point origin_; //!< The time the process started
+		std::vector<Task> tasks_; //!< The tasks of the graph that is being run
+		std::vector<Task> finished_; //!< Every task that has finished, for the timeline
+		std::vector<std::pair<std::string, double>> marks_; //!< The recorded moments
+		std::mutex mutex_; //!< Guards the task states
+		std::condition_variable finished_signal_; //!< Signalled when a task finishes
+		unsigned int lanes_; //!< The number of timeline lanes in use
+		double time_to_first_frame_; //!< The time to the first frame in milliseconds
+	};
+}
\ No newline at end of file
@@ -0,0 +1,437 @@
+#include "../application/system_scheduler.h"
+#include "../application/logging.h"
+#include "../application/cpu_profiler.h"
+
+#include "../memory/allocated_memory.h"
+#include "../memory/shared_ptr.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace snuffbox
+{
+	//-------------------------------------------------------------------------------------------
+	SystemScheduler::SystemScheduler() :
+		dirty_(false),
+		running_(false),
+		parallel_("systems_parallel", true)
+	{
+
+	}
+
+	//-------------------------------------------------------------------------------------------
+	SystemScheduler* SystemScheduler::Instance()
+	{
+		static SharedPtr<SystemScheduler> system_scheduler = AllocatedMemory::Instance().Construct<SystemScheduler>();
+		return system_scheduler.get();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool SystemScheduler::Register(const System& system)
+	{
+		if (running_ == true)
+		{
+			SNUFF_CLOG_ERROR("systems", "Attempted to register system '" + system.name + "' while the " + PhaseToString(system.phase) + " phase is running");
+			return false;
+		}
+
+		if (Find(system.name) != nullptr)
+		{
+			SNUFF_CLOG_ERROR("systems", "A system with name '" + system.name + "' already exists");
+			return false;
+		}
+
+		if (!system.func)
+		{
+			SNUFF_CLOG_ERROR("systems", "Attempted to register system '" + system.name + "' without a function");
+			return false;
+		}
+
+		SharedPtr<Entry> entry = AllocatedMemory::Instance().Construct<Entry>();
+		entry->system = system;
+		entry->enabled = true;
+		entry->time = 0.0;
+		entry->stage = 0;
+
+		systems_.push_back(entry);
+		dirty_ = true;
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void SystemScheduler::Remove(const std::string& name)
+	{
+		if (running_ == true)
+		{
+			SNUFF_CLOG_ERROR("systems", "Attempted to remove system '" + name + "' while a phase is running");
+			return;
+		}
+
+		for (std::vector<SharedPtr<Entry>>::iterator it = systems_.begin(); it != systems_.end(); ++it)
+		{
+			if ((*it)->system.name == name)
+			{
+				systems_.erase(it);
+				dirty_ = true;
+				return;
+			}
+		}
+
+		SNUFF_CLOG_WARNING("systems", "Attempted to remove non-existing system '" + name + "'");
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void SystemScheduler::SetEnabled(const std::string& name, const bool& enabled)
+	{
+		Entry* entry = Find(name);
+
+		if (entry == nullptr)
+		{
+			SNUFF_CLOG_WARNING("systems", "Attempted to enable or disable non-existing system '" + name + "'");
+			return;
+		}
+
+		entry->enabled = enabled;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void SystemScheduler::Run(const Phases& phase, const double& dt)
+	{
+		if (dirty_ == true)
+		{
+			Build();
+		}
+
+		const std::vector<Stage>& stages = stages_[phase];
+
+		if (stages.empty() == true)
+		{
+			return;
+		}
+
+		SNUFF_PROFILE_SCOPE(PhaseToString(phase));
+
+		bool parallel = parallel_.get();
+
+		JobSystem* job_system = JobSystem::Instance();
+		running_ = true;
+
+		for (unsigned int i = 0; i < stages.size(); ++i)
+		{
+			const Stage& stage = stages.at(i);
+			Context context = { &stage, dt };
+
+			if (parallel == false)
+			{
+				RunJob(&context, 0, static_cast<int>(stage.jobs.size()));
+
+				for (unsigned int j = 0; j < stage.main.size(); ++j)
+				{
+					Execute(stage.main.at(j), dt);
+				}
+
+				continue;
+			}
+
+			// The main thread systems run while the workers pick up the jobs, the main thread helps out once it is done
+			JobSystem::Counter counter;
+			job_system->Dispatch(&SystemScheduler::RunJob, &context, static_cast<int>(stage.jobs.size()), 1, &counter);
+
+			for (unsigned int j = 0; j < stage.main.size(); ++j)
+			{
+				Execute(stage.main.at(j), dt);
+			}
+
+			job_system->Wait(&counter);
+		}
+
+		running_ = false;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	SystemScheduler::Entry* SystemScheduler::Find(const std::string& name)
+	{
+		for (unsigned int i = 0; i < systems_.size(); ++i)
+		{
+			if (systems_.at(i)->system.name == name)
+			{
+				return systems_.at(i).get();
+			}
+		}
+
+		return nullptr;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	const char* SystemScheduler::PhaseToString(const Phases& phase)
+	{
+		switch (phase)
+		{
+		case Phases::kInput:
+			return "Systems::Input";
+
+		case Phases::kFixedUpdate:
+			return "Systems::FixedUpdate";
+
+		case Phases::kUpdate:
+			return "Systems::Update";
+
+		case Phases::kPreRender:
+			return "Systems::PreRender";
+
+		default:
+			return "Systems::Unknown";
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool SystemScheduler::Conflicts(const System& a, const System& b)
+	{
+		for (unsigned int i = 0; i < a.writes.size(); ++i)
+		{
+			const std::string& resource = a.writes.at(i);
+
+			if (std::find(b.writes.begin(), b.writes.end(), resource) != b.writes.end() ||
+				std::find(b.reads.begin(), b.reads.end(), resource) != b.reads.end())
+			{
+				return true;
+			}
+		}
+
+		for (unsigned int i = 0; i < b.writes.size(); ++i)
+		{
+			if (std::find(a.reads.begin(), a.reads.end(), b.writes.at(i)) != a.reads.end())
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool SystemScheduler::Precedes(const System& a, const System& b)
+	{
+		return std::find(a.before.begin(), a.before.end(), b.name) != a.before.end() ||
+			std::find(b.after.begin(), b.after.end(), a.name) != b.after.end();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void SystemScheduler::Build()
+	{
+		for (int p = 0; p < Phases::kCount; ++p)
+		{
+			std::vector<Entry*> entries;
+			for (unsigned int i = 0; i < systems_.size(); ++i)
+			{
+				if (systems_.at(i)->system.phase == p)
+				{
+					entries.push_back(systems_.at(i).get());
+				}
+			}
+
+			unsigned int count = static_cast<unsigned int>(entries.size());
+
+			for (unsigned int i = 0; i < count; ++i)
+			{
+				const System& system = entries.at(i)->system;
+				std::vector<std::string> names = system.after;
+				names.insert(names.end(), system.before.begin(), system.before.end());
+
+				for (unsigned int j = 0; j < names.size(); ++j)
+				{
+					Entry* other = Find(names.at(j));
+
+					if (other == nullptr || other->system.phase != system.phase)
+					{
+						SNUFF_CLOG_WARNING("systems", "System '" + system.name + "' is ordered against '" + names.at(j) + "', which is not a system of the same phase");
+					}
+				}
+			}
+
+			// Explicit ordering takes precedence, otherwise conflicting systems run in the order they were registered
+			std::vector<std::vector<unsigned int>> successors(count);
+			std::vector<int> remaining(count, 0);
+
+			for (unsigned int i = 0; i < count; ++i)
+			{
+				for (unsigned int j = i + 1; j < count; ++j)
+				{
+					const System& a = entries.at(i)->system;
+					const System& b = entries.at(j)->system;
+
+					if (Precedes(b, a) == true)
+					{
+						if (Precedes(a, b) == true)
+						{
+							SNUFF_CLOG_ERROR("systems", "Systems '" + a.name + "' and '" + b.name + "' are both ordered before each other, '" + b.name + "' runs first");
+						}
+
+						successors.at(j).push_back(i);
+						++remaining.at(i);
+					}
+					else if (Precedes(a, b) == true || Conflicts(a, b) == true)
+					{
+						successors.at(i).push_back(j);
+						++remaining.at(j);
+					}
+				}
+			}
+
+			std::vector<int> stages(count, 0);
+			std::vector<bool> placed(count, false);
+			unsigned int left = count;
+			bool progress = true;
+
+			while (left > 0 && progress == true)
+			{
+				progress = false;
+
+				for (unsigned int i = 0; i < count; ++i)
+				{
+					if (placed.at(i) == true || remaining.at(i) > 0)
+					{
+						continue;
+					}
+
+					for (unsigned int j = 0; j < successors.at(i).size(); ++j)
+					{
+						unsigned int next = successors.at(i).at(j);
+						stages.at(next) = std::max(stages.at(next), stages.at(i) + 1);
+						--remaining.at(next);
+					}
+
+					placed.at(i) = true;
+					--left;
+					progress = true;
+				}
+			}
+
+			int last = -1;
+			for (unsigned int i = 0; i < count; ++i)
+			{
+				last = placed.at(i) == true ? std::max(last, stages.at(i)) : last;
+			}
+
+			if (left > 0)
+			{
+				std::string cycle;
+				for (unsigned int i = 0; i < count; ++i)
+				{
+					if (placed.at(i) == false)
+					{
+						cycle += (cycle.empty() == true ? "'" : ", '") + entries.at(i)->system.name + "'";
+						stages.at(i) = ++last;
+					}
+				}
+
+				SNUFF_CLOG_ERROR("systems", "The ordering of systems " + cycle + " in the " + PhaseToString(static_cast<Phases>(p)) + " phase contains a cycle, they run one after another in the order they were registered");
+			}
+
+			std::vector<Stage>& result = stages_[p];
+			result.clear();
+			result.resize(last + 1);
+
+			for (unsigned int i = 0; i < count; ++i)
+			{
+				Entry* entry = entries.at(i);
+				entry->stage = stages.at(i);
+
+				Stage& stage = result.at(entry->stage);
+				(entry->system.main_thread == true ? stage.main : stage.jobs).push_back(entry);
+			}
+
+			if (count > 0)
+			{
+				SNUFF_CLOG_DEBUG("systems", std::string(PhaseToString(static_cast<Phases>(p))) + " runs " + std::to_string(count) + " system(s) in " + std::to_string(result.size()) + " stage(s)");
+			}
+		}
+
+		dirty_ = false;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void SystemScheduler::Execute(Entry* entry, const double& dt)
+	{
+		if (entry->enabled == false)
+		{
+			entry->time = 0.0;
+			return;
+		}
+
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		entry->system.func(dt);
+		entry->time = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void SystemScheduler::RunJob(void* data, const int& start, const int& end)
+	{
+		const Context* context = static_cast<const Context*>(data);
+
+		for (int i = start; i < end; ++i)
+		{
+			Execute(context->stage->jobs.at(i), context->dt);
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	SystemScheduler::~SystemScheduler()
+	{
+
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void SystemScheduler::RegisterJS(JS_SINGLETON obj)
+	{
+		JSFunctionRegister funcs[] = {
+			{ "setEnabled", JSSetEnabled },
+			{ "list", JSList }
+		};
+
+		JSFunctionRegister::Register(funcs, sizeof(funcs) / sizeof(JSFunctionRegister), obj);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void SystemScheduler::JSSetEnabled(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+
+		if (wrapper.Check("SB") == true)
+		{
+			SystemScheduler::Instance()->SetEnabled(wrapper.GetValue<std::string>(0, "undefined"), wrapper.GetValue<bool>(1, true));
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void SystemScheduler::JSList(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		SystemScheduler* self = SystemScheduler::Instance();
+
+		if (self->dirty_ == true)
+		{
+			self->Build();
+		}
+
+		v8::Handle<v8::Array> arr = JSWrapper::CreateArray();
+
+		for (unsigned int i = 0; i < self->systems_.size(); ++i)
+		{
+			const Entry* entry = self->systems_.at(i).get();
+
+			v8::Handle<v8::Object> obj = JSWrapper::CreateObject();
+			JSWrapper::SetObjectValue<std::string>(obj, "name", entry->system.name);
+			JSWrapper::SetObjectValue<std::string>(obj, "phase", PhaseToString(entry->system.phase));
+			JSWrapper::SetObjectValue<int>(obj, "stage", entry->stage);
+			JSWrapper::SetObjectValue<bool>(obj, "enabled", entry->enabled);
+			JSWrapper::SetObjectValue<bool>(obj, "mainThread", entry->system.main_thread);
+			JSWrapper::SetObjectValue<double>(obj, "time", entry->time);
+
+			JSWrapper::SetArrayValue<v8::Handle<v8::Object>>(arr, static_cast<int>(i), obj);
+		}
+
+		wrapper.ReturnValue<v8::Handle<v8::Array>>(arr);
+	}
+}
\ No newline at end of file
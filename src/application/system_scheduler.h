@@ -0,0 +1,202 @@
+#pragma once
+
+#include "../js/js_object.h"
+#include "../application/job_system.h"
+#include "../cvar/cvar.h"
+
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace snuffbox
+{
+	/**
+	* @class snuffbox::SystemScheduler
+	* @brief Runs native C++ systems in the phases of a frame, systems that don't conflict on the resources they read and write run in parallel on the job system
+	* @remarks Every phase is split into stages, a system is placed in a stage after every system it conflicts with or is ordered after. Two systems conflict
+	* when one of them writes a resource the other reads or writes, conflicting systems keep the order they were registered in.
+	* The native systems of a phase run before the JavaScript callback of that phase. Systems only run on the main thread when they are marked as such,
+	* which is required to touch JavaScript or the render device. Setting 'systems_parallel' to false runs every system on the main thread
+	* @author Danil Konings
+	*/
+	class SystemScheduler : public JSObject
+	{
+	public:
+		/**
+		* @enum snuffbox::SystemScheduler::Phases
+		* @brief The phases of a frame systems can run in
+		* @author Danil Konings
+		*/
+		enum Phases
+		{
+			kInput, //!< After the keyboard and mouse have been updated
+			kFixedUpdate, //!< Every fixed step, skipped while the game is paused
+			kUpdate, //!< Every frame, before Game.Update
+			kPreRender, //!< Every frame, before the render device starts drawing
+			kCount //!< The number of phases
+		};
+
+		/**
+		* @brief The signature of a system
+		* @param[in] dt (const double&) The delta time of the phase in seconds, the fixed step for snuffbox::SystemScheduler::Phases::kFixedUpdate
+		*/
+		typedef std::function<void(const double& dt)> SystemFunction;
+
+		/**
+		* @struct snuffbox::SystemScheduler::System
+		* @brief The description of a system
+		* @author Danil Konings
+		*/
+		struct System
+		{
+			/// Default constructor
+			System() : phase(Phases::kUpdate), main_thread(false){}
+
+			std::string name; //!< The unique name of the system
+			Phases phase; //!< The phase to run the system in
+			std::vector<std::string> reads; //!< The names of the resources the system reads
+			std::vector<std::string> writes; //!< The names of the resources the system writes
+			std::vector<std::string> after; //!< The names of the systems in the same phase that have to run before this system
+			std::vector<std::string> before; //!< The names of the systems in the same phase that have to run after this system
+			bool main_thread; //!< Does the system have to run on the main thread?
+			SystemFunction func; //!< The function to run
+		};
+
+		/**
+		* @struct snuffbox::SystemScheduler::Entry
+		* @brief A registered system and its state
+		* @author Danil Konings
+		*/
+		struct Entry
+		{
+			System system; //!< The description of the system
+			bool enabled; //!< Is the system enabled?
+			double time; //!< The duration of the last run in milliseconds
+			int stage; //!< The stage of the system within its phase
+		};
+
+		/**
+		* @struct snuffbox::SystemScheduler::Stage
+		* @brief A group of systems that don't conflict with each other
+		* @author Danil Konings
+		*/
+		struct Stage
+		{
+			std::vector<Entry*> jobs; //!< The systems that can run on any thread
+			std::vector<Entry*> main; //!< The systems that have to run on the main thread
+		};
+
+		/**
+		* @struct snuffbox::SystemScheduler::Context
+		* @brief The user data of the jobs of a stage
+		* @author Danil Konings
+		*/
+		struct Context
+		{
+			const Stage* stage; //!< The stage being run
+			double dt; //!< The delta time passed to the systems
+		};
+
+	public:
+		/// Default constructor
+		SystemScheduler();
+
+		/**
+		* @brief Retrieves the singleton instance of this class
+		* @return snuffbox::SystemScheduler* The pointer to the singleton
+		*/
+		static SystemScheduler* Instance();
+
+		/**
+		* @brief Registers a system, should not be called while a phase is running
+		* @param[in] system (const snuffbox::SystemScheduler::System&) The description of the system
+		* @return bool Was the system registered? Fails if the name is already in use or the system has no function
+		*/
+		bool Register(const System& system);
+
+		/**
+		* @brief Removes a system, should not be called while a phase is running
+		* @param[in] name (const std::string&) The name of the system
+		*/
+		void Remove(const std::string& name);
+
+		/**
+		* @brief Enables or disables a system, disabled systems keep their place in the schedule
+		* @param[in] name (const std::string&) The name of the system
+		* @param[in] enabled (const bool&) Should the system be enabled?
+		*/
+		void SetEnabled(const std::string& name, const bool& enabled);
+
+		/**
+		* @brief Runs every enabled system of a phase and waits for them to finish, should be called from the main thread
+		* @param[in] phase (const snuffbox::SystemScheduler::Phases&) The phase to run
+		* @param[in] dt (const double&) The delta time in seconds
+		*/
+		void Run(const Phases& phase, const double& dt);
+
+		/**
+		* @brief Retrieves a registered system
+		* @param[in] name (const std::string&) The name of the system
+		* @return snuffbox::SystemScheduler::Entry* The system, or nullptr if it doesn't exist
+		*/
+		Entry* Find(const std::string& name);
+
+		/**
+		* @brief Converts a phase to its name
+		* @param[in] phase (const snuffbox::SystemScheduler::Phases&) The phase
+		* @return const char* The name of the phase
+		*/
+		static const char* PhaseToString(const Phases& phase);
+
+		/// Default destructor
+		virtual ~SystemScheduler();
+
+	private:
+		/**
+		* @brief Checks if two systems can't run at the same time
+		* @param[in] a (const snuffbox::SystemScheduler::System&) The first system
+		* @param[in] b (const snuffbox::SystemScheduler::System&) The second system
+		* @return bool Does one of the systems write a resource the other one reads or writes?
+		*/
+		static bool Conflicts(const System& a, const System& b);
+
+		/**
+		* @brief Checks if a system has to run before another one because of their explicit ordering
+		* @param[in] a (const snuffbox::SystemScheduler::System&) The first system
+		* @param[in] b (const snuffbox::SystemScheduler::System&) The second system
+		* @return bool Is 'a' ordered before 'b'?
+		*/
+		static bool Precedes(const System& a, const System& b);
+
+		/// Rebuilds the stages of every phase
+		void Build();
+
+		/**
+		* @brief Runs a single system and records its duration
+		* @param[in] entry (snuffbox::SystemScheduler::Entry*) The system to run
+		* @param[in] dt (const double&) The delta time in seconds
+		*/
+		static void Execute(Entry* entry, const double& dt);
+
+		/**
+		* @brief Runs the systems of a stage in the range [start, end), as a job
+		* @param[in] data (void*) The snuffbox::SystemScheduler::Context of the stage
+		* @param[in] start (const int&) The first system to run
+		* @param[in] end (const int&) One past the last system to run
+		*/
+		static void RunJob(void* data, const int& start, const int& end);
+
+	private:
+		std::vector<SharedPtr<Entry>> systems_; //!< The registered systems, in the order they were registered
+		std::vector<Stage> stages_[Phases::kCount]; //!< The stages of every phase
+		bool dirty_; //!< Do the stages have to be rebuilt?
+		bool running_; //!< Is a phase running?
+		CVarRef<bool> parallel_; //!< The 'systems_parallel' CVar, bound once as it is read every phase
+
+	public:
+		JS_NAME("Systems");
+		static void RegisterJS(JS_SINGLETON obj);
+		static void JSSetEnabled(JS_ARGS args);
+		static void JSList(JS_ARGS args);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,214 @@
+#include "../application/timer_wheel.h"
+#include "../application/logging.h"
+
+#include "../js/js_state_wrapper.h"
+
+#include "../memory/allocated_memory.h"
+
+using namespace v8;
+
+namespace snuffbox
+{
+	//-------------------------------------------------------------------------------------------
+	TimerWheel::TimerWheel() :
+		current_(0),
+		remainder_(0.0)
+	{
+
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void TimerWheel::Add(const unsigned int& id, const Handle<Function>& callback, const double& delay, const bool& repeat)
+	{
+		uint64_t ticks = delay < 1.0 ? 1 : static_cast<uint64_t>(delay);
+
+		Timer* timer = AllocatedMemory::Instance().Construct<Timer>();
+		timer->id = id;
+		timer->expires = current_ + ticks;
+		timer->interval = repeat == true ? ticks : 0;
+		timer->callback.Reset(JSStateWrapper::Instance()->isolate(), callback);
+
+		timers_.emplace(id, timer);
+		Insert(timer);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool TimerWheel::Cancel(const unsigned int& id)
+	{
+		std::unordered_map<unsigned int, Timer*>::iterator it = timers_.find(id);
+		if (it == timers_.end())
+		{
+			return false;
+		}
+
+		Remove(it->second);
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void TimerWheel::Advance(const double& dt)
+	{
+		if (dt <= 0.0)
+		{
+			return;
+		}
+
+		remainder_ += dt;
+		uint64_t ticks = static_cast<uint64_t>(remainder_);
+		remainder_ -= static_cast<double>(ticks);
+
+		for (uint64_t i = 0; i < ticks; ++i)
+		{
+			// Nothing can expire in an empty wheel, so the remaining ticks can be skipped at once
+			if (timers_.empty() == true)
+			{
+				current_ += ticks - i;
+				return;
+			}
+
+			Tick();
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void TimerWheel::Clear()
+	{
+		while (timers_.empty() == false)
+		{
+			Remove(timers_.begin()->second);
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	size_t TimerWheel::size() const
+	{
+		return timers_.size();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void TimerWheel::Insert(Timer* timer)
+	{
+		uint64_t expires = timer->expires;
+		uint64_t delta = expires - current_;
+
+		int level = 0;
+		while (level < kLevels - 1 && delta >= (static_cast<uint64_t>(1) << (kSlotBits * (level + 1))))
+		{
+			++level;
+		}
+
+		int slot = static_cast<int>((expires >> (kSlotBits * level)) & (kSlots - 1));
+		Append(&slots_[level][slot], timer);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void TimerWheel::Cascade(const int& level, const int& slot)
+	{
+		Link& list = slots_[level][slot];
+
+		Link* link = nullptr;
+		while (list.next != &list)
+		{
+			link = list.next;
+			Unlink(link);
+			Insert(static_cast<Timer*>(link));
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void TimerWheel::Tick()
+	{
+		++current_;
+
+		for (int level = 1; level < kLevels; ++level)
+		{
+			if ((current_ & ((static_cast<uint64_t>(1) << (kSlotBits * level)) - 1)) != 0)
+			{
+				break;
+			}
+
+			Cascade(level, static_cast<int>((current_ >> (kSlotBits * level)) & (kSlots - 1)));
+		}
+
+		Link& slot = slots_[0][current_ & (kSlots - 1)];
+		if (slot.next == &slot)
+		{
+			return;
+		}
+
+		// Move the expired timers to a separate list first, so callbacks can safely add or cancel timers
+		Link expired;
+		expired.next = slot.next;
+		expired.prev = slot.prev;
+		expired.next->prev = &expired;
+		expired.prev->next = &expired;
+		slot.next = slot.prev = &slot;
+
+		JSStateWrapper* wrapper = JSStateWrapper::Instance();
+		Isolate* isolate = wrapper->isolate();
+		HandleScope scope(isolate);
+
+		Local<Object> global = wrapper->global();
+		Local<Function> callback;
+		Timer* timer = nullptr;
+
+		while (expired.next != &expired)
+		{
+			timer = static_cast<Timer*>(expired.next);
+			Unlink(timer);
+
+			callback = Local<Function>::New(isolate, timer->callback);
+
+			if (timer->interval > 0)
+			{
+				timer->expires = current_ + timer->interval;
+				Insert(timer);
+			}
+			else
+			{
+				Remove(timer);
+			}
+
+			TryCatch try_catch;
+			if (callback->Call(global, 0, nullptr).IsEmpty() == true)
+			{
+				std::string error;
+				if (wrapper->GetException(&try_catch, &error) == true)
+				{
+					SNUFF_LOG_ERROR(error);
+				}
+			}
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void TimerWheel::Remove(Timer* timer)
+	{
+		Unlink(timer);
+		timers_.erase(timer->id);
+		AllocatedMemory::Instance().Destruct<Timer>(timer);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void TimerWheel::Unlink(Link* link)
+	{
+		link->prev->next = link->next;
+		link->next->prev = link->prev;
+		link->prev = link->next = link;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void TimerWheel::Append(Link* list, Link* link)
+	{
+		link->prev = list->prev;
+		link->next = list;
+		list->prev->next = link;
+		list->prev = link;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	TimerWheel::~TimerWheel()
+	{
+
+	}
+}
\ No newline at end of file
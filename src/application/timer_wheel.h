@@ -0,0 +1,135 @@
+#pragma once
+
+#include <v8.h>
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace snuffbox
+{
+	/**
+	* @class snuffbox::TimerWheel
+	* @brief A hierarchical timer wheel with a resolution of a millisecond, timers are inserted and cancelled in constant time
+	* @remarks Every level has 256 slots, timers that don't fit the lowest level are cascaded down whenever a lower level wraps around
+	* @author Danil Konings
+	*/
+	class TimerWheel
+	{
+	public:
+		/**
+		* @struct snuffbox::TimerWheel::Link
+		* @brief A link in the circular, doubly linked list of a slot
+		* @author Danil Konings
+		*/
+		struct Link
+		{
+			/// Default constructor, creates an empty list
+			Link() : prev(this), next(this){}
+
+			Link* prev; //!< The previous link
+			Link* next; //!< The next link
+		};
+
+		/**
+		* @struct snuffbox::TimerWheel::Timer
+		* @brief A single timer in the wheel
+		* @author Danil Konings
+		*/
+		struct Timer : public Link
+		{
+			/// Default constructor
+			Timer() : id(0), expires(0), interval(0){}
+
+			/// Default destructor, releases the callback
+			~Timer(){ callback.Reset(); }
+
+			unsigned int id; //!< The ID of this timer
+			uint64_t expires; //!< The tick this timer expires on
+			uint64_t interval; //!< The interval in ticks for repeating timers, 0 for timers that only fire once
+			v8::Persistent<v8::Function> callback; //!< The function to call when the timer expires
+		};
+
+		static const int kLevels = 4; //!< The number of levels in the wheel
+		static const int kSlotBits = 8; //!< The number of bits used to index a slot
+		static const int kSlots = 1 << kSlotBits; //!< The number of slots per level
+
+	public:
+		/// Default constructor
+		TimerWheel();
+
+		/**
+		* @brief Adds a timer to the wheel
+		* @param[in] id (const unsigned int&) The ID of the timer
+		* @param[in] callback (const v8::Handle<v8::Function>&) The function to call when the timer expires
+		* @param[in] delay (const double&) The delay in milliseconds
+		* @param[in] repeat (const bool&) Should the timer repeat every delay?
+		*/
+		void Add(const unsigned int& id, const v8::Handle<v8::Function>& callback, const double& delay, const bool& repeat);
+
+		/**
+		* @brief Cancels a timer
+		* @param[in] id (const unsigned int&) The ID of the timer to cancel
+		* @return bool Was the timer in this wheel?
+		*/
+		bool Cancel(const unsigned int& id);
+
+		/**
+		* @brief Advances the wheel, calling the callbacks of every timer that expires
+		* @param[in] dt (const double&) The time to advance in milliseconds
+		*/
+		void Advance(const double& dt);
+
+		/// Removes all timers
+		void Clear();
+
+		/**
+		* @return size_t The number of active timers
+		*/
+		size_t size() const;
+
+		/// Default destructor
+		~TimerWheel();
+
+	private:
+		/**
+		* @brief Inserts a timer in the slot matching its expiry tick
+		* @param[in] timer (snuffbox::TimerWheel::Timer*) The timer to insert
+		*/
+		void Insert(Timer* timer);
+
+		/**
+		* @brief Moves all timers of a slot to a lower level
+		* @param[in] level (const int&) The level of the slot
+		* @param[in] slot (const int&) The slot to cascade
+		*/
+		void Cascade(const int& level, const int& slot);
+
+		/// Advances a single tick and expires the timers in the current slot
+		void Tick();
+
+		/**
+		* @brief Removes a timer from the wheel and destructs it
+		* @param[in] timer (snuffbox::TimerWheel::Timer*) The timer to remove
+		*/
+		void Remove(Timer* timer);
+
+		/**
+		* @brief Unlinks a link from its list
+		* @param[in] link (snuffbox::TimerWheel::Link*) The link to unlink
+		*/
+		static void Unlink(Link* link);
+
+		/**
+		* @brief Appends a link to a list
+		* @param[in] list (snuffbox::TimerWheel::Link*) The list to append to
+		* @param[in] link (snuffbox::TimerWheel::Link*) The link to append
+		*/
+		static void Append(Link* list, Link* link);
+
+	private:
+		Link slots_[kLevels][kSlots]; //!< The slots of every level
+		std::unordered_map<unsigned int, Timer*> timers_; //!< All active timers by ID
+		uint64_t current_; //!< The current tick
+		double remainder_; //!< The time that was left over after the last whole tick
+	};
+}
\ No newline at end of file
@@ -3,7 +3,12 @@
 #include "../content/content_box.h"
 
 #include "../platform/platform_file_watch.h"
+#include "../js/js_module_registry.h"
+#include "../application/cpu_profiler.h"
+#include "../application/binary_log.h"
+#include "../cvar/cvar.h"
 
+#ifndef SNUFF_BUILD_NULL
 #include "../d3d11/d3d11_shader.h"
 #include "../d3d11/d3d11_effect.h"
 #include "../d3d11/d3d11_blend_state.h"
@@ -13,6 +18,7 @@
 #include "../d3d11/elements/particles/d3d11_particle_effect.h"
 #include "../fbx/fbx_model.h"
 #include "../animation/anim.h"
+#endif
 #include "../fmod/fmod_sound.h"
 
 namespace snuffbox
@@ -55,7 +61,9 @@ namespace snuffbox
 	//---------------------------------------------------------------------------------------------------------
 	void ContentManager::Load(const ContentTypes& type, const std::string& path)
 	{
-		SNUFF_LOG_INFO("Loading file '" + path + "'");
+		SNUFF_PROFILE_SCOPE("ContentManager::Load");
+
+		SNUFF_BLOG_INFO("content", "Loading file '{}'", path);
 		if (type != ContentTypes::kScript)
 		{
 			std::map<std::string, SharedPtr<Content>>::iterator it = loaded_content_.find(path);
@@ -68,7 +76,16 @@ namespace snuffbox
 
 			SharedPtr<Content> content;
 			
-			if (type == ContentTypes::kShader)
+			if (type == ContentTypes::kBox)
+			{
+				content = AllocatedMemory::Instance().Construct<Box>();
+			}
+			else if (type == ContentTypes::kSound)
+			{
+				content = AllocatedMemory::Instance().Construct<Sound>();
+			}
+#ifndef SNUFF_BUILD_NULL
+			else if (type == ContentTypes::kShader)
 			{
 				content = AllocatedMemory::Instance().Construct<D3D11Shader>();
 			}
@@ -88,22 +105,15 @@ namespace snuffbox
 			{
 				content = AllocatedMemory::Instance().Construct<FBXModel>();
 			}
-      else if (type == ContentTypes::kBox)
-      {
-        content = AllocatedMemory::Instance().Construct<Box>();
-      }
 			else if (type == ContentTypes::kAnim)
 			{
 				content = AllocatedMemory::Instance().Construct<Anim>();
 			}
-      else if (type == ContentTypes::kSound)
-      {
-        content = AllocatedMemory::Instance().Construct<Sound>();
-      }
 			else if (type == ContentTypes::kParticleEffect)
 			{
 				content = AllocatedMemory::Instance().Construct<D3D11ParticleEffect>();
 			}
+#endif
 			else
 			{
 				SNUFF_LOG_WARNING("No content loader was specified for the content type of '" + path + "'");
@@ -114,7 +124,7 @@ namespace snuffbox
       loaded_content_.emplace(path, content);
     }
 
-		SNUFF_LOG_INFO("Loaded file '" + path + "'");
+		SNUFF_BLOG_INFO("content", "Loaded file '{}'", path);
 		FileWatch::Instance()->Add(path, type);
 	}
 
@@ -123,23 +133,34 @@ namespace snuffbox
 	{
 		if (type == ContentTypes::kScript)
 		{
-			SNUFF_LOG_INFO("Hot reloaded script '" + path + "'");
+			if (JSModuleRegistry::Instance()->Reload(path) == true)
+			{
+				return;
+			}
+
+			SNUFF_BLOG_INFO("content", "Hot reloaded script '{}'", path);
 			JSStateWrapper::Instance()->CompileAndRun(path, true);
 			return;
 		}
     else if (type == ContentTypes::kBox)
     {
-      SNUFF_LOG_INFO("Edited box file '" + path + "', reload this box to load its contents");
+      SNUFF_BLOG_INFO("content", "Edited box file '{}', reload this box to load its contents", path);
       return;
     }
 		else if (type == ContentTypes::kCustom)
 		{
-			SNUFF_LOG_INFO("Hot reloaded custom file '" + path + "'");
+			SNUFF_BLOG_INFO("content", "Hot reloaded custom file '{}'", path);
       return;
 		}
+		else if (type == ContentTypes::kConfig)
+		{
+			CVar::Instance()->ReloadConfig();
+			SNUFF_BLOG_INFO("content", "Hot reloaded config file '{}'", path);
+			return;
+		}
 
 		loaded_content_.find(path)->second->Load(path);
-		SNUFF_LOG_INFO("Hot reloaded file '" + path + "'");
+		SNUFF_BLOG_INFO("content", "Hot reloaded file '{}'", path);
 	}
 
 	//---------------------------------------------------------------------------------------------------------
@@ -147,14 +168,14 @@ namespace snuffbox
 	{
     if (type == ContentTypes::kBox)
     {
-      SNUFF_LOG_INFO("Unloading box '" + path + "'");
+      SNUFF_BLOG_INFO("content", "Unloading box '{}'", path);
       loaded_content_.erase(path);
       FileWatch::Instance()->Remove(path);
-      SNUFF_LOG_INFO("Unloaded box '" + path + "'");
+      SNUFF_BLOG_INFO("content", "Unloaded box '{}'", path);
       return;
     }
 
-		SNUFF_LOG_INFO("Unloading file '" + path + "'");
+		SNUFF_BLOG_INFO("content", "Unloading file '{}'", path);
 		std::map<std::string, SharedPtr<Content>>::iterator it = loaded_content_.find(path);
 		if (it != loaded_content_.end())
 		{
@@ -165,7 +186,7 @@ namespace snuffbox
 			}
 			it->second->Invalidate();
 			to_unload_.push(path);
-			SNUFF_LOG_INFO("Unloaded file '" + path + "'");
+			SNUFF_BLOG_INFO("content", "Unloaded file '{}'", path);
 			return;
 		}
 
@@ -179,7 +200,7 @@ namespace snuffbox
 
 		if (success == true)
 		{
-			SNUFF_LOG_INFO("Added '" + path + "' to the file watch");
+			SNUFF_BLOG_INFO("content", "Added '{}' to the file watch", path);
 			return;
 		}
 		
@@ -189,11 +210,19 @@ namespace snuffbox
 	//---------------------------------------------------------------------------------------------------------
 	void ContentManager::UnloadAll()
 	{
+		released_.clear();
+
     while (to_unload_.empty() == false)
 		{
       const std::string& top = to_unload_.front();
+			std::map<std::string, SharedPtr<Content>>::iterator it = loaded_content_.find(top);
+
+			if (it != loaded_content_.end())
+			{
+				released_.push_back(it->second);
+				loaded_content_.erase(it);
+			}
 
-			loaded_content_.erase(loaded_content_.find(top));
 			FileWatch::Instance()->Remove(top);
 
       to_unload_.pop();
@@ -5,6 +5,7 @@
 #include "../js/js_object.h"
 
 #include <queue>
+#include <vector>
 
 namespace snuffbox
 {
@@ -28,6 +29,7 @@ namespace snuffbox
     kBox,
 		kAnim,
 		kParticleEffect,
+		kConfig,
     kUnknown
 	};
 
@@ -95,7 +97,7 @@ namespace snuffbox
 		*/
 		void Watch(const std::string& path);
 
-		/// Processes the unload queue
+		/// Processes the unload queue, the content unloaded by the previous call is freed first
 		void UnloadAll();
 
     /**
@@ -119,6 +121,7 @@ namespace snuffbox
 	private:
 		std::map<std::string, SharedPtr<Content>> loaded_content_;
 		std::queue<std::string> to_unload_;
+		std::vector<SharedPtr<Content>> released_; //!< The content unloaded last frame, kept alive as the frame packet drawn during the next frame can still reference it
 
 	public:
 		JS_NAME("ContentManager");
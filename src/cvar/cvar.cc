@@ -5,10 +5,19 @@
 
 #include "../js/js_state_wrapper.h"
 
+#include "../platform/platform_file_watch.h"
+
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+
 namespace snuffbox
 {
 	//-------------------------------------------------------------------------------------------
-	CVar::CVar()
+	CVar::CVar() :
+		next_listener_(0),
+		loading_(false),
+		dirty_(false)
 	{
 
 	}
@@ -46,14 +55,99 @@ namespace snuffbox
 	{
 		CVarMap::iterator it = vars_.find(name);
 
-		if (it != vars_.end())
+		if (it == vars_.end())
 		{
-			AllocatedMemory::Instance().Destruct<CVar::Value>(it->second);
-			it->second = val;
+			vars_.emplace(name, val);
+			Changed(name, val);
+			return;
+		}
+
+		Value* existing = it->second;
+
+		if (existing->type() == val->type())
+		{
+			switch (existing->type())
+			{
+			case ValueTypes::kBoolean:
+				existing->As<CVar::Boolean>()->set_value(val->As<CVar::Boolean>()->value());
+				break;
+
+			case ValueTypes::kNumber:
+				existing->As<CVar::Number>()->set_value(val->As<CVar::Number>()->value());
+				break;
+
+			case ValueTypes::kString:
+				existing->As<CVar::String>()->set_value(val->As<CVar::String>()->value());
+				break;
+			}
+
+			AllocatedMemory::Instance().Destruct<CVar::Value>(val);
+		}
+		else if (existing->bound() == true)
+		{
+			SNUFF_LOG_WARNING("CVar '" + name + "' can't change its type, the new value is ignored");
+			AllocatedMemory::Instance().Destruct<CVar::Value>(val);
 			return;
 		}
+		else
+		{
+			val->set_persistent(existing->persistent());
+			AllocatedMemory::Instance().Destruct<CVar::Value>(existing);
+			it->second = val;
+		}
+
+		Changed(name, it->second);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	unsigned int CVar::Listen(const std::string& name, const ChangeCallback& callback)
+	{
+		listeners_.push_back({ next_listener_, name, callback });
+		return next_listener_++;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void CVar::Unlisten(const unsigned int& id)
+	{
+		for (std::vector<Listener>::iterator it = listeners_.begin(); it != listeners_.end(); ++it)
+		{
+			if (it->id == id)
+			{
+				listeners_.erase(it);
+				return;
+			}
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void CVar::Changed(const std::string& name, Value* value)
+	{
+		if (loading_ == false && value->persistent() == true)
+		{
+			dirty_ = true;
+		}
+
+		// Callbacks could add or remove listeners
+		std::vector<ChangeCallback> callbacks;
+		for (unsigned int i = 0; i < listeners_.size(); ++i)
+		{
+			if (listeners_.at(i).name == name)
+			{
+				callbacks.push_back(listeners_.at(i).callback);
+			}
+		}
+
+		for (unsigned int i = 0; i < callbacks.size(); ++i)
+		{
+			callbacks.at(i)(name, value);
+		}
 
-		vars_.emplace(name, val);
+		std::map<std::string, SharedPtr<JSCallback<std::string>>>::iterator it = js_listeners_.find(name);
+		if (it != js_listeners_.end())
+		{
+			SharedPtr<JSCallback<std::string>> callback = it->second;
+			callback->Call(name);
+		}
 	}
 
 	//-------------------------------------------------------------------------------------------
@@ -125,24 +219,8 @@ namespace snuffbox
 				SkipWhiteSpaces(arguments, i);
 				std::string value = RepeatUntil({" "}, arguments, i);
 				
-				char* num;
-				double number_value = strtod(value.c_str(), &num);
-
-				if (!*num)
-				{
-					CVar::Register(name, number_value);
-				}
-				else
-				{
-					if (strcmp(value.c_str(), "true") == 0 || strcmp(value.c_str(), "false") == 0)
-					{
-						CVar::Register(name, strcmp(value.c_str(), "true") == 0);
-					}
-					else
-					{
-						CVar::Register(name, value);
-					}
-				}
+				RegisterFromString(name, value);
+				command_line_.insert(name);
 				--i;
 			}
 
@@ -189,6 +267,254 @@ namespace snuffbox
     SNUFF_LOG_INFO(result + "\n");
   }
 
+	//-------------------------------------------------------------------------------------------
+	static const char* config_layers[] = { "config/engine.cfg", "config/game.cfg", "config/user.cfg" };
+
+	//-------------------------------------------------------------------------------------------
+	void CVar::LoadConfig()
+	{
+		loading_ = true;
+
+		unsigned int count = sizeof(config_layers) / sizeof(const char*);
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			if (LoadConfigFile(config_layers[i], i == count - 1) == true)
+			{
+				SNUFF_LOG_INFO("Loaded config '" + std::string(config_layers[i]) + "'");
+			}
+		}
+
+		loading_ = false;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void CVar::WatchConfig()
+	{
+		bool found = false;
+		Value* src_directory = Get("src_directory", &found);
+
+		if (found == false || src_directory->IsString() == false)
+		{
+			return;
+		}
+
+		for (unsigned int i = 0; i < sizeof(config_layers) / sizeof(const char*); ++i)
+		{
+			std::ifstream file(src_directory->As<CVar::String>()->value() + "/" + config_layers[i]);
+
+			if (file)
+			{
+				FileWatch::Instance()->Add(config_layers[i], ContentTypes::kConfig);
+			}
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void CVar::ReloadConfig()
+	{
+		// Every layer is loaded again, so a lower layer that was edited doesn't override a higher one
+		LoadConfig();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void CVar::SetPersistent(const std::string& name, const bool& persistent)
+	{
+		CVarMap::iterator it = vars_.find(name);
+
+		if (it == vars_.end())
+		{
+			SNUFF_LOG_WARNING("Could not make CVar '" + name + "' persistent, it does not exist");
+			return;
+		}
+
+		if (it->second->persistent() != persistent)
+		{
+			it->second->set_persistent(persistent);
+			dirty_ = true;
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void CVar::Update()
+	{
+		if (dirty_ == false)
+		{
+			return;
+		}
+
+		WriteConfig();
+		dirty_ = false;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	std::string CVar::ValueToString(Value* value)
+	{
+		if (value->IsBool() == true)
+		{
+			return value->As<CVar::Boolean>()->value() == true ? "true" : "false";
+		}
+
+		if (value->IsNumber() == true)
+		{
+			char buffer[32];
+			snprintf(buffer, sizeof(buffer), "%.15g", value->As<CVar::Number>()->value());
+			return buffer;
+		}
+
+		return "\"" + value->As<CVar::String>()->value() + "\"";
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void CVar::RegisterFromString(const std::string& name, const std::string& value)
+	{
+		if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+		{
+			Register(name, value.substr(1, value.size() - 2));
+			return;
+		}
+
+		char* num;
+		double number_value = strtod(value.c_str(), &num);
+
+		if (value.empty() == false && !*num)
+		{
+			Register(name, number_value);
+		}
+		else if (value == "true" || value == "false")
+		{
+			Register(name, value == "true");
+		}
+		else
+		{
+			Register(name, value);
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool CVar::LoadConfigFile(const std::string& path, const bool& persistent)
+	{
+		bool found = false;
+		Value* src_directory = Get("src_directory", &found);
+
+		if (found == false || src_directory->IsString() == false)
+		{
+			return false;
+		}
+
+		std::ifstream file(src_directory->As<CVar::String>()->value() + "/" + path);
+
+		if (!file)
+		{
+			return false;
+		}
+
+		const char* whitespace = " \t\r\n";
+		std::string line;
+		unsigned int line_number = 0;
+
+		while (std::getline(file, line))
+		{
+			++line_number;
+
+			size_t start = line.find_first_not_of(whitespace);
+			if (start == std::string::npos || line.at(start) == '#')
+			{
+				continue;
+			}
+
+			size_t equals = line.find('=', start);
+			if (equals == std::string::npos)
+			{
+				SNUFF_LOG_WARNING("Expected 'name = value' in config '" + path + "' on line " + std::to_string(line_number));
+				continue;
+			}
+
+			std::string name = line.substr(start, equals - start);
+			name.erase(name.find_last_not_of(whitespace) + 1);
+
+			size_t value_start = line.find_first_not_of(whitespace, equals + 1);
+			std::string value = value_start != std::string::npos ? line.substr(value_start) : "";
+			value.erase(value.find_last_not_of(whitespace) + 1);
+
+			if (name.empty() == true || command_line_.find(name) != command_line_.end())
+			{
+				continue;
+			}
+
+			RegisterFromString(name, value);
+
+			if (persistent == true)
+			{
+				vars_.find(name)->second->set_persistent(true);
+			}
+		}
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void CVar::WriteConfig()
+	{
+		bool found = false;
+		Value* src_directory = Get("src_directory", &found);
+
+		if (found == false || src_directory->IsString() == false)
+		{
+			return;
+		}
+
+		std::string path = src_directory->As<CVar::String>()->value() + "/" + config_layers[sizeof(config_layers) / sizeof(const char*) - 1];
+		const char* whitespace = " \t\r\n";
+
+		std::set<std::string> written;
+		std::string result;
+		std::string line;
+
+		// Comments and existing assignments keep their place, assignments of CVars that are no longer persistent are dropped
+		std::ifstream in(path);
+		while (std::getline(in, line))
+		{
+			size_t start = line.find_first_not_of(whitespace);
+			size_t equals = start != std::string::npos && line.at(start) != '#' ? line.find('=', start) : std::string::npos;
+
+			if (equals == std::string::npos)
+			{
+				result += line + "\n";
+				continue;
+			}
+
+			std::string name = line.substr(start, equals - start);
+			name.erase(name.find_last_not_of(whitespace) + 1);
+
+			CVarMap::iterator it = vars_.find(name);
+			if (it == vars_.end() || it->second->persistent() == false || written.find(name) != written.end())
+			{
+				continue;
+			}
+
+			result += name + " = " + ValueToString(it->second) + "\n";
+			written.insert(name);
+		}
+		in.close();
+
+		for (CVarMap::iterator it = vars_.begin(); it != vars_.end(); ++it)
+		{
+			if (it->second->persistent() == true && written.find(it->first) == written.end())
+			{
+				result += it->first + " = " + ValueToString(it->second) + "\n";
+			}
+		}
+
+		std::ofstream out(path, std::ios::out | std::ios::trunc);
+		if (!out)
+		{
+			SNUFF_LOG_WARNING("Could not write the user config to '" + path + "'");
+			return;
+		}
+
+		out << result;
+	}
+
 	//-------------------------------------------------------------------------------------------
 	void CVar::SkipWhiteSpaces(const std::string& str, int& i)
 	{
@@ -256,7 +582,9 @@ namespace snuffbox
 
 	//-------------------------------------------------------------------------------------------
 	CVar::Value::Value(const ValueTypes& type) :
-		type_(type)
+		type_(type),
+		bound_(false),
+		persistent_(false)
 	{
 
 	}
@@ -279,6 +607,36 @@ namespace snuffbox
 		return type_ == ValueTypes::kString;
 	}
 
+	//-------------------------------------------------------------------------------------------
+	CVar::ValueTypes CVar::Value::type()
+	{
+		return type_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool CVar::Value::bound() const
+	{
+		return bound_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void CVar::Value::set_bound()
+	{
+		bound_ = true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool CVar::Value::persistent() const
+	{
+		return persistent_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void CVar::Value::set_persistent(const bool& persistent)
+	{
+		persistent_ = persistent;
+	}
+
 	//-------------------------------------------------------------------------------------------
 	CVar::Value::~Value()
 	{
@@ -370,7 +728,9 @@ namespace snuffbox
       { "register", JSRegister },
 			{ "exists", JSExists },
 			{ "get", JSGet },
-			{ "log", JSLog }
+			{ "log", JSLog },
+			{ "onChange", JSOnChange },
+			{ "setPersistent", JSSetPersistent }
     };
 
 		JSFunctionRegister::Register(funcs, sizeof(funcs) / sizeof(JSFunctionRegister), obj);
@@ -462,4 +822,42 @@ namespace snuffbox
 	{
 		CVar::Instance()->LogCVars();
 	}
+
+	//-------------------------------------------------------------------------------------------
+	void CVar::JSOnChange(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		CVar* self = CVar::Instance();
+
+		if (wrapper.Check("S") == false)
+		{
+			return;
+		}
+
+		std::string name = wrapper.GetValue<std::string>(0, "undefined");
+
+		if (args.Length() < 2 || args[1]->IsFunction() == false)
+		{
+			self->js_listeners_.erase(name);
+			return;
+		}
+
+		SharedPtr<JSCallback<std::string>> callback = AllocatedMemory::Instance().Construct<JSCallback<std::string>>();
+		callback->Set(args[1]);
+
+		self->js_listeners_[name] = callback;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void CVar::JSSetPersistent(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+
+		if (wrapper.Check("S") == false)
+		{
+			return;
+		}
+
+		CVar::Instance()->SetPersistent(wrapper.GetValue<std::string>(0, "undefined"), wrapper.GetValue<bool>(1, true));
+	}
 }
\ No newline at end of file
@@ -1,17 +1,25 @@
 #pragma once
 
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
+#include <functional>
 
 #include "../js/js_object.h"
 #include "../js/js_wrapper.h"
+#include "../js/js_callback.h"
+
+#include "../memory/shared_ptr.h"
 
 namespace snuffbox
 {
 	/**
 	* @class snuffbox::CVar
 	* @brief A class to register CVars with and to parse the command line for CVars
+	* @remarks CVars are also loaded from layered config files relative to the source directory, 'config/engine.cfg', 'config/game.cfg' and 'config/user.cfg',
+	* where later layers override earlier ones and the command line overrides all of them. Lines are in the form 'name = value', lines starting with '#' are comments.
+	* CVars from the user config are persistent, changing a persistent CVar writes it back to the user config
 	* @author Danil Konings
 	*/
   class CVar : public JSObject
@@ -74,8 +82,29 @@ namespace snuffbox
 			template<typename T>
 			T* As();
 
+			/**
+			* @return bool Is this value referenced by a snuffbox::CVarRef? Its type can't change if so
+			*/
+			bool bound() const;
+
+			/// Marks this value as referenced by a snuffbox::CVarRef
+			void set_bound();
+
+			/**
+			* @return bool Is this value written back to the user config when it changes?
+			*/
+			bool persistent() const;
+
+			/**
+			* @brief Sets if this value should be written back to the user config when it changes
+			* @param[in] persistent (const bool&) The boolean value
+			*/
+			void set_persistent(const bool& persistent);
+
 		private:
 			ValueTypes type_; //!< The type of this value
+			bool bound_; //!< Is this value referenced by a snuffbox::CVarRef?
+			bool persistent_; //!< Is this value written back to the user config?
 		};
 
 		class Boolean : public Value
@@ -159,6 +188,23 @@ namespace snuffbox
 			std::string value_; //!< The string value
 		};
 
+		/**
+		* @brief A function called when a CVar changes, receives the name and the new value of the CVar
+		*/
+		typedef std::function<void(const std::string&, Value*)> ChangeCallback;
+
+		/**
+		* @struct snuffbox::CVar::Listener
+		* @brief A change callback registered for a single CVar
+		* @author Danil Konings
+		*/
+		struct Listener
+		{
+			unsigned int id; //!< The ID to remove the listener with
+			std::string name; //!< The name of the CVar to listen to
+			ChangeCallback callback; //!< The function to call
+		};
+
 		/// Default constructor
 		CVar();
 
@@ -194,11 +240,35 @@ namespace snuffbox
 
 		/**
 		* @brief Maps a CVar to its corresponding map index
+		* @remarks If the CVar already exists with the same type, the existing value is updated in place so references to it stay valid
 		* @param[in] name (const std::string&) The name of the CVar
-		* @param[in] val (snuffbox::CVar::Value*) The CVar value to map
+		* @param[in] val (snuffbox::CVar::Value*) The CVar value to map, ownership is taken
 		*/
 		void Map(const std::string& name, Value* val);
 
+		/**
+		* @brief Finds a CVar for a snuffbox::CVarRef, registering it with a default if it doesn't exist or has a different type
+		* @param[in] name (const std::string&) The name of the CVar
+		* @param[in] def (const T&) The default value
+		* @return const T* A pointer to the value, which stays valid for as long as the CVar system exists
+		*/
+		template<typename T>
+		const T* Bind(const std::string& name, const T& def);
+
+		/**
+		* @brief Adds a callback that is called whenever a CVar is registered or changed
+		* @param[in] name (const std::string&) The name of the CVar, it doesn't have to exist yet
+		* @param[in] callback (const snuffbox::CVar::ChangeCallback&) The callback
+		* @return unsigned int The ID to remove the callback with
+		*/
+		unsigned int Listen(const std::string& name, const ChangeCallback& callback);
+
+		/**
+		* @brief Removes a change callback
+		* @param[in] id (const unsigned int&) The ID returned by CVar::Listen
+		*/
+		void Unlisten(const unsigned int& id);
+
 		/**
 		* @brief Retrieves a CVar from the registered CVars
 		* @param[in] name (const std::string&) The name of the CVar to retrieve
@@ -231,9 +301,66 @@ namespace snuffbox
     /// Logs all currently registered CVars
     void LogCVars();
 
+		/// Loads every config layer, should be called after the command line has been parsed
+		void LoadConfig();
+
+		/// Adds the existing config files to the file watch, so edits are applied while running
+		void WatchConfig();
+
+		/// Loads every config layer again, called when a config file was edited
+		void ReloadConfig();
+
+		/**
+		* @brief Makes a CVar persistent or not, persistent CVars are written back to the user config when they change
+		* @param[in] name (const std::string&) The name of the CVar
+		* @param[in] persistent (const bool&) Should the CVar be persistent?
+		*/
+		void SetPersistent(const std::string& name, const bool& persistent);
+
+		/// Writes the persistent CVars to the user config if any of them changed, should be called once per frame
+		void Update();
+
+		/**
+		* @brief Converts a CVar value to text, as it would be written in a config file
+		* @param[in] value (snuffbox::CVar::Value*) The value to convert
+		* @return std::string The converted value
+		*/
+		static std::string ValueToString(Value* value);
+
 	private:
+		/**
+		* @brief Registers a CVar from text, as a number, a boolean or a string
+		* @param[in] name (const std::string&) The name of the CVar
+		* @param[in] value (const std::string&) The text, text in double quotes is always registered as a string
+		*/
+		void RegisterFromString(const std::string& name, const std::string& value);
+
+		/**
+		* @brief Loads a single config file, CVars set on the command line are skipped
+		* @param[in] path (const std::string&) The path relative to the source directory
+		* @param[in] persistent (const bool&) Should the loaded CVars be persistent?
+		* @return bool Did the file exist?
+		*/
+		bool LoadConfigFile(const std::string& path, const bool& persistent);
+
+		/// Writes the persistent CVars to the user config, keeping its comments and the order of its lines
+		void WriteConfig();
+
+		/**
+		* @brief Calls the change callbacks of a CVar
+		* @param[in] name (const std::string&) The name of the CVar
+		* @param[in] value (snuffbox::CVar::Value*) The new value
+		*/
+		void Changed(const std::string& name, Value* value);
+
 		typedef std::map<std::string, CVar::Value*> CVarMap;
 		CVarMap vars_; //!< The variables 
+		std::vector<Listener> listeners_; //!< The change callbacks
+		unsigned int next_listener_; //!< The ID of the next change callback
+		std::map<std::string, SharedPtr<JSCallback<std::string>>> js_listeners_; //!< The JavaScript change callbacks, one per CVar
+		std::set<std::string> command_line_; //!< The CVars set on the command line, which the config files don't override
+		bool loading_; //!< Are the config files being loaded? Changes don't mark the user config dirty while loading
+		bool dirty_; //!< Has a persistent CVar changed since the user config was written?
 
 		/** 
 		* @brief Skip the whitespaces of a string, incrementing the current index
@@ -265,6 +392,76 @@ namespace snuffbox
 		static void JSExists(JS_ARGS args);
 		static void JSGet(JS_ARGS args);
 		static void JSLog(JS_ARGS args);
+		static void JSOnChange(JS_ARGS args);
+		static void JSSetPersistent(JS_ARGS args);
+	};
+
+	/**
+	* @struct snuffbox::CVarTraits<T>
+	* @brief Maps a C++ type to the CVar value class that stores it
+	* @author Danil Konings
+	*/
+	template<typename T>
+	struct CVarTraits;
+
+	template<>
+	struct CVarTraits<bool>
+	{
+		typedef CVar::Boolean Type;
+		static const CVar::ValueTypes kType = CVar::ValueTypes::kBoolean;
+	};
+
+	template<>
+	struct CVarTraits<double>
+	{
+		typedef CVar::Number Type;
+		static const CVar::ValueTypes kType = CVar::ValueTypes::kNumber;
+	};
+
+	template<>
+	struct CVarTraits<std::string>
+	{
+		typedef CVar::String Type;
+		static const CVar::ValueTypes kType = CVar::ValueTypes::kString;
+	};
+
+	/**
+	* @class snuffbox::CVarRef<T>
+	* @brief A typed handle to a CVar that looks the CVar up once, reading it is a single pointer dereference
+	* @remarks Supported types are bool, double and std::string. The CVar is registered with the default value if it doesn't exist yet, or if it has a different type.
+	* The handle has to be destroyed before the CVar system is
+	* @author Danil Konings
+	*/
+	template<typename T>
+	class CVarRef
+	{
+	public:
+		/**
+		* @brief Construct by name and default value
+		* @param[in] name (const std::string&) The name of the CVar
+		* @param[in] def (const T&) The value to register the CVar with if it doesn't exist yet
+		*/
+		CVarRef(const std::string& name, const T& def);
+
+		/**
+		* @return const T& The current value of the CVar
+		*/
+		const T& get() const;
+
+		/**
+		* @brief Sets the value of the CVar, calling its change callbacks
+		* @param[in] value (const T&) The value to set
+		*/
+		void Set(const T& value);
+
+		/**
+		* @return const std::string& The name of the CVar
+		*/
+		const std::string& name() const;
+
+	private:
+		std::string name_; //!< The name of the CVar
+		const T* value_; //!< The value of the CVar
 	};
 
 	//---------------------------------------------------------------------------------------------------------
@@ -273,4 +470,57 @@ namespace snuffbox
 	{
 		return dynamic_cast<T*>(this);
 	}
+
+	//---------------------------------------------------------------------------------------------------------
+	template<typename T>
+	inline const T* CVar::Bind(const std::string& name, const T& def)
+	{
+		CVarMap::iterator it = vars_.find(name);
+
+		if (it == vars_.end() || it->second->type() != CVarTraits<T>::kType)
+		{
+			if (it != vars_.end())
+			{
+				SNUFF_LOG_WARNING("CVar '" + name + "' has a different type than expected, it is reset to its default value");
+			}
+
+			Register(name, def);
+			it = vars_.find(name);
+
+			SNUFF_XASSERT(it->second->type() == CVarTraits<T>::kType, "CVar '" + name + "' is already bound with a different type", "CVar::Bind");
+		}
+
+		it->second->set_bound();
+		return &static_cast<typename CVarTraits<T>::Type*>(it->second)->value();
+	}
+
+	//---------------------------------------------------------------------------------------------------------
+	template<typename T>
+	inline CVarRef<T>::CVarRef(const std::string& name, const T& def) :
+		name_(name),
+		value_(CVar::Instance()->Bind<T>(name, def))
+	{
+
+	}
+
+	//---------------------------------------------------------------------------------------------------------
+	template<typename T>
+	inline const T& CVarRef<T>::get() const
+	{
+		return *value_;
+	}
+
+	//---------------------------------------------------------------------------------------------------------
+	template<typename T>
+	inline void CVarRef<T>::Set(const T& value)
+	{
+		CVar::Instance()->Register(name_, value);
+	}
+
+	//---------------------------------------------------------------------------------------------------------
+	template<typename T>
+	inline const std::string& CVarRef<T>::name() const
+	{
+		return name_;
+	}
 }
\ No newline at end of file
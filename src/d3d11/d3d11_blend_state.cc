@@ -140,6 +140,7 @@ namespace snuffbox
     {
       render_device->set_current_blend_state(this);
       render_device->context()->OMSetBlendState(blend_state_, NULL, 0x000000FF);
+      render_device->RecordStateChange();
     }
   }
 
@@ -213,7 +213,7 @@ namespace snuffbox
 	//---------------------------------------------------------------------------------------------------------
 	D3D11Camera::~D3D11Camera()
 	{
-
+		D3D11RenderDevice::Instance()->RemoveCamera(this);
 	}
 
 	//---------------------------------------------------------------------------------------------------------
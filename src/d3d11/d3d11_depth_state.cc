@@ -162,6 +162,7 @@ namespace snuffbox
     {
       render_device->set_current_depth_state(this);
       render_device->context()->OMSetDepthStencilState(depth_state_, 1);
+      render_device->RecordStateChange();
     }
 	}
 
@@ -191,6 +191,34 @@ namespace snuffbox
 		return 0;
 	}
 
+	//---------------------------------------------------------------------------------------------------------
+	bool D3D11Effect::Blended(const std::string& tech)
+	{
+		std::map<std::string, Technique>::iterator it = techniques_.find(tech);
+
+		if (it == techniques_.end())
+		{
+			return true;
+		}
+
+		for (const Pass& pass : it->second.passes)
+		{
+			if (pass.blend_state == nullptr)
+			{
+				return true;
+			}
+
+			const D3D11_BLEND_DESC& desc = pass.blend_state->description();
+
+			if (desc.AlphaToCoverageEnable == TRUE || desc.RenderTarget[0].BlendEnable == TRUE)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
 	//---------------------------------------------------------------------------------------------------------
 	D3D11SamplerState::SamplerTypes D3D11Effect::StringToSampling(const std::string& str)
 	{
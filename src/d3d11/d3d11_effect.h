@@ -62,6 +62,13 @@ namespace snuffbox
 		*/
 		unsigned int NumPasses(const std::string& tech);
 
+		/**
+		* @brief Checks if any pass of a technique blends with what was drawn before it, passes without a blend state use the blending default
+		* @param[in] tech (const std::string&) The technique to check for
+		* @return bool Does the technique blend? True if the technique does not exist, as nothing is known about it
+		*/
+		bool Blended(const std::string& tech);
+
 		/**
 		* @brief Converts a string to a sampling type
 		* @param[in] str (const std::string&) The string to convert
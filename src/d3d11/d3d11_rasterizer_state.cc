@@ -116,6 +116,7 @@ namespace snuffbox
 			render_device->set_current_rasterizer_state(this);
 			ID3D11DeviceContext* ctx = render_device->context();
 			ctx->RSSetState(rasterizer_);
+			render_device->RecordStateChange();
 		}
 	}
 
@@ -17,8 +17,10 @@
 #include "../d3d11/d3d11_material.h"
 #include "../d3d11/d3d11_line.h"
 #include "../d3d11/d3d11_uniforms.h"
+#include "../d3d11/d3d11_render_queue.h"
 
 #include "../application/game.h"
+#include "../application/cpu_profiler.h"
 #include "../platform/platform_window.h"
 
 #include "../cvar/cvar.h"
@@ -35,6 +37,7 @@
 #include "../d3d11/shaders/d3d11_post_processing_diffuse_shader.h"
 
 #include <comdef.h>
+#include <algorithm>
 
 #undef max
 
@@ -56,7 +59,9 @@ namespace snuffbox
 		current_model_(nullptr),
 		current_blend_state_(nullptr),
 		current_depth_state_(nullptr),
-		current_rasterizer_state_(nullptr)
+		current_rasterizer_state_(nullptr),
+		submitting_packet_(false),
+		headless_(false)
 	{
 
 	}
@@ -78,6 +83,29 @@ namespace snuffbox
   //-------------------------------------------------------------------------------------------
   bool D3D11RenderDevice::Initialise()
   {
+		CVar* cvar = CVar::Instance();
+		bool found = false;
+
+		CVar::Value* headless = cvar->Get("headless", &found);
+		headless_ = found == true && headless->IsBool() == true && headless->As<CVar::Boolean>()->value() == true;
+
+		CVar::Value* record = cvar->Get("record_draws", &found);
+		if (found == true && record->IsString() == true)
+		{
+			record_path_ = record->As<CVar::String>()->value();
+			record_.open(Game::Instance()->path() + "/" + record_path_, std::ios::binary | std::ios::trunc);
+
+			if (!record_)
+			{
+				SNUFF_LOG_ERROR("Could not open '" + record_path_ + "' to record the draw submissions to");
+				record_path_.clear();
+			}
+			else
+			{
+				record_ << "frame,draw_calls,indices,state_changes\n";
+			}
+		}
+
     CreateDevice();
     CreateBackBuffer();
     CreateScreenQuad();
@@ -141,6 +169,30 @@ namespace snuffbox
   //-------------------------------------------------------------------------------------------
 	void D3D11RenderDevice::CreateDevice()
 	{
+		HRESULT result = S_OK;
+
+		D3D_FEATURE_LEVEL feature_levels_requested[] =
+		{
+			D3D_FEATURE_LEVEL_10_0,
+			D3D_FEATURE_LEVEL_9_3,
+			D3D_FEATURE_LEVEL_9_2,
+			D3D_FEATURE_LEVEL_9_1,
+		};
+		D3D_FEATURE_LEVEL feature_levels_supported;
+
+		UINT device_flags = 0;
+
+#ifdef _DEBUG
+		device_flags |= D3D11_CREATE_DEVICE_DEBUG;
+#endif
+
+		// Headless runs have no window to create a swap chain for
+		if (headless_ == true)
+		{
+			CreateHeadlessDevice(feature_levels_requested, device_flags);
+			return;
+		}
+
 		DXGI_SWAP_CHAIN_DESC desc;
 		ZeroMemory(&swap_chain_, sizeof(IDXGISwapChain));
 		ZeroMemory(&desc, sizeof(DXGI_SWAP_CHAIN_DESC));
@@ -162,23 +214,6 @@ namespace snuffbox
 		desc.BufferDesc.Scaling = DXGI_MODE_SCALING_UNSPECIFIED;
 		desc.SwapEffect = DXGI_SWAP_EFFECT_DISCARD;
 
-		HRESULT result = S_OK;
-
-		D3D_FEATURE_LEVEL feature_levels_requested[] =
-		{
-			D3D_FEATURE_LEVEL_10_0,
-			D3D_FEATURE_LEVEL_9_3,
-			D3D_FEATURE_LEVEL_9_2,
-			D3D_FEATURE_LEVEL_9_1,
-		};
-		D3D_FEATURE_LEVEL feature_levels_supported;
-
-		UINT device_flags = 0;
-
-#ifdef _DEBUG
-		device_flags |= D3D11_CREATE_DEVICE_DEBUG;
-#endif
-
 		FindAdapter();
 
 		if (FAILED(result = D3D11CreateDeviceAndSwapChain(
@@ -202,6 +237,34 @@ namespace snuffbox
     context_->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY::D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 	}
 
+	//-------------------------------------------------------------------------------------------
+	void D3D11RenderDevice::CreateHeadlessDevice(D3D_FEATURE_LEVEL* feature_levels, const UINT& device_flags)
+	{
+		D3D_FEATURE_LEVEL feature_levels_supported;
+
+		HRESULT result = D3D11CreateDevice(
+			NULL,
+			D3D_DRIVER_TYPE_NULL,
+			NULL,
+			device_flags,
+			feature_levels,
+			1,
+			D3D11_SDK_VERSION,
+			&device_,
+			&feature_levels_supported,
+			&context_
+			);
+
+		// Never falls back to WARP, which would rasterize every frame on the CPU and skew the timings of a headless run
+		if (FAILED(result))
+		{
+			SNUFF_ASSERT("The Direct3D 11 null driver is unavailable, install the debug layer or build with 'SNUFF_BUILD_NULL' " + HRToString(result, "D3D11CreateDevice"), "D3D11RenderDevice::CreateHeadlessDevice");
+		}
+
+		context_->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY::D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+		SNUFF_LOG_INFO("Running headless on the Direct3D 11 null driver, draw submissions are counted but never presented");
+	}
+
   //-------------------------------------------------------------------------------------------
   void D3D11RenderDevice::CreateBackBuffer()
   {
@@ -289,10 +352,10 @@ namespace snuffbox
     viewport_ = AllocatedMemory::Instance().Construct<D3D11Viewport>();
     
 		const XMFLOAT2& resolution = D3D11RenderSettings::Instance()->resolution();
-		Window* window = Game::Instance()->window();
+		XMFLOAT2 size = output_size();
 		viewport_->SetToAspectRatio(
-			static_cast<float>(window->width()), 
-			static_cast<float>(window->height()), 
+			size.x, 
+			size.y, 
 			resolution.x, 
 			resolution.y);
 
@@ -300,8 +363,8 @@ namespace snuffbox
     viewport_render_target_->Create(
       0,
       0,
-      static_cast<float>(window->width()),
-      static_cast<float>(window->height())
+      size.x,
+      size.y
       );
   }
 
@@ -425,11 +488,11 @@ namespace snuffbox
 		HRESULT result = S_OK;
 
 		D3D11_TEXTURE2D_DESC tex_desc;
-		DXGI_SWAP_CHAIN_DESC sc_desc;
-		swap_chain_->GetDesc(&sc_desc);
+		D3D11_TEXTURE2D_DESC bb_desc;
+		back_buffer_->GetDescription(&bb_desc);
 
-		tex_desc.Width = sc_desc.BufferDesc.Width;
-		tex_desc.Height = sc_desc.BufferDesc.Height;
+		tex_desc.Width = bb_desc.Width;
+		tex_desc.Height = bb_desc.Height;
 		tex_desc.MipLevels = 1;
 		tex_desc.ArraySize = 1;
     tex_desc.Format = DXGI_FORMAT_R32_TYPELESS;
@@ -524,11 +587,22 @@ namespace snuffbox
   //-------------------------------------------------------------------------------------------
 	void D3D11RenderDevice::Draw()
 	{
+		SNUFF_PROFILE_SCOPE("D3D11RenderDevice::Draw");
+
     if (input_layout_ == nullptr)
     {
       return;
     }
 
+		if (D3D11RenderSettings::Instance()->pipelined() == true)
+		{
+			DrawPipelined();
+			return;
+		}
+
+		WaitForPacket();
+		pending_commands_.clear();
+
     D3D11RenderTarget* it = nullptr;
     for (unsigned int i = 0; i < commands_.size(); ++i)
     {
@@ -540,12 +614,132 @@ namespace snuffbox
       context_->PSSetShaderResources(0, 8, null_resource);
     }
 
-		swap_chain_->Present(D3D11RenderSettings::Instance()->vsync(), 0);
+		Present();
 
 		camera_ = nullptr;
     commands_.clear();
 	}
 
+	//-------------------------------------------------------------------------------------------
+	void D3D11RenderDevice::DrawPipelined()
+	{
+		SNUFF_PROFILE_SCOPE("D3D11RenderDevice::DrawPipelined");
+
+		WaitForPacket();
+
+		ID3D11ShaderResourceView *const null_resource[8] = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+		submitting_packet_ = true;
+
+		for (unsigned int i = 0; i < pending_commands_.size(); ++i)
+		{
+			RenderCommand& command = pending_commands_.at(i);
+			camera_ = command.camera;
+			DrawRenderTarget(command.target);
+			context_->PSSetShaderResources(0, 8, null_resource);
+		}
+
+		submitting_packet_ = false;
+		Present();
+
+		JobSystem* job_system = JobSystem::Instance();
+		std::vector<D3D11RenderQueue*> captured;
+		D3D11RenderQueue* queue = nullptr;
+
+		for (unsigned int i = 0; i < commands_.size(); ++i)
+		{
+			RenderCommand& command = commands_.at(i);
+
+			if (command.target == nullptr || command.camera == nullptr)
+			{
+				continue;
+			}
+
+			queue = command.target->queue();
+
+			if (std::find(captured.begin(), captured.end(), queue) != captured.end())
+			{
+				continue;
+			}
+
+			camera_ = command.camera;
+			queue->Capture(command.camera);
+			captured.push_back(queue);
+		}
+
+		for (unsigned int i = 0; i < captured.size(); ++i)
+		{
+			job_system->Run(&D3D11RenderQueue::PrepareJob, captured.at(i), 0, 0, &packet_counter_);
+		}
+
+		pending_commands_ = commands_;
+
+		camera_ = nullptr;
+		commands_.clear();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void D3D11RenderDevice::Present()
+	{
+		if (swap_chain_ != nullptr)
+		{
+			swap_chain_->Present(D3D11RenderSettings::Instance()->vsync(), 0);
+		}
+
+		if (record_path_.empty() == false)
+		{
+			record_ << draw_stats_.frames << "," << draw_stats_.frame_draw_calls << "," << draw_stats_.frame_indices << "," << draw_stats_.frame_state_changes << "\n";
+		}
+
+		++draw_stats_.frames;
+		draw_stats_.frame_draw_calls = 0;
+		draw_stats_.frame_indices = 0;
+		draw_stats_.frame_state_changes = 0;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void D3D11RenderDevice::RecordDraw(const int& indices)
+	{
+		++draw_stats_.draw_calls;
+		++draw_stats_.frame_draw_calls;
+		draw_stats_.indices += indices;
+		draw_stats_.frame_indices += indices;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void D3D11RenderDevice::RecordStateChange()
+	{
+		++draw_stats_.state_changes;
+		++draw_stats_.frame_state_changes;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void D3D11RenderDevice::WaitForPacket()
+	{
+		SNUFF_PROFILE_SCOPE("D3D11RenderDevice::WaitForPacket");
+
+		JobSystem::Instance()->Wait(&packet_counter_);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void D3D11RenderDevice::RemoveCamera(D3D11Camera* camera)
+	{
+		for (int i = static_cast<int>(pending_commands_.size()) - 1; i >= 0; --i)
+		{
+			if (pending_commands_.at(i).camera == camera)
+			{
+				pending_commands_.erase(pending_commands_.begin() + i);
+			}
+		}
+
+		for (int i = static_cast<int>(commands_.size()) - 1; i >= 0; --i)
+		{
+			if (commands_.at(i).camera == camera)
+			{
+				commands_.erase(commands_.begin() + i);
+			}
+		}
+	}
+
   //-------------------------------------------------------------------------------------------
   void D3D11RenderDevice::DrawRenderTarget(D3D11RenderTarget* target)
   {
@@ -662,8 +856,11 @@ namespace snuffbox
     depth_stencil_buffer_->Release();
     depth_stencil_resource_->Release();
 
-		HRESULT result = swap_chain_->ResizeBuffers(1, 0, 0, DXGI_FORMAT_R8G8B8A8_UNORM, DXGI_SWAP_CHAIN_FLAG_ALLOW_MODE_SWITCH);
-		SNUFF_XASSERT(result == S_OK, HRToString(result, "ResizeBuffers"), "D3D11RenderDevice::ResizeBuffers");
+		if (swap_chain_ != nullptr)
+		{
+			HRESULT result = swap_chain_->ResizeBuffers(1, 0, 0, DXGI_FORMAT_R8G8B8A8_UNORM, DXGI_SWAP_CHAIN_FLAG_ALLOW_MODE_SWITCH);
+			SNUFF_XASSERT(result == S_OK, HRToString(result, "ResizeBuffers"), "D3D11RenderDevice::ResizeBuffers");
+		}
 
 		CreateBackBuffer();
 		CreateDepthStencilView();
@@ -684,10 +881,31 @@ namespace snuffbox
   //-------------------------------------------------------------------------------------------
 	void D3D11RenderDevice::Dispose()
 	{
-    swap_chain_->SetFullscreenState(FALSE, NULL);
+		WaitForPacket();
+		pending_commands_.clear();
+
+		if (record_path_.empty() == false)
+		{
+			record_.close();
+
+			if (record_.fail() == false)
+			{
+				SNUFF_LOG_SUCCESS("Wrote the draw submissions of " + std::to_string(draw_stats_.frames) + " frames to '" + record_path_ + "'");
+			}
+			else
+			{
+				SNUFF_LOG_ERROR("Could not write the recorded draw submissions to '" + record_path_ + "'");
+			}
+		}
+
+		if (headless_ == false)
+		{
+			swap_chain_->SetFullscreenState(FALSE, NULL);
+
+			SNUFF_SAFE_RELEASE(adapter_, "D3D11RenderDevice::Dispose::adapter_");
+			SNUFF_SAFE_RELEASE(swap_chain_, "D3D11RenderDevice::Dispose::swap_chain_");
+		}
 
-		SNUFF_SAFE_RELEASE(adapter_, "D3D11RenderDevice::Dispose::adapter_");
-		SNUFF_SAFE_RELEASE(swap_chain_, "D3D11RenderDevice::Dispose::swap_chain_");
 		SNUFF_SAFE_RELEASE(device_, "D3D11RenderDevice::Dispose::device_");
 		SNUFF_SAFE_RELEASE(context_, "D3D11RenderDevice::Dispose::context_");
 		SNUFF_SAFE_RELEASE(depth_stencil_view_, "D3D11RenderDevice::Dispose::depth_stencil_view_");
@@ -748,6 +966,16 @@ namespace snuffbox
   //-------------------------------------------------------------------------------------------
   void D3D11RenderDevice::RemoveTarget(D3D11RenderTarget* target)
   {
+    WaitForPacket();
+
+    for (int i = static_cast<int>(pending_commands_.size()) - 1; i >= 0; --i)
+    {
+      if (pending_commands_.at(i).target == target)
+      {
+        pending_commands_.erase(pending_commands_.begin() + i);
+      }
+    }
+
     for (unsigned int i = 0; i < render_targets_.size(); ++i)
     {
       if (render_targets_.at(i) == target)
@@ -820,6 +1048,11 @@ namespace snuffbox
   //-------------------------------------------------------------------------------------------
   void D3D11RenderDevice::SetFullscreen(const bool& fullscreen)
   {
+    if (swap_chain_ == nullptr)
+    {
+      return;
+    }
+
     swap_chain_->SetFullscreenState(fullscreen, NULL);
   }
 
@@ -907,6 +1140,37 @@ namespace snuffbox
 		return current_target_;
 	}
 
+	//-------------------------------------------------------------------------------------------
+	const bool& D3D11RenderDevice::submitting_packet() const
+	{
+		return submitting_packet_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	const bool& D3D11RenderDevice::headless() const
+	{
+		return headless_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	const D3D11RenderDevice::DrawStats& D3D11RenderDevice::draw_stats() const
+	{
+		return draw_stats_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	XMFLOAT2 D3D11RenderDevice::output_size() const
+	{
+		Window* window = Game::Instance()->window();
+
+		if (window == nullptr)
+		{
+			return D3D11RenderSettings::Instance()->resolution();
+		}
+
+		return XMFLOAT2(static_cast<float>(window->width()), static_cast<float>(window->height()));
+	}
+
   //-------------------------------------------------------------------------------------------
   D3D11Texture* D3D11RenderDevice::default_texture()
   {
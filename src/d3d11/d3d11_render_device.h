@@ -12,9 +12,11 @@ using namespace DirectX;
 
 #include <string>
 #include <vector>
+#include <fstream>
 
 #include "../platform/platform_render_device_base.h"
 #include "../memory/shared_ptr.h"
+#include "../application/job_system.h"
 
 #define SNUFF_SAFE_RELEASE(ptr, ctx) SNUFF_ASSERT_NOTNULL(ptr, ctx) ptr->Release(); ptr = nullptr;
 
@@ -56,6 +58,25 @@ namespace snuffbox
       D3D11RenderTarget* target = nullptr;
     };
 
+		/**
+		* @struct D3D11RenderDevice::DrawStats
+		* @brief The draw submissions counted by the device, in total and for the last presented frame
+		* @author Danil Konings
+		*/
+		struct DrawStats
+		{
+			/// Default constructor
+			DrawStats() : frames(0), draw_calls(0), indices(0), state_changes(0), frame_draw_calls(0), frame_indices(0), frame_state_changes(0){}
+
+			int frames; //!< The number of presented frames
+			int draw_calls; //!< The total number of draw calls
+			int indices; //!< The total number of drawn indices
+			int state_changes; //!< The total number of pipeline state changes, shaders, textures, blend, depth and rasterizer states and vertex buffers
+			int frame_draw_calls; //!< The number of draw calls of the last frame
+			int frame_indices; //!< The number of drawn indices of the last frame
+			int frame_state_changes; //!< The number of pipeline state changes of the last frame
+		};
+
 	public:
 		/// Default constructor
 		D3D11RenderDevice();
@@ -80,6 +101,13 @@ namespace snuffbox
 		/// Creates the device
 		void CreateDevice();
 
+		/**
+		* @brief Creates a device without a swap chain using the null driver, asserts if the null driver is not installed
+		* @param[in] feature_levels (D3D_FEATURE_LEVEL*) The requested feature levels
+		* @param[in] device_flags (const UINT&) The creation flags
+		*/
+		void CreateHeadlessDevice(D3D_FEATURE_LEVEL* feature_levels, const UINT& device_flags);
+
     /// Creates the backbuffer
     void CreateBackBuffer();
 
@@ -116,6 +144,33 @@ namespace snuffbox
 		/// @see snuffbox::IRenderDeviceBase::Draw
 		void Draw();
 
+		/**
+		* @brief Draws the frame packet captured last frame, then captures the commands of this frame and prepares them on a worker
+		* @remarks The packet of frame N is prepared while frame N + 1 is simulated, which adds one frame of latency
+		*/
+		void DrawPipelined();
+
+		/// Waits until the preparation of the current frame packet has finished, must be called before modifying a render queue
+		void WaitForPacket();
+
+		/**
+		* @brief Removes every pending command that uses a given camera
+		* @param[in] camera (snuffbox::D3D11Camera*) The camera that is being destroyed
+		*/
+		void RemoveCamera(D3D11Camera* camera);
+
+		/// Presents the back buffer, or only finishes the frame's draw statistics when running headless
+		void Present();
+
+		/**
+		* @brief Records a draw submission
+		* @param[in] indices (const int&) The number of indices drawn
+		*/
+		void RecordDraw(const int& indices);
+
+		/// Records a pipeline state change that was actually sent to the context, redundant changes that were filtered out are not counted
+		void RecordStateChange();
+
     /**
     * @brief Draws a given render target
     * @param[in] target (snuffbox::D3D11RenderTarget*) The render target to draw
@@ -234,6 +289,26 @@ namespace snuffbox
 		*/
 		D3D11RenderTarget* current_target();
 
+		/**
+		* @return const bool& Are the render queues drawing their frame packets instead of their elements?
+		*/
+		const bool& submitting_packet() const;
+
+		/**
+		* @return const bool& Is the device running without a window or swap chain?
+		*/
+		const bool& headless() const;
+
+		/**
+		* @return const snuffbox::D3D11RenderDevice::DrawStats& The draw submissions counted by this device
+		*/
+		const DrawStats& draw_stats() const;
+
+		/**
+		* @return XMFLOAT2 The size of the back buffer, the window size or the render resolution when running headless without a window
+		*/
+		XMFLOAT2 output_size() const;
+
     /**
     * @return snuffbox::D3D11Texture* The default texture
     */
@@ -350,6 +425,13 @@ namespace snuffbox
 		SharedPtr<D3D11RenderTarget> back_buffer_; //!< The backbuffer of this render device
 		std::vector<D3D11RenderTarget*> render_targets_; //!< The map of render targets
     std::vector<RenderCommand> commands_; //!< The commands for drawing
+		std::vector<RenderCommand> pending_commands_; //!< The commands captured in the frame packet of the last frame
+		JobSystem::Counter packet_counter_; //!< The counter of the jobs preparing the frame packet
+		bool submitting_packet_; //!< Are the render queues drawing their frame packets?
+		bool headless_; //!< Is the device running without a window or swap chain?
+		DrawStats draw_stats_; //!< The draw submissions counted by this device
+		std::string record_path_; //!< The path to write the recorded draw submissions to, empty if not recording
+		std::ofstream record_; //!< The file the draw submissions are streamed to, one line per frame
 		D3D11RenderTarget* current_target_; //!< The current target being rendered
 
     SharedPtr<D3D11VertexBuffer> screen_quad_; //!< The vertex buffer of the screen quad
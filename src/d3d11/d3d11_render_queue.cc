@@ -5,46 +5,25 @@
 #include "../d3d11/d3d11_camera.h"
 #include "../d3d11/d3d11_effect.h"
 #include "../d3d11/d3d11_material.h"
+#include "../d3d11/d3d11_texture.h"
 #include "../d3d11/d3d11_render_target.h"
 #include "../d3d11/d3d11_uniforms.h"
 #include "../d3d11/elements/d3d11_text_element.h"
 #include "../d3d11/elements/d3d11_model_element.h"
 #include "../application/game.h"
+#include "../application/cpu_profiler.h"
 #include "../fbx/fbx_loader.h"
 
 #include <algorithm>
+#include <cstring>
 
 namespace snuffbox
 {
-  //-------------------------------------------------------------------------------------------
-  bool RenderSorterZ::operator()(D3D11RenderElement* a, D3D11RenderElement* b)
-  {
-    return a == nullptr || b == nullptr ? false : XMVectorGetZ(a->translation()) > XMVectorGetZ(b->translation());
-  }
-
-  //-------------------------------------------------------------------------------------------
-  bool RenderSorterDistance::operator()(D3D11RenderElement* a, D3D11RenderElement* b)
-  {
-    D3D11Camera* camera = D3D11RenderDevice::Instance()->camera();
-    XMVECTOR v1 = a->translation() - camera->translation();
-    XMVECTOR v2 = b->translation() - camera->translation();
-
-    float x1 = XMVectorGetX(v1);
-    float y1 = XMVectorGetY(v1);
-    float z1 = XMVectorGetZ(v1);
-    float d1 = std::sqrt(x1 * x1 + y1 * y1 + z1 * z1);
-
-    float x2 = XMVectorGetX(v2);
-    float y2 = XMVectorGetY(v2);
-    float z2 = XMVectorGetZ(v2);
-    float d2 = std::sqrt(x2 * x2 + y2 * y2 + z2 * z2);
-
-    return d1 < d2;
-  }
-
   //-------------------------------------------------------------------------------------------
   D3D11RenderQueue::D3D11RenderQueue(D3D11RenderTarget* target) :
-    target_(target)
+    target_(target),
+    packet_sorting_(SortMethods::kZSorting),
+    packet_camera_(0.0f, 0.0f, 0.0f)
   {
 
   }
@@ -68,18 +47,155 @@ namespace snuffbox
   //-------------------------------------------------------------------------------------------
   void D3D11RenderQueue::Sort(const D3D11RenderQueue::SortMethods& method)
   {
-    switch (method)
+    XMVECTOR camera = D3D11RenderDevice::Instance()->camera()->translation();
+
+    D3D11RenderElement* element = nullptr;
+    D3D11Material* material = nullptr;
+    D3D11Effect* effect = nullptr;
+    XMVECTOR translation;
+    bool translucent = false;
+
+    for (int i = 0; i < 2; ++i)
     {
-    case SortMethods::kZSorting:
-      std::sort(world_.begin(), world_.end(), RenderSorterZ());
-      break;
+      std::vector<D3D11RenderElement*>& elements = i == 0 ? world_ : ui_;
+      bool distance = i == 0 && method == SortMethods::kDistanceFromCamera;
+
+      if (target_ != nullptr)
+      {
+        elements.erase(std::remove_if(elements.begin(), elements.end(), [this, i](D3D11RenderElement* it)
+        {
+          return it == nullptr || it->spawned() == false || (i == 0 && it->target() != target_);
+        }), elements.end());
+      }
+
+      keys_.resize(elements.size());
+
+      for (unsigned int j = 0; j < elements.size(); ++j)
+      {
+        element = elements.at(j);
+        SortKey& key = keys_.at(j);
+        key.index = j;
+
+        if (element == nullptr)
+        {
+          key.key = 0;
+          continue;
+        }
+
+        D3D11RenderElement::MaterialGroup& m_group = element->material_group();
+        material = m_group.material != nullptr && m_group.material->is_valid() == true ? m_group.material : nullptr;
+        effect = m_group.override_effect != nullptr ? m_group.override_effect : (material != nullptr ? material->effect() : nullptr);
+
+        // Orthographic scenes and the UI are drawn in painter's order, only perspective scenes can rely on the depth buffer for opaque elements
+        // Elements are only grouped by state when their effect is known not to blend, anything else keeps its back to front order
+        translucent = distance == false || effect == nullptr || effect->Blended(element->technique()) == true ||
+          element->alpha() < 1.0f || (material != nullptr && material->attributes().diffuse.w < 1.0f);
+        translation = element->translation();
 
-    case SortMethods::kDistanceFromCamera:
-      std::sort(world_.begin(), world_.end(), RenderSorterDistance());
-      break;
+        key.key = PackKey(element->layer_type(), translucent, effect, material, distance == true ?
+          XMVectorGetX(XMVector3LengthSq(translation - camera)) :
+          -XMVectorGetZ(translation));
+      }
+
+      RadixSort(&keys_, &scratch_);
+
+      sorted_.resize(elements.size());
+      for (unsigned int j = 0; j < keys_.size(); ++j)
+      {
+        sorted_.at(j) = elements.at(keys_.at(j).index);
+      }
+
+      elements.swap(sorted_);
     }
+  }
+
+  //-------------------------------------------------------------------------------------------
+  uint64_t D3D11RenderQueue::PackKey(const D3D11RenderElement::LayerType& layer, const bool& translucent, D3D11Effect* effect, D3D11Material* material, const float& depth)
+  {
+    // Maps the depth to an unsigned integer with the same ordering, of which the upper 30 bits are kept
+    uint32_t bits = 0;
+    memcpy(&bits, &depth, sizeof(float));
+    bits = (bits & 0x80000000u) != 0 ? ~bits : bits | 0x80000000u;
+
+    uint64_t quantised = bits >> 2;
+
+    // A collision only merges two state groups, it never changes the order of translucent elements
+    auto fold = [](const void* ptr)
+    {
+      uint64_t value = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)) >> 4;
+      return (value ^ (value >> 16) ^ (value >> 32)) & 0xFFFFull;
+    };
 
-    std::sort(ui_.begin(), ui_.end(), RenderSorterZ());
+    uint64_t key = layer == D3D11RenderElement::LayerType::kWorld ? 0ull : 1ull << 63;
+
+    if (translucent == false)
+    {
+      return key | fold(effect) << 46 | fold(material) << 30 | quantised;
+    }
+
+    return key | 1ull << 62 | (~quantised & 0x3FFFFFFFull) << 32 | fold(effect) << 16 | fold(material);
+  }
+
+  //-------------------------------------------------------------------------------------------
+  void D3D11RenderQueue::RadixSort(std::vector<SortKey>* keys, std::vector<SortKey>* scratch)
+  {
+    size_t count = keys->size();
+
+    if (count < 2)
+    {
+      return;
+    }
+
+    scratch->resize(count);
+
+    unsigned int histograms[8][256] = {};
+    uint64_t key = 0;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      key = keys->at(i).key;
+
+      for (int b = 0; b < 8; ++b)
+      {
+        ++histograms[b][(key >> (b * 8)) & 0xFF];
+      }
+    }
+
+    SortKey* from = keys->data();
+    SortKey* to = scratch->data();
+    unsigned int offset = 0;
+    unsigned int size = 0;
+
+    for (int b = 0; b < 8; ++b)
+    {
+      int shift = b * 8;
+      unsigned int* histogram = histograms[b];
+
+      if (histogram[(from[0].key >> shift) & 0xFF] == count)
+      {
+        continue;
+      }
+
+      offset = 0;
+      for (int d = 0; d < 256; ++d)
+      {
+        size = histogram[d];
+        histogram[d] = offset;
+        offset += size;
+      }
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        to[histogram[(from[i].key >> shift) & 0xFF]++] = from[i];
+      }
+
+      std::swap(from, to);
+    }
+
+    if (from != keys->data())
+    {
+      keys->swap(*scratch);
+    }
   }
 
   //-------------------------------------------------------------------------------------------
@@ -109,6 +225,14 @@ namespace snuffbox
       material == nullptr || material->is_valid() == false ? attributes : material->attributes()
     });
 
+    Submit(context, element, m_group);
+  }
+
+  //-------------------------------------------------------------------------------------------
+  void D3D11RenderQueue::Submit(ID3D11DeviceContext* context, D3D11RenderElement* element, D3D11RenderElement::MaterialGroup& m_group)
+  {
+    D3D11Material* material = m_group.material;
+
     element->uniforms()->Apply();
 
     D3D11VertexBuffer* buffer = element->vertex_buffer();
@@ -183,11 +307,21 @@ namespace snuffbox
   //-------------------------------------------------------------------------------------------
   void D3D11RenderQueue::Draw(ID3D11DeviceContext* context)
   {
+    SNUFF_PROFILE_SCOPE("D3D11RenderQueue::Draw");
+
+    if (D3D11RenderDevice::Instance()->submitting_packet() == true)
+    {
+      DrawPacket(context);
+      return;
+    }
+
+    removed_.clear();
+
     Sort(D3D11RenderDevice::Instance()->camera()->type() == D3D11Camera::CameraTypes::kPerspective ?
       SortMethods::kDistanceFromCamera : SortMethods::kZSorting);
     D3D11RenderElement* element = nullptr;
 
-    for (int i = static_cast<int>(world_.size()) - 1; i >= 0; --i)
+    for (unsigned int i = 0; i < world_.size(); ++i)
     {
       element = world_.at(i);
 
@@ -195,20 +329,16 @@ namespace snuffbox
       {
         DrawElement(context, element);
       }
-      else if (target_ != nullptr)
-      {
-        world_.erase(world_.begin() + i);
-      }
     }
 
     D3D11RenderDevice* render_device = D3D11RenderDevice::Instance();
     render_device->MapUIBuffer();
 
-    for (int i = static_cast<int>(ui_.size()) - 1; i >= 0; --i)
+    for (unsigned int i = 0; i < ui_.size(); ++i)
     {
       element = ui_.at(i);
 
-      if (element->spawned() == true)
+      if (element != nullptr && element->spawned() == true)
       {
         D3D11Text* text = dynamic_cast<D3D11Text*>(element);
 
@@ -232,9 +362,238 @@ namespace snuffbox
           text->DrawIcons();
         }
       }
-      else if (target_ != nullptr)
+    }
+  }
+
+  //-------------------------------------------------------------------------------------------
+  void D3D11RenderQueue::Capture(D3D11Camera* camera)
+  {
+    SNUFF_PROFILE_SCOPE("D3D11RenderQueue::Capture");
+
+    world_packet_.clear();
+    ui_packet_.clear();
+    removed_.clear();
+
+    packet_sorting_ = camera->type() == D3D11Camera::CameraTypes::kPerspective ? SortMethods::kDistanceFromCamera : SortMethods::kZSorting;
+    XMStoreFloat3(&packet_camera_, camera->translation());
+
+    D3D11Material::Attributes attributes;
+    D3D11RenderElement* element = nullptr;
+    Animation* animation = nullptr;
+    D3D11Material* material = nullptr;
+    D3D11Text* text = nullptr;
+    Snapshot snapshot;
+
+    auto valid = [](Content* content)
+    {
+      return content != nullptr && content->is_valid() == true;
+    };
+
+    auto capture = [&](std::vector<Snapshot>& packet, const bool& shadow)
+    {
+      // Unloaded content is freed at the end of the next frame, while this packet is drawn after that, so it may not reference any
+      D3D11RenderElement::MaterialGroup& group = snapshot.material_group;
+      group = element->material_group();
+      group.material = valid(group.material) == true ? group.material : nullptr;
+      group.override_diffuse = valid(group.override_diffuse) == true ? group.override_diffuse : nullptr;
+      group.override_normal = valid(group.override_normal) == true ? group.override_normal : nullptr;
+      group.override_specular = valid(group.override_specular) == true ? group.override_specular : nullptr;
+      group.override_light = valid(group.override_light) == true ? group.override_light : nullptr;
+      group.override_effect = valid(group.override_effect) == true ? group.override_effect : nullptr;
+
+      material = group.material;
+
+      snapshot.element = element;
+      XMStoreFloat3(&snapshot.translation, element->translation());
+      XMStoreFloat4x4(&snapshot.world, element->world_matrix());
+      snapshot.animation_coordinates = element->animation_coordinates();
+      snapshot.blend = element->blend();
+      snapshot.alpha = element->alpha();
+      snapshot.attributes = material == nullptr ? attributes : material->attributes();
+      snapshot.billboarding = element->billboarding();
+      snapshot.shadow = shadow;
+      snapshot.effect = group.override_effect != nullptr ? group.override_effect :
+        (material != nullptr && valid(material->effect()) == true ? material->effect() : nullptr);
+      snapshot.blended = snapshot.effect == nullptr || snapshot.effect->Blended(element->technique()) == true;
+      snapshot.key = 0;
+
+      packet.push_back(snapshot);
+    };
+
+    for (int i = 0; i < 2; ++i)
+    {
+      std::vector<D3D11RenderElement*>& elements = i == 0 ? world_ : ui_;
+      std::vector<Snapshot>& packet = i == 0 ? world_packet_ : ui_packet_;
+
+      for (int j = static_cast<int>(elements.size()) - 1; j >= 0; --j)
+      {
+        element = elements.at(j);
+
+        if (element == nullptr || element->spawned() == false || (i == 0 && element->target() != target_))
+        {
+          if (target_ != nullptr)
+          {
+            elements.erase(elements.begin() + j);
+          }
+          continue;
+        }
+
+        animation = element->animation();
+
+        if (animation != nullptr)
+        {
+          animation->Animate(static_cast<float>(Game::Instance()->delta_time()));
+        }
+
+        text = i == 1 ? dynamic_cast<D3D11Text*>(element) : nullptr;
+
+        // The keys of the shadow and the text are equal and the sort is stable, so the shadow stays in front of the text
+        if (text != nullptr && text->shadow_set() == true)
+        {
+          XMFLOAT3 blend = text->blend();
+          float alpha = text->alpha();
+
+          text->PrepareShadow();
+          capture(packet, true);
+          text->Reset(blend, alpha);
+        }
+
+        capture(packet, false);
+      }
+    }
+  }
+
+  //-------------------------------------------------------------------------------------------
+  void D3D11RenderQueue::Prepare()
+  {
+    SNUFF_PROFILE_SCOPE("D3D11RenderQueue::Prepare");
+
+    XMVECTOR deter;
+    XMMATRIX world;
+    XMVECTOR translation;
+    XMVECTOR camera = XMLoadFloat3(&packet_camera_);
+    bool translucent = false;
+
+    for (int i = 0; i < 2; ++i)
+    {
+      std::vector<Snapshot>& packet = i == 0 ? world_packet_ : ui_packet_;
+      bool distance = i == 0 && packet_sorting_ == SortMethods::kDistanceFromCamera;
+      D3D11RenderElement::LayerType layer = i == 0 ? D3D11RenderElement::LayerType::kWorld : D3D11RenderElement::LayerType::kUI;
+
+      packet_keys_.resize(packet.size());
+
+      for (unsigned int j = 0; j < packet.size(); ++j)
+      {
+        Snapshot& snapshot = packet.at(j);
+        world = XMLoadFloat4x4(&snapshot.world);
+
+        XMStoreFloat4x4(&snapshot.inv_world, snapshot.billboarding == true ? XMMatrixInverse(&deter, world) : XMMatrixTranspose(XMMatrixInverse(&deter, world)));
+
+        // Keyed exactly like the element lists of the immediate path
+        translucent = distance == false || snapshot.blended == true || snapshot.alpha < 1.0f || snapshot.attributes.diffuse.w < 1.0f;
+        translation = XMLoadFloat3(&snapshot.translation);
+        snapshot.key = PackKey(layer, translucent, snapshot.effect, snapshot.material_group.material, distance == true ?
+          XMVectorGetX(XMVector3LengthSq(translation - camera)) :
+          -XMVectorGetZ(translation));
+
+        packet_keys_.at(j).key = snapshot.key;
+        packet_keys_.at(j).index = j;
+      }
+
+      RadixSort(&packet_keys_, &packet_scratch_);
+
+      sorted_packet_.resize(packet.size());
+      for (unsigned int j = 0; j < packet_keys_.size(); ++j)
+      {
+        sorted_packet_.at(j) = packet.at(packet_keys_.at(j).index);
+      }
+
+      packet.swap(sorted_packet_);
+    }
+  }
+
+  //-------------------------------------------------------------------------------------------
+  void D3D11RenderQueue::PrepareJob(void* data, const int& start, const int& end)
+  {
+    static_cast<D3D11RenderQueue*>(data)->Prepare();
+  }
+
+  //-------------------------------------------------------------------------------------------
+  void D3D11RenderQueue::DrawPacket(ID3D11DeviceContext* context)
+  {
+    // The packet is done preparing by now, so the elements removed while it was can be taken out safely
+    if (removed_.empty() == false)
+    {
+      std::sort(removed_.begin(), removed_.end());
+
+      for (int i = 0; i < 2; ++i)
+      {
+        std::vector<Snapshot>& packet = i == 0 ? world_packet_ : ui_packet_;
+
+        for (unsigned int j = 0; j < packet.size(); ++j)
+        {
+          Snapshot& snapshot = packet.at(j);
+
+          if (snapshot.element != nullptr && std::binary_search(removed_.begin(), removed_.end(), snapshot.element) == true)
+          {
+            snapshot.element = nullptr;
+          }
+        }
+      }
+
+      removed_.clear();
+    }
+
+    D3D11RenderDevice* render_device = D3D11RenderDevice::Instance();
+    D3D11ConstantBuffer* constant_buffer = render_device->constant_buffer();
+
+    auto map = [constant_buffer](const Snapshot& snapshot)
+    {
+      constant_buffer->Map({
+        XMLoadFloat4x4(&snapshot.world),
+        XMLoadFloat4x4(&snapshot.inv_world),
+        snapshot.animation_coordinates,
+        snapshot.blend,
+        snapshot.alpha,
+        snapshot.attributes
+      });
+    };
+
+    for (unsigned int i = 0; i < world_packet_.size(); ++i)
+    {
+      Snapshot& snapshot = world_packet_.at(i);
+
+      if (snapshot.element != nullptr)
+      {
+        map(snapshot);
+        Submit(context, snapshot.element, snapshot.material_group);
+      }
+    }
+
+    render_device->MapUIBuffer();
+
+    D3D11RenderElement* element = nullptr;
+    for (unsigned int i = 0; i < ui_packet_.size(); ++i)
+    {
+      Snapshot& snapshot = ui_packet_.at(i);
+      element = snapshot.element;
+
+      if (element == nullptr)
       {
-        ui_.erase(ui_.begin() + i);
+        continue;
+      }
+
+      map(snapshot);
+      Submit(context, element, snapshot.material_group);
+
+      if (snapshot.shadow == false)
+      {
+        D3D11Text* text = dynamic_cast<D3D11Text*>(element);
+
+        if (text != nullptr)
+        {
+          text->DrawIcons();
+        }
       }
     }
   }
@@ -287,10 +646,22 @@ namespace snuffbox
   //-------------------------------------------------------------------------------------------
   void D3D11RenderQueue::Clear()
   {
+    D3D11RenderDevice::Instance()->WaitForPacket();
+    world_packet_.clear();
+    ui_packet_.clear();
+    removed_.clear();
+
+    // Swapped out first, so that every element removing itself from this queue doesn't search the full lists
+    std::vector<D3D11RenderElement*> world;
+    std::vector<D3D11RenderElement*> ui;
+
+    world.swap(world_);
+    ui.swap(ui_);
+
     D3D11RenderElement* it = nullptr;
-    for (unsigned int i = 0; i < world_.size(); ++i)
+    for (unsigned int i = 0; i < world.size(); ++i)
     {
-      it = world_.at(i);
+      it = world.at(i);
 
       if (it != nullptr)
       {
@@ -298,23 +669,22 @@ namespace snuffbox
       }
     }
 
-    for (unsigned int i = 0; i < ui_.size(); ++i)
+    for (unsigned int i = 0; i < ui.size(); ++i)
     {
-      it = ui_.at(i);
+      it = ui.at(i);
 
       if (it != nullptr)
       {
         it->Destroy();
       }
     }
-
-    world_.clear();
-    ui_.clear();
   }
 
   //-------------------------------------------------------------------------------------------
   void D3D11RenderQueue::Remove(D3D11RenderElement* ptr)
   {
+    removed_.push_back(ptr);
+
     D3D11RenderElement* it = nullptr;
     for (unsigned int i = 0; i < world_.size(); ++i)
     {
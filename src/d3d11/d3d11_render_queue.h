@@ -2,20 +2,12 @@
 
 #include "../d3d11/d3d11_render_device.h"
 #include "../d3d11/elements/d3d11_render_element.h"
+#include "../d3d11/d3d11_material.h"
 #include <vector>
+#include <cstdint>
 
 namespace snuffbox
 {
-	struct RenderSorterZ
-	{
-		bool operator()(D3D11RenderElement* a, D3D11RenderElement* b);
-	};
-
-	struct RenderSorterDistance
-	{
-		bool operator()(D3D11RenderElement* a, D3D11RenderElement* b);
-	};
-
   /**
   * @class snuffbox::D3D11RenderQueue
   * @brief Handles all sorting of render elements, also used to draw elements in the queue
@@ -35,6 +27,43 @@ namespace snuffbox
       kDistanceFromCamera
     };
 
+    /**
+    * @struct snuffbox::D3D11RenderQueue::SortKey
+    * @brief A packed sort key and the index of the element it was built for
+    * @remarks From the most to the least significant bit: layer (1), translucency (1), then for opaque elements the effect (16), material (16) and depth (30),
+    * for translucent elements the inverted depth (30), effect (16) and material (16). Ascending keys are in draw order, opaque elements are grouped by state
+    * and drawn front to back, translucent elements are drawn back to front after them
+    * @author Danil Konings
+    */
+    struct SortKey
+    {
+      uint64_t key; //!< The packed key
+      unsigned int index; //!< The index of the element in the list that is being sorted
+    };
+
+    /**
+    * @struct snuffbox::D3D11RenderQueue::Snapshot
+    * @brief The render-relevant state of an element captured at the end of a frame, so that it can be drawn while the next frame is simulated
+    * @author Danil Konings
+    */
+    struct Snapshot
+    {
+      D3D11RenderElement* element; //!< The element, set to nullptr when the element is removed before the packet is drawn
+      XMFLOAT3 translation; //!< The translation of the element, the sort keys are calculated from it
+      XMFLOAT4X4 world; //!< The world matrix
+      XMFLOAT4X4 inv_world; //!< The inverse world matrix, calculated while preparing
+      XMFLOAT4 animation_coordinates; //!< The animation coordinates
+      XMFLOAT3 blend; //!< The blend colour
+      float alpha; //!< The alpha value
+      D3D11Material::Attributes attributes; //!< The material attributes
+      D3D11RenderElement::MaterialGroup material_group; //!< The material bindings
+      D3D11Effect* effect; //!< The effect the element is drawn with, resolved while capturing
+      bool blended; //!< Does the effect blend with what was drawn before it? Resolved while capturing, as the effect can't be read while preparing
+      bool billboarding; //!< Is billboarding enabled?
+      bool shadow; //!< Is this the shadow of a text element? Captured as its own snapshot directly before the text
+      uint64_t key; //!< The sort key, calculated while preparing
+    };
+
   public:
     /**
 		* @brief Constructs this queue with a given render target
@@ -52,11 +81,29 @@ namespace snuffbox
     void Add(D3D11RenderElement* element);
 
     /**
-    * @brief Sorts the render elements
-    * @param[in] method (const snuffbox::D3D11RenderQueue::SortMethods&) The method to sort with
+    * @brief Removes the elements that can no longer be drawn and sorts the remaining render elements
+    * @param[in] method (const snuffbox::D3D11RenderQueue::SortMethods&) The method to sort the world elements with
     */
     void Sort(const SortMethods& method);
 
+    /**
+    * @brief Packs the sort key of an element
+    * @param[in] layer (const snuffbox::D3D11RenderElement::LayerType&) The layer of the element
+    * @param[in] translucent (const bool&) Should the element be drawn back to front instead of grouped by state?
+    * @param[in] effect (snuffbox::D3D11Effect*) The effect the element is drawn with
+    * @param[in] material (snuffbox::D3D11Material*) The material the element is drawn with
+    * @param[in] depth (const float&) The depth of the element, larger values are further away from the viewer
+    * @return uint64_t The packed key
+    */
+    static uint64_t PackKey(const D3D11RenderElement::LayerType& layer, const bool& translucent, D3D11Effect* effect, D3D11Material* material, const float& depth);
+
+    /**
+    * @brief Sorts keys ascending with a stable least significant digit radix sort, passes over a byte that is equal in every key are skipped
+    * @param[in] keys (std::vector<snuffbox::D3D11RenderQueue::SortKey>*) The keys to sort
+    * @param[in] scratch (std::vector<snuffbox::D3D11RenderQueue::SortKey>*) A buffer to sort into, resized to the number of keys
+    */
+    static void RadixSort(std::vector<SortKey>* keys, std::vector<SortKey>* scratch);
+
     /**
     * @brief Draws an element to the current render target
     * @param[in] element (snuffbox::D3D11RenderElement*) The element to draw
@@ -70,6 +117,37 @@ namespace snuffbox
     */
     void Draw(ID3D11DeviceContext* context);
 
+    /**
+    * @brief Captures the state of every element in the queue into the frame packet, should be called on the main thread
+    * @param[in] camera (snuffbox::D3D11Camera*) The camera the packet will be drawn with
+    */
+    void Capture(D3D11Camera* camera);
+
+    /// Calculates the inverse world matrices and sort keys of the frame packet and sorts it, safe to run on a worker
+    void Prepare();
+
+    /**
+    * @brief Prepares the frame packet of a queue as a job
+    * @param[in] data (void*) The snuffbox::D3D11RenderQueue to prepare
+    * @param[in] start (const int&) Unused
+    * @param[in] end (const int&) Unused
+    */
+    static void PrepareJob(void* data, const int& start, const int& end);
+
+    /**
+    * @brief Draws the prepared frame packet to the current render target
+    * @param[in] context (ID3D11DeviceContext*) The context to draw with
+    */
+    void DrawPacket(ID3D11DeviceContext* context);
+
+    /**
+    * @brief Draws an element with its per-object constants already mapped
+    * @param[in] context (ID3D11DeviceContext*) The context to draw with
+    * @param[in] element (snuffbox::D3D11RenderElement*) The element to draw
+    * @param[in] m_group (snuffbox::D3D11RenderElement::MaterialGroup&) The material group to draw with
+    */
+    void Submit(ID3D11DeviceContext* context, D3D11RenderElement* element, D3D11RenderElement::MaterialGroup& m_group);
+
     /**
     * @brief Renders the buffer with the given materials and given offset
     * @param[in] m_group (snuffbox::D3D11RenderElement::MaterialGroup&) The material group to render
@@ -85,6 +163,7 @@ namespace snuffbox
 
     /**
     * @brief Removes a render element from the queue
+    * @remarks The frame packet may still be prepared on a worker, so the element is only taken out of it right before the packet is drawn
     * @param[in] ptr (snuffbox::D3D11RenderElement*) The element to remove
     */
     void Remove(D3D11RenderElement* ptr);
@@ -99,5 +178,16 @@ namespace snuffbox
     std::vector<D3D11RenderElement*> world_; //!< A list of world elements to sort and / or draw
 		std::vector<D3D11RenderElement*> ui_; //!< A list of UI elements to sort and / or draw
 		D3D11RenderTarget* target_; //!< The owner of this render queue
+		std::vector<Snapshot> world_packet_; //!< The captured world elements of the last frame
+		std::vector<Snapshot> ui_packet_; //!< The captured UI elements of the last frame
+		SortMethods packet_sorting_; //!< The sort method of the world packet
+		XMFLOAT3 packet_camera_; //!< The camera translation of the world packet
+		std::vector<SortKey> keys_; //!< The sort keys of the element lists
+		std::vector<SortKey> scratch_; //!< The scratch buffer of the radix sort of the element lists
+		std::vector<D3D11RenderElement*> sorted_; //!< The element list being sorted into
+		std::vector<SortKey> packet_keys_; //!< The sort keys of the frame packet, separate as the packet can be prepared on a worker
+		std::vector<SortKey> packet_scratch_; //!< The scratch buffer of the radix sort of the frame packet
+		std::vector<Snapshot> sorted_packet_; //!< The frame packet being sorted into
+		std::vector<D3D11RenderElement*> removed_; //!< The elements removed since the frame packet was captured, purged from it before it is drawn
   };
 }
\ No newline at end of file
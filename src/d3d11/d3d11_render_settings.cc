@@ -8,7 +8,8 @@ namespace snuffbox
 	D3D11RenderSettings::D3D11RenderSettings() :
 		vsync_(false),
 		resolution_(640.0f, 480.0f),
-		invert_y_(false)
+		invert_y_(false),
+		pipelined_(false)
 	{
 
 	}
@@ -38,6 +39,12 @@ namespace snuffbox
 		return invert_y_;
 	}
 
+	//---------------------------------------------------------------------------------------------------------
+	const bool& D3D11RenderSettings::pipelined() const
+	{
+		return pipelined_;
+	}
+
 	//---------------------------------------------------------------------------------------------------------
 	void D3D11RenderSettings::set_vsync(const bool& vsync)
 	{
@@ -50,8 +57,9 @@ namespace snuffbox
 		resolution_.x = width;
 		resolution_.y = height;
 
-    Window* window = Game::Instance()->window();
-    D3D11RenderDevice::Instance()->ResizeBuffers(window->width(), window->height());
+    D3D11RenderDevice* render_device = D3D11RenderDevice::Instance();
+    XMFLOAT2 size = render_device->output_size();
+    render_device->ResizeBuffers(static_cast<int>(size.x), static_cast<int>(size.y));
 	}
 
 	//---------------------------------------------------------------------------------------------------------
@@ -60,6 +68,12 @@ namespace snuffbox
 		invert_y_ = value;
 	}
 
+	//---------------------------------------------------------------------------------------------------------
+	void D3D11RenderSettings::set_pipelined(const bool& value)
+	{
+		pipelined_ = value;
+	}
+
 	//---------------------------------------------------------------------------------------------------------
 	D3D11RenderSettings::~D3D11RenderSettings()
 	{
@@ -76,6 +90,10 @@ namespace snuffbox
 			{ "resolution", JSResolution },
 			{ "setInvertY", JSSetInvertY },
 			{ "invertY", JSInvertY },
+			{ "setPipelined", JSSetPipelined },
+			{ "pipelined", JSPipelined },
+			{ "headless", JSHeadless },
+			{ "drawStats", JSDrawStats },
       { "setFullscreen", JSSetFullscreen }
 		};
 
@@ -163,6 +181,57 @@ namespace snuffbox
 		wrapper.ReturnValue<bool>(D3D11RenderSettings::Instance()->invert_y());
 	}
 
+	//---------------------------------------------------------------------------------------------------------
+	void D3D11RenderSettings::JSSetPipelined(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+
+		if (wrapper.Check("B") == false)
+		{
+			SNUFF_LOG_WARNING("Unspecified value, defaulting to 'false'");
+		}
+
+		bool v = wrapper.GetValue<bool>(0, false);
+		D3D11RenderSettings::Instance()->set_pipelined(v);
+
+		SNUFF_LOG_INFO("Changed pipelined rendering to " + std::to_string(v));
+	}
+
+	//---------------------------------------------------------------------------------------------------------
+	void D3D11RenderSettings::JSPipelined(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+
+		wrapper.ReturnValue<bool>(D3D11RenderSettings::Instance()->pipelined());
+	}
+
+	//---------------------------------------------------------------------------------------------------------
+	void D3D11RenderSettings::JSHeadless(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+
+		wrapper.ReturnValue<bool>(D3D11RenderDevice::Instance()->headless());
+	}
+
+	//---------------------------------------------------------------------------------------------------------
+	void D3D11RenderSettings::JSDrawStats(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+
+		const D3D11RenderDevice::DrawStats& stats = D3D11RenderDevice::Instance()->draw_stats();
+		v8::Handle<v8::Object> obj = JSWrapper::CreateObject();
+
+		JSWrapper::SetObjectValue<double>(obj, "frames", stats.frames);
+		JSWrapper::SetObjectValue<double>(obj, "drawCalls", stats.draw_calls);
+		JSWrapper::SetObjectValue<double>(obj, "indices", stats.indices);
+		JSWrapper::SetObjectValue<double>(obj, "stateChanges", stats.state_changes);
+		JSWrapper::SetObjectValue<double>(obj, "frameDrawCalls", stats.frame_draw_calls);
+		JSWrapper::SetObjectValue<double>(obj, "frameIndices", stats.frame_indices);
+		JSWrapper::SetObjectValue<double>(obj, "frameStateChanges", stats.frame_state_changes);
+
+		wrapper.ReturnValue<v8::Handle<v8::Object>>(obj);
+	}
+
   //---------------------------------------------------------------------------------------------------------
   void D3D11RenderSettings::JSSetFullscreen(JS_ARGS args)
   {
@@ -32,6 +32,11 @@ namespace snuffbox
 		*/
 		const XMFLOAT2& resolution() const;
 
+		/**
+		* @return const bool& Is render preparation pipelined with the simulation of the next frame?
+		*/
+		const bool& pipelined() const;
+
 		/**
 		* @brief Sets if vsync is enabled or not
 		* @param[in] vsync (const bool&) The boolean value
@@ -51,6 +56,12 @@ namespace snuffbox
 		*/
 		void set_invert_y(const bool& value);
 
+		/**
+		* @brief Sets if render preparation should be pipelined with the simulation of the next frame, which adds a frame of latency
+		* @param[in] value (const bool&) The boolean value
+		*/
+		void set_pipelined(const bool& value);
+
 		/// Default destructor
 		~D3D11RenderSettings();
 
@@ -58,6 +69,7 @@ namespace snuffbox
 		bool vsync_; //!< Is vertical sync enabled?
 		XMFLOAT2 resolution_; //!< The resolution of the renderer
 		bool invert_y_; //!< Should the Y-axis be inverted? Mainly for 2D rendering
+		bool pipelined_; //!< Is render preparation pipelined with the simulation of the next frame?
 
 	public:
     JS_NAME("RenderSettings");
@@ -68,6 +80,10 @@ namespace snuffbox
 		static void JSResolution(JS_ARGS args);
 		static void JSSetInvertY(JS_ARGS args);
 		static void JSInvertY(JS_ARGS args);
+		static void JSSetPipelined(JS_ARGS args);
+		static void JSPipelined(JS_ARGS args);
+		static void JSHeadless(JS_ARGS args);
+		static void JSDrawStats(JS_ARGS args);
     static void JSSetFullscreen(JS_ARGS args);
 	};
 }
\ No newline at end of file
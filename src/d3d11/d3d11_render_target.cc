@@ -10,6 +10,8 @@
 #include "../content/content_manager.h"
 
 #include "../application/logging.h"
+#include "../application/game.h"
+#include "../platform/platform_window.h"
 
 namespace snuffbox
 {
@@ -84,9 +86,35 @@ namespace snuffbox
 		if (type == RenderTargets::kBackBuffer)
 		{
 			name_ = "Backbuffer";
-			result = swap_chain->GetBuffer(0, __uuidof(ID3D11Texture2D), reinterpret_cast<LPVOID*>(&buffer_));
 
-			SNUFF_XASSERT(result == S_OK, render_device->HRToString(result, "GetBuffer"), "D3D11RenderTarget::Create");
+			if (swap_chain != nullptr)
+			{
+				result = swap_chain->GetBuffer(0, __uuidof(ID3D11Texture2D), reinterpret_cast<LPVOID*>(&buffer_));
+
+				SNUFF_XASSERT(result == S_OK, render_device->HRToString(result, "GetBuffer"), "D3D11RenderTarget::Create");
+			}
+			else
+			{
+				// Headless devices have no swap chain, so the back buffer is an offscreen texture of the render resolution
+				XMFLOAT2 size = render_device->output_size();
+
+				D3D11_TEXTURE2D_DESC desc;
+				ZeroMemory(&desc, sizeof(D3D11_TEXTURE2D_DESC));
+
+				desc.Width = static_cast<UINT>(size.x);
+				desc.Height = static_cast<UINT>(size.y);
+				desc.MipLevels = 1;
+				desc.ArraySize = 1;
+				desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+				desc.SampleDesc.Count = 1;
+				desc.SampleDesc.Quality = 0;
+				desc.Usage = D3D11_USAGE_DEFAULT;
+				desc.BindFlags = D3D11_BIND_RENDER_TARGET;
+
+				result = device->CreateTexture2D(&desc, NULL, &buffer_);
+
+				SNUFF_XASSERT(result == S_OK, render_device->HRToString(result, "CreateTexture2D"), "D3D11RenderTarget::Create");
+			}
 
 			result = device->CreateRenderTargetView(buffer_, NULL, &view_);
 
@@ -147,6 +175,8 @@ namespace snuffbox
 			result = device->CreateRenderTargetView(buffer_, NULL, &view_);
 
 			SNUFF_XASSERT(result == S_OK, render_device->HRToString(result, "CreateRenderTargetView"), "D3D11RenderTarget::Create");
+
+			ReportMemory(sizeof(D3D11RenderTarget) + desc.Width * desc.Height * 4);
 		}
 		else
 		{
@@ -91,6 +91,7 @@ namespace snuffbox
 			ctx->VSSetShader(vs_, NULL, 0);
 			ctx->PSSetShader(ps_, NULL, 0);
 			render_device->set_current_shader(this);
+			render_device->RecordStateChange();
 		}
   }
 
@@ -252,6 +252,7 @@ namespace snuffbox
 		{
 			render_device->context()->PSSetShaderResources(slot, 1, &texture_);
 			textures[slot] = this;
+			render_device->RecordStateChange();
 		}
 	}
 
@@ -281,6 +282,7 @@ namespace snuffbox
     if (set == true || force_set == true)
     {
       render_device->context()->PSSetShaderResources(start, num, resources);
+      render_device->RecordStateChange();
     }
 	}
 
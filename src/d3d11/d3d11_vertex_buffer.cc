@@ -2,6 +2,8 @@
 #include "../d3d11/d3d11_shader.h"
 #include "../d3d11/d3d11_render_settings.h"
 
+#include <algorithm>
+
 namespace snuffbox
 {
   //-------------------------------------------------------------------------------------------
@@ -9,6 +11,7 @@ namespace snuffbox
     type_(type),
     vertex_buffer_(nullptr),
     index_buffer_(nullptr),
+		usage_(D3D11_USAGE_DYNAMIC),
     vertex_size_(0),
     index_size_(0),
 		num_indices_(-1),
@@ -19,7 +22,7 @@ namespace snuffbox
   }
 
   //-------------------------------------------------------------------------------------------
-	void D3D11VertexBuffer::Create(const std::vector<Vertex>& verts, const std::vector<int>& indices, const bool& tangents)
+	void D3D11VertexBuffer::Create(const std::vector<Vertex>& verts, const std::vector<int>& indices, const bool& tangents, const D3D11_USAGE& usage)
   {
     if (valid_ == true)
     {
@@ -47,10 +50,12 @@ namespace snuffbox
     D3D11_BUFFER_DESC desc;
     ZeroMemory(&desc, sizeof(D3D11_BUFFER_DESC));
 
-		desc.Usage = D3D11_USAGE_DYNAMIC;
+		usage_ = usage == D3D11_USAGE_DEFAULT ? D3D11_USAGE_DEFAULT : D3D11_USAGE_DYNAMIC;
+
+		desc.Usage = usage_;
     desc.ByteWidth = static_cast<UINT>(sizeof(Vertex) * vertices_.size());
     desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-		desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+		desc.CPUAccessFlags = usage_ == D3D11_USAGE_DYNAMIC ? D3D11_CPU_ACCESS_WRITE : 0;
     desc.MiscFlags = 0;
 
     D3D11_SUBRESOURCE_DATA input;
@@ -107,18 +112,10 @@ namespace snuffbox
 		vertices_ = verts;
 		indices_ = indices;
 
-		Vertex* v = nullptr;
-
 		D3D11_MAPPED_SUBRESOURCE data;
 		ID3D11DeviceContext* ctx = D3D11RenderDevice::Instance()->context();
 
-		ctx->Map(vertex_buffer_, 0, D3D11_MAP_WRITE_DISCARD, 0, &data);
-		v = static_cast<Vertex*>(data.pData);
-		for (unsigned int i = 0; i < vertex_size_; ++i)
-		{
-			v[i] = vertices_.at(i);
-		}
-		ctx->Unmap(vertex_buffer_, 0);
+		UploadVertices();
 		
 		int* idx = nullptr;
 
@@ -133,6 +130,100 @@ namespace snuffbox
     CalculateBounds();
 	}
 
+	//-------------------------------------------------------------------------------------------
+	void D3D11VertexBuffer::UpdateRange(const std::vector<Vertex>& verts, const unsigned int& first, const unsigned int& count)
+	{
+		if (valid_ == false)
+		{
+			SNUFF_LOG_WARNING("Attempted to update an invalid vertex buffer");
+			return;
+		}
+
+		if (vertex_size_ != verts.size())
+		{
+			SNUFF_LOG_ERROR("Could not update vertex buffer, the current vertices size is not equal to the one buffered");
+			return;
+		}
+
+		if (first >= vertex_size_ || count == 0)
+		{
+			return;
+		}
+
+		unsigned int last = first + count > vertex_size_ ? vertex_size_ : first + count;
+		std::copy(verts.begin() + first, verts.begin() + last, vertices_.begin() + first);
+
+		if (usage_ == D3D11_USAGE_DYNAMIC)
+		{
+			UploadVertices();
+			ExpandBounds(first, last);
+			return;
+		}
+
+		D3D11_BOX box;
+		box.left = static_cast<UINT>(sizeof(Vertex) * first);
+		box.right = static_cast<UINT>(sizeof(Vertex) * last);
+		box.top = 0;
+		box.bottom = 1;
+		box.front = 0;
+		box.back = 1;
+
+		D3D11RenderDevice::Instance()->context()->UpdateSubresource(vertex_buffer_, 0, &box, &vertices_[first], 0, 0);
+
+		ExpandBounds(first, last);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void D3D11VertexBuffer::UploadVertices()
+	{
+		ID3D11DeviceContext* ctx = D3D11RenderDevice::Instance()->context();
+
+		if (usage_ == D3D11_USAGE_DEFAULT)
+		{
+			ctx->UpdateSubresource(vertex_buffer_, 0, nullptr, &vertices_[0], 0, 0);
+			return;
+		}
+
+		D3D11_MAPPED_SUBRESOURCE data;
+		Vertex* v = nullptr;
+
+		ctx->Map(vertex_buffer_, 0, D3D11_MAP_WRITE_DISCARD, 0, &data);
+		v = static_cast<Vertex*>(data.pData);
+		for (unsigned int i = 0; i < vertex_size_; ++i)
+		{
+			v[i] = vertices_.at(i);
+		}
+		ctx->Unmap(vertex_buffer_, 0);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void D3D11VertexBuffer::ExpandBounds(const unsigned int& first, const unsigned int& last)
+	{
+		// The vertical center is stored negated, see D3D11VertexBuffer::CalculateBounds
+		float min_x = bounds_.Center.x - bounds_.Extents.x, max_x = bounds_.Center.x + bounds_.Extents.x;
+		float min_y = -bounds_.Center.y - bounds_.Extents.y, max_y = -bounds_.Center.y + bounds_.Extents.y;
+		float min_z = bounds_.Center.z - bounds_.Extents.z, max_z = bounds_.Center.z + bounds_.Extents.z;
+
+		for (unsigned int i = first; i < last; ++i)
+		{
+			const XMFLOAT4& p = vertices_.at(i).position;
+
+			min_x = std::min(min_x, p.x);
+			max_x = std::max(max_x, p.x);
+			min_y = std::min(min_y, p.y);
+			max_y = std::max(max_y, p.y);
+			min_z = std::min(min_z, p.z);
+			max_z = std::max(max_z, p.z);
+		}
+
+		float x = (max_x - min_x) / 2.0f;
+		float y = (max_y - min_y) / 2.0f;
+		float z = (max_z - min_z) / 2.0f;
+
+		bounds_.Center = XMFLOAT3(min_x + x, (min_y + y) * -1, min_z + z);
+		bounds_.Extents = XMFLOAT3(x, y, z);
+	}
+
   //-------------------------------------------------------------------------------------------
   void D3D11VertexBuffer::CalculateBounds()
   {
@@ -303,6 +394,7 @@ namespace snuffbox
       UINT offset = 0;
       ctx->IASetVertexBuffers(0, 1, &vertex_buffer_, &Vertex::STRIDE_SIZE, &offset);
       ctx->IASetIndexBuffer(index_buffer_, DXGI_FORMAT_R32_UINT, 0);
+      render_device->RecordStateChange();
     }
 
     D3D11_PRIMITIVE_TOPOLOGY topology;
@@ -329,7 +421,10 @@ namespace snuffbox
 			return;
 		}
 		
-    render_device->context()->DrawIndexed(num_indices_ >= 0 ? num_indices_ : static_cast<UINT>(indices_.size()), start, 0);
+    UINT count = num_indices_ >= 0 ? num_indices_ : static_cast<UINT>(indices_.size());
+
+    render_device->context()->DrawIndexed(count, start, 0);
+    render_device->RecordDraw(static_cast<int>(count));
   }
 
   //-------------------------------------------------------------------------------------------
@@ -436,12 +531,24 @@ namespace snuffbox
     return topology_;
   }
 
+  //-------------------------------------------------------------------------------------------
+  const bool& D3D11VertexBuffer::valid() const
+  {
+    return valid_;
+  }
+
   //-------------------------------------------------------------------------------------------
   const BoundingBox& D3D11VertexBuffer::bounds() const
   {
     return bounds_;
   }
 
+  //-------------------------------------------------------------------------------------------
+  size_t D3D11VertexBuffer::size() const
+  {
+    return (sizeof(Vertex) * vertex_size_ + sizeof(int) * index_size_) * 2;
+  }
+
   //-------------------------------------------------------------------------------------------
   void D3D11VertexBuffer::set_topology(const D3D11_PRIMITIVE_TOPOLOGY& topology)
   {
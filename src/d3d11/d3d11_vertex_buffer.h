@@ -86,8 +86,9 @@ namespace snuffbox
     * @param[in] verts (const std::vector<snuffbox::Vertex>&) The vertices to add
     * @param[in] indices (const std::vector<int>&) The indices to add
 		* @param[in] tangents (const bool&) Should tangents be calculated? Default = true
+		* @param[in] usage (const D3D11_USAGE&) The usage of the vertex buffer, dynamic buffers are rewritten as a whole and default buffers can upload ranges efficiently. Default = D3D11_USAGE_DYNAMIC
     */
-		void Create(const std::vector<Vertex>& verts, const std::vector<int>& indices, const bool& tangents = true);
+		void Create(const std::vector<Vertex>& verts, const std::vector<int>& indices, const bool& tangents = true, const D3D11_USAGE& usage = D3D11_USAGE_DYNAMIC);
 
 		/**
 		* @brief Updates the vertex/index buffers without creating a new vertex buffer
@@ -97,6 +98,16 @@ namespace snuffbox
 		*/
 		void Update(const std::vector<Vertex>& verts, const std::vector<int>& indices, const bool& tangents = true);
 
+		/**
+		* @brief Updates a range of vertices without touching the index buffer, only the range is uploaded and the buffered vertices outside of it are kept
+		* @remarks The bounds are only grown to contain the range, use snuffbox::D3D11VertexBuffer::Update to recalculate tight bounds.
+		* Dynamic vertex buffers can't upload a range, they are rewritten as a whole
+		* @param[in] verts (const std::vector<snuffbox::Vertex>&) The vertices to update from, should be the same size as the buffered vertices
+		* @param[in] first (const unsigned int&) The first vertex of the range
+		* @param[in] count (const unsigned int&) The number of vertices in the range
+		*/
+		void UpdateRange(const std::vector<Vertex>& verts, const unsigned int& first, const unsigned int& count);
+
     /// Calculates the bounds of the current vertices
     void CalculateBounds();
 
@@ -132,11 +143,21 @@ namespace snuffbox
     */
     const D3D11_PRIMITIVE_TOPOLOGY& topology() const;
 
+    /**
+    * @return const bool& Was this vertex buffer created and is it ready for use?
+    */
+    const bool& valid() const;
+
     /**
     * @return const BoundingBox& The bounds of the vertices
     */
     const BoundingBox& bounds() const;
 
+    /**
+    * @return size_t The native memory this vertex buffer uses in bytes, both the CPU copies and the GPU buffers
+    */
+    size_t size() const;
+
     /**
     * @brief Sets the primitive topology this vertex buffer uses
     * @param[in] topology (const D3D11_PRIMITIVE_TOPOLOGY&) The topology to use
@@ -149,6 +170,17 @@ namespace snuffbox
 		*/
 		void set_num_indices(const int& n);
 
+  private:
+		/**
+		* @brief Grows the bounds to contain a range of the current vertices
+		* @param[in] first (const unsigned int&) The first vertex of the range
+		* @param[in] last (const unsigned int&) One past the last vertex of the range
+		*/
+		void ExpandBounds(const unsigned int& first, const unsigned int& last);
+
+		/// Uploads every vertex, by discarding the buffer if it is dynamic
+		void UploadVertices();
+
   private:
     std::vector<Vertex> vertices_; //!< The vertices of this vertex buffer
     std::vector<int> indices_; //!< The indices of this vertex buffer
@@ -156,6 +188,7 @@ namespace snuffbox
     D3D11_PRIMITIVE_TOPOLOGY topology_; //!< The tolopogy this vertex buffer uses
     ID3D11Buffer* vertex_buffer_; //!< The actual vertex buffer
     ID3D11Buffer* index_buffer_; //!< The actual index buffer
+		D3D11_USAGE usage_; //!< The usage of the vertex buffer
 		unsigned int vertex_size_; //!< The number of vertices after creation
 		unsigned int index_size_; //!< The number of indices after creation
     bool valid_; //!< Is this vertex buffer valid and ready for use?
@@ -24,6 +24,11 @@ namespace snuffbox
     v.tangent = tangent;
     v.bitangent = bitangent;
 
+    if (vertices_.size() == vertices_.capacity())
+    {
+      vertex_data_.Release();
+    }
+
     vertices_.push_back(v);
   }
 
@@ -61,6 +66,7 @@ namespace snuffbox
   //-------------------------------------------------------------------------------------------
   void D3D11Polygon::ClearVertices()
   {
+    vertex_data_.Release();
     vertices_.clear();
   }
 
@@ -70,9 +76,31 @@ namespace snuffbox
     return static_cast<int>(vertices_.size());
   }
 
+  //-------------------------------------------------------------------------------------------
+  void D3D11Polygon::ResizeVertices(const int& count)
+  {
+    if (count < 0)
+    {
+      SNUFF_LOG_ERROR("Attempted to resize the vertices of a polygon to a negative size");
+      return;
+    }
+
+    if (static_cast<size_t>(count) > vertices_.capacity())
+    {
+      vertex_data_.Release();
+    }
+
+    vertices_.resize(count);
+  }
+
   //-------------------------------------------------------------------------------------------
   void D3D11Polygon::AddIndex(const int& index)
   {
+    if (indices_.size() == indices_.capacity())
+    {
+      index_data_.Release();
+    }
+
     indices_.push_back(index);
   }
 
@@ -105,7 +133,8 @@ namespace snuffbox
   //-------------------------------------------------------------------------------------------
   void D3D11Polygon::ClearIndices()
   {
-    vertices_.clear();
+    index_data_.Release();
+    indices_.clear();
   }
 
   //-------------------------------------------------------------------------------------------
@@ -114,8 +143,25 @@ namespace snuffbox
     return static_cast<int>(indices_.size());
   }
 
+  //-------------------------------------------------------------------------------------------
+  void D3D11Polygon::ResizeIndices(const int& count)
+  {
+    if (count < 0)
+    {
+      SNUFF_LOG_ERROR("Attempted to resize the indices of a polygon to a negative size");
+      return;
+    }
+
+    if (static_cast<size_t>(count) > indices_.capacity())
+    {
+      index_data_.Release();
+    }
+
+    indices_.resize(count, 0);
+  }
+
 	//-------------------------------------------------------------------------------------------
-	void D3D11Polygon::Create(const bool& tangents)
+	void D3D11Polygon::Create(const bool& tangents, const bool& ranged)
 	{
 		if (indices_.size() == 0 || vertices_.size() == 0)
 		{
@@ -123,7 +169,8 @@ namespace snuffbox
 			return;
 		}
 
-		vertex_buffer_->Create(vertices_, indices_, tangents);
+		vertex_buffer_->Create(vertices_, indices_, tangents, ranged == true ? D3D11_USAGE_DEFAULT : D3D11_USAGE_DYNAMIC);
+		ReportMemory(sizeof(D3D11Polygon) + sizeof(Vertex) * vertices_.size() + sizeof(int) * indices_.size() + vertex_buffer_->size());
 	}
 
   //-------------------------------------------------------------------------------------------
@@ -138,6 +185,24 @@ namespace snuffbox
     vertex_buffer_->Update(vertices_, indices_, tangents);
   }
 
+  //-------------------------------------------------------------------------------------------
+  void D3D11Polygon::FlushRange(const int& first, const int& count)
+  {
+    if (vertex_buffer_->valid() == false)
+    {
+      SNUFF_LOG_ERROR("Attempted to flush a range of vertices of a polygon that was never created, call 'create' first");
+      return;
+    }
+
+    if (first < 0 || count < 0 || static_cast<size_t>(first) + count > vertices_.size())
+    {
+      SNUFF_LOG_ERROR("Attempted to flush vertices " + std::to_string(first) + " to " + std::to_string(first + count) + ", this is out of bounds; vertices size is '" + std::to_string(vertices_.size()) + "'");
+      return;
+    }
+
+    vertex_buffer_->UpdateRange(vertices_, first, count);
+  }
+
   //-------------------------------------------------------------------------------------------
   void D3D11Polygon::set_topology(const int& topology)
   {
@@ -158,7 +223,8 @@ namespace snuffbox
   //-------------------------------------------------------------------------------------------
   D3D11Polygon::~D3D11Polygon()
   {
-
+    vertex_data_.Release();
+    index_data_.Release();
   }
 
   //-------------------------------------------------------------------------------------------
@@ -186,6 +252,8 @@ namespace snuffbox
       { "removeIndex", JSRemoveIndex },
       { "clearIndices", JSClearIndices },
       { "numIndices", JSNumIndices },
+      { "vertexData", JSVertexData },
+      { "indexData", JSIndexData },
 			{ "create", JSCreate },
       { "flush", JSFlush },
       { "setTopology", JSSetTopology },
@@ -359,11 +427,63 @@ namespace snuffbox
     wrapper.ReturnValue<int>(self->NumIndices());
   }
 
+  //-------------------------------------------------------------------------------------------
+  void D3D11Polygon::JSVertexData(JS_ARGS args)
+  {
+    JSWrapper wrapper(args);
+    D3D11Polygon* self = wrapper.GetPointer<D3D11Polygon>(args.This());
+
+    if (args.Length() > 0 && wrapper.Check("N") == true)
+    {
+      self->ResizeVertices(wrapper.GetValue<int>(0, 0));
+    }
+
+    std::vector<Vertex>& vertices = self->vertices_;
+    if (vertices.empty() == true)
+    {
+      SNUFF_LOG_WARNING("Attempted to retrieve the vertex data of a polygon without vertices");
+      args.GetReturnValue().Set(v8::Float32Array::New(v8::ArrayBuffer::New(args.GetIsolate(), 0), 0, 0));
+      return;
+    }
+
+    v8::Local<v8::ArrayBuffer> buffer = self->vertex_data_.Get(&vertices[0], sizeof(Vertex) * vertices.size(), args.This());
+    args.GetReturnValue().Set(v8::Float32Array::New(buffer, 0, buffer->ByteLength() / sizeof(float)));
+  }
+
+  //-------------------------------------------------------------------------------------------
+  void D3D11Polygon::JSIndexData(JS_ARGS args)
+  {
+    JSWrapper wrapper(args);
+    D3D11Polygon* self = wrapper.GetPointer<D3D11Polygon>(args.This());
+
+    if (args.Length() > 0 && wrapper.Check("N") == true)
+    {
+      self->ResizeIndices(wrapper.GetValue<int>(0, 0));
+    }
+
+    std::vector<int>& indices = self->indices_;
+    if (indices.empty() == true)
+    {
+      SNUFF_LOG_WARNING("Attempted to retrieve the index data of a polygon without indices");
+      args.GetReturnValue().Set(v8::Int32Array::New(v8::ArrayBuffer::New(args.GetIsolate(), 0), 0, 0));
+      return;
+    }
+
+    v8::Local<v8::ArrayBuffer> buffer = self->index_data_.Get(&indices[0], sizeof(int) * indices.size(), args.This());
+    args.GetReturnValue().Set(v8::Int32Array::New(buffer, 0, indices.size()));
+  }
+
   //-------------------------------------------------------------------------------------------
   void D3D11Polygon::JSFlush(JS_ARGS args)
   {
     JSWrapper wrapper(args);
     D3D11Polygon* self = wrapper.GetPointer<D3D11Polygon>(args.This());
+
+    if (args.Length() >= 2 && wrapper.Check("NN") == true)
+    {
+      self->FlushRange(wrapper.GetValue<int>(0, 0), wrapper.GetValue<int>(1, 0));
+      return;
+    }
      
     self->Flush(wrapper.GetValue<bool>(0, false));
   }
@@ -374,7 +494,7 @@ namespace snuffbox
 		JSWrapper wrapper(args);
 		D3D11Polygon* self = wrapper.GetPointer<D3D11Polygon>(args.This());
 
-		self->Create(wrapper.GetValue<bool>(0, false));
+		self->Create(wrapper.GetValue<bool>(0, false), wrapper.GetValue<bool>(1, false));
 	}
 
   //-------------------------------------------------------------------------------------------
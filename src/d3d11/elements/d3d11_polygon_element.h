@@ -2,6 +2,7 @@
 
 #include "../../d3d11/elements/d3d11_render_element.h"
 #include "../../d3d11/d3d11_vertex_buffer.h"
+#include "../../js/js_external_buffer.h"
 
 namespace snuffbox
 {
@@ -52,6 +53,12 @@ namespace snuffbox
     */
     int NumVertices();
 
+    /**
+    * @brief Resizes the vertex vector, new vertices are default constructed
+    * @param[in] count (const int&) The new number of vertices
+    */
+    void ResizeVertices(const int& count);
+
     /**
     * @brief Adds an index
     * @param[in] index (const int&) The index to add
@@ -79,11 +86,18 @@ namespace snuffbox
     */
     int NumIndices();
 
+    /**
+    * @brief Resizes the index vector, new indices are 0
+    * @param[in] count (const int&) The new number of indices
+    */
+    void ResizeIndices(const int& count);
+
 		/**
 		* @brief Creates the vertex buffer
 		* @param[in] tangents (const bool&) Should tangents be calculated for this polygon? Default = false
+		* @param[in] ranged (const bool&) Will ranges of vertices be flushed? The buffer is then rewritten in place instead of discarded every flush. Default = false
 		*/
-		void Create(const bool& tangents = false);
+		void Create(const bool& tangents = false, const bool& ranged = false);
 
     /**
     * @brief Flushes the vertex buffer
@@ -91,6 +105,14 @@ namespace snuffbox
     */
     void Flush(const bool& tangents = false);
 
+    /**
+    * @brief Flushes a range of vertices to the vertex buffer, the index buffer is left untouched
+    * @remarks Only the range is uploaded if the polygon was created for ranged flushes, otherwise every vertex is
+    * @param[in] first (const int&) The first vertex to flush
+    * @param[in] count (const int&) The number of vertices to flush
+    */
+    void FlushRange(const int& first, const int& count);
+
     /**
     * @brief Sets the primitive topology of this polygon
     * @param[in] topology (const int&) The primitive topology to set
@@ -108,6 +130,8 @@ namespace snuffbox
     std::vector<Vertex> vertices_; //!< The vertices of this polygon
     std::vector<int> indices_; //!< The indices of this polygon
     int topology_; //!< The topology of this polygon element
+    JSExternalBuffer vertex_data_; //!< The buffer aliasing the vertices for scripts
+    JSExternalBuffer index_data_; //!< The buffer aliasing the indices for scripts
 
   public:
     JS_NAME("Polygon");
@@ -122,6 +146,8 @@ namespace snuffbox
     static void JSRemoveIndex(JS_ARGS args);
     static void JSClearIndices(JS_ARGS args);
     static void JSNumIndices(JS_ARGS args);
+    static void JSVertexData(JS_ARGS args);
+    static void JSIndexData(JS_ARGS args);
 		static void JSCreate(JS_ARGS args);
 		static void JSFlush(JS_ARGS args);
     static void JSSetTopology(JS_ARGS args);
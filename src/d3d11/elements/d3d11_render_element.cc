@@ -10,6 +10,7 @@
 #include "../../d3d11/d3d11_scroll_area.h"
 
 #include "../../content/content_manager.h"
+#include "../../application/game.h"
 #include "../../animation/animation_base.h"
 
 namespace snuffbox
@@ -77,7 +78,12 @@ namespace snuffbox
 		blend_changed_(false),
 		target_(nullptr),
     parent_(nullptr),
-    scroll_area_(nullptr)
+    scroll_area_(nullptr),
+    interpolated_(false),
+    previous_translation_(XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f)),
+    previous_rotation_(XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f)),
+    previous_scale_(XMVectorSet(1.0f, 1.0f, 1.0f, 1.0f)),
+    snapshot_step_(0)
   {
     material_group_.material = D3D11RenderDevice::Instance()->default_material();
 		uniforms_ = AllocatedMemory::Instance().Construct<D3D11Uniforms>();
@@ -102,7 +108,12 @@ namespace snuffbox
 		alpha_changed_(false),
 		blend_changed_(false),
 		target_(nullptr),
-    scroll_area_(nullptr)
+    scroll_area_(nullptr),
+    interpolated_(false),
+    previous_translation_(XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f)),
+    previous_rotation_(XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f)),
+    previous_scale_(XMVectorSet(1.0f, 1.0f, 1.0f, 1.0f)),
+    snapshot_step_(0)
 	{
     material_group_.material = D3D11RenderDevice::Instance()->default_material();
 		uniforms_ = AllocatedMemory::Instance().Construct<D3D11Uniforms>();
@@ -153,27 +164,50 @@ namespace snuffbox
   void D3D11RenderElement::Destroy()
   {
     spawned_ = false;
-    target_ = nullptr;
+
+    // Removed right away, as the element can be freed before the queue is sorted or its frame packet is drawn
+    if (target_ != nullptr)
+    {
+      D3D11RenderTarget* target = target_;
+      target_ = nullptr;
+      target->FindAndRemove(this);
+    }
   }
 
   //-------------------------------------------------------------------------------------------
 	void D3D11RenderElement::TranslateBy(const float& x, const float& y, const float& z)
   {
+    Snapshot();
     translation_ += XMVectorSet(x, y, z, 0.0f);
   }
 
   //-------------------------------------------------------------------------------------------
 	void D3D11RenderElement::RotateBy(const float& x, const float& y, const float& z)
   {
+    Snapshot();
     rotation_ += XMVectorSet(x, y, z, 0.0f);
   }
 
 	//-------------------------------------------------------------------------------------------
 	void D3D11RenderElement::CalculateWorldMatrix(XMMATRIX* world, const bool& invert_y)
 	{
-		XMMATRIX trans = XMMatrixTranslationFromVector(translation_);
+		XMVECTOR translation = translation_;
+		XMVECTOR rotation_vector = rotation_;
+		XMVECTOR scale = scale_;
+
+		Game* game = Game::Instance();
+		if (interpolated_ == true && snapshot_step_ == game->fixed_steps())
+		{
+			float alpha = static_cast<float>(game->fixed_alpha());
 
-		XMMATRIX rotation = XMMatrixRotationRollPitchYawFromVector(rotation_);
+			translation = XMVectorLerp(previous_translation_, translation_, alpha);
+			rotation_vector = XMVectorLerp(previous_rotation_, rotation_, alpha);
+			scale = XMVectorLerp(previous_scale_, scale_, alpha);
+		}
+
+		XMMATRIX trans = XMMatrixTranslationFromVector(translation);
+
+		XMMATRIX rotation = XMMatrixRotationRollPitchYawFromVector(rotation_vector);
 
     if (billboarding_ == true)
     {
@@ -193,8 +227,8 @@ namespace snuffbox
     trans = XMLoadFloat4x4(&matrix);
 
 		*world =
-			XMMatrixScalingFromVector(scale_ * size_) *
-			XMMatrixTranslationFromVector(offset_ * scale_ * size_) *
+			XMMatrixScalingFromVector(scale * size_) *
+			XMMatrixTranslationFromVector(offset_ * scale * size_) *
 			rotation *
 			trans;
 
@@ -284,6 +318,7 @@ namespace snuffbox
   //-------------------------------------------------------------------------------------------
   void D3D11RenderElement::SetZ(const float& z)
   {
+    Snapshot();
     translation_ = XMVectorSetZ(translation_, z);
   }
 
@@ -405,6 +440,32 @@ namespace snuffbox
     return target_;
   }
 
+	//-------------------------------------------------------------------------------------------
+	void D3D11RenderElement::Snapshot()
+	{
+		if (interpolated_ == false)
+		{
+			return;
+		}
+
+		const unsigned int& step = Game::Instance()->fixed_steps();
+		if (snapshot_step_ == step)
+		{
+			return;
+		}
+
+		previous_translation_ = translation_;
+		previous_rotation_ = rotation_;
+		previous_scale_ = scale_;
+		snapshot_step_ = step;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	const bool& D3D11RenderElement::interpolated() const
+	{
+		return interpolated_;
+	}
+
 	//-------------------------------------------------------------------------------------------
 	const bool& D3D11RenderElement::billboarding() const
 	{
@@ -426,18 +487,21 @@ namespace snuffbox
   //-------------------------------------------------------------------------------------------
 	void D3D11RenderElement::set_translation(const float& x, const float& y, const float& z)
   {
+    Snapshot();
     translation_ = XMVectorSet(x, y, z, 1.0f);
   }
 
   //-------------------------------------------------------------------------------------------
 	void D3D11RenderElement::set_rotation(const float& x, const float& y, const float& z)
   {
+    Snapshot();
     rotation_ = XMVectorSet(x, y, z, 1.0f);
   }
 
   //-------------------------------------------------------------------------------------------
 	void D3D11RenderElement::set_scale(const float& x, const float& y, const float& z)
   {
+    Snapshot();
     scale_ = XMVectorSet(x, y, z, 1.0f);
   }
 
@@ -500,6 +564,18 @@ namespace snuffbox
 		billboarding_ = billboarding;
 	}
 
+	//-------------------------------------------------------------------------------------------
+	void D3D11RenderElement::set_interpolated(const bool& interpolated)
+	{
+		interpolated_ = interpolated;
+
+		// Start out without a previous transform, so the element doesn't interpolate from an old one
+		previous_translation_ = translation_;
+		previous_rotation_ = rotation_;
+		previous_scale_ = scale_;
+		snapshot_step_ = Game::Instance()->fixed_steps();
+	}
+
 	//-------------------------------------------------------------------------------------------
 	void D3D11RenderElement::set_blend(const float& r, const float& g, const float& b)
 	{
@@ -653,6 +729,8 @@ namespace snuffbox
 			{ "blend", JSBlend },
 			{ "setAlpha", JSSetAlpha },
 			{ "alpha", JSAlpha },
+			{ "setInterpolated", JSSetInterpolated },
+			{ "interpolated", JSInterpolated },
 			{ "setUniform", JSSetUniform },
 			{ "setAnimation", JSSetAnimation },
 			{ "setDiffuseMap", JSSetDiffuseMap },
@@ -962,6 +1040,27 @@ namespace snuffbox
 		wrapper.ReturnValue<float>(self->alpha());
 	}
 
+	//-------------------------------------------------------------------------------------------
+	void D3D11RenderElement::JSSetInterpolated(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		D3D11RenderElement* self = wrapper.GetPointer<D3D11RenderElement>(args.This());
+
+		if (wrapper.Check("B") == true)
+		{
+			self->set_interpolated(wrapper.GetValue<bool>(0, false));
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void D3D11RenderElement::JSInterpolated(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		D3D11RenderElement* self = wrapper.GetPointer<D3D11RenderElement>(args.This());
+
+		wrapper.ReturnValue<bool>(self->interpolated());
+	}
+
 	//-------------------------------------------------------------------------------------------
 	void D3D11RenderElement::JSSetUniform(JS_ARGS args)
 	{
@@ -74,7 +74,7 @@ namespace snuffbox
     /// Spawn without a render target, useful for e.g scroll areas
     void Spawn();
 
-    /// Destroys the render element
+    /// Destroys the render element, removing it from the queue and frame packet of its render target
     void Destroy();
 
     /**
@@ -220,6 +220,11 @@ namespace snuffbox
 		*/
 		const bool& billboarding() const;
 
+		/**
+		* @return const bool& Is the transform of this element interpolated between fixed steps?
+		*/
+		const bool& interpolated() const;
+
 		/**
 		* @return const XMFLOAT4& The animation coordinates of this render element
 		*/
@@ -312,6 +317,13 @@ namespace snuffbox
 		*/
 		void set_billboarding(const bool& billboarding);
 
+		/**
+		* @brief Sets if the translation, rotation and scale of this element should be interpolated between fixed steps when rendering
+		* @remarks Only the transform of the element itself is interpolated, parents are used as is
+		* @param[in] interpolated (const bool&) The boolean value
+		*/
+		void set_interpolated(const bool& interpolated);
+
 		/**
 		* @brief Sets the blend of this render element
 		* @param[in] r (const float&) The red value
@@ -385,6 +397,10 @@ namespace snuffbox
     */
     D3D11ScrollArea* scroll_area();
 
+  private:
+		/// Stores the transform before the first change within a fixed step, so rendering can interpolate from it
+		void Snapshot();
+
   private:
     XMVECTOR translation_; //!< The translation vector of this render element
     XMVECTOR rotation_; //!< The rotation vector of this render element
@@ -408,6 +424,11 @@ namespace snuffbox
 		bool alpha_changed_; //!< Was the alpha of this render element changed since last frame?
     MaterialGroup material_group_; //!< The material group of this render element
     D3D11ScrollArea* scroll_area_; //!< The scroll area parent of this render element
+		bool interpolated_; //!< Is the transform of this render element interpolated between fixed steps?
+		XMVECTOR previous_translation_; //!< The translation at the end of the fixed step before the last change
+		XMVECTOR previous_rotation_; //!< The rotation at the end of the fixed step before the last change
+		XMVECTOR previous_scale_; //!< The scale at the end of the fixed step before the last change
+		unsigned int snapshot_step_; //!< The fixed step the transform was last changed in
 
   public:
     static void Register(JS_CONSTRUCTABLE obj);
@@ -431,6 +452,8 @@ namespace snuffbox
 		static void JSBlend(JS_ARGS args);
 		static void JSSetAlpha(JS_ARGS args);
 		static void JSAlpha(JS_ARGS args);
+		static void JSSetInterpolated(JS_ARGS args);
+		static void JSInterpolated(JS_ARGS args);
     static void JSSpawn(JS_ARGS args);
 		static void JSSetUniform(JS_ARGS args);
 		static void JSSetAnimation(JS_ARGS args);
@@ -58,8 +58,11 @@ namespace snuffbox
 		},
 		indices);
 
+		height_data_.Release();
+
 		vertices_.clear();
 		indices_.clear();
+		heights_.assign(w * h, 0.0f);
 
     D3D11RenderDevice* render_device = D3D11RenderDevice::Instance();
     vertex_buffer_ = AllocatedMemory::Instance().Construct<D3D11VertexBuffer>(D3D11VertexBuffer::VertexBufferType::kOther);
@@ -118,6 +121,15 @@ namespace snuffbox
 		}
 
 		vertex_buffer_->Create(vertices_, indices_, false);
+
+		ReportMemory(sizeof(D3D11Terrain) +
+			sizeof(Vertex) * vertices_.size() +
+			sizeof(int) * indices_.size() +
+			vertex_buffer_->size() +
+			brush_vbo_->size() +
+			diffuses_->external_memory() +
+			normals_->external_memory() +
+			speculars_->external_memory());
   }
 
   //-------------------------------------------------------------------------------------------
@@ -286,6 +298,7 @@ namespace snuffbox
 		}
 
 		vertices_.at(idx).position.y = -h;
+		heights_.at(idx) = h;
 
     SetNormals(x, y);
 	}
@@ -532,6 +545,34 @@ namespace snuffbox
     vertex_buffer_->Update(vertices_, indices_, false);
   }
 
+	//-------------------------------------------------------------------------------------------
+	void D3D11Terrain::FlushRange(const int& first, const int& count)
+	{
+		int size = width_ * height_;
+		if (first < 0 || count < 0 || first + count > size)
+		{
+			SNUFF_LOG_ERROR("Attempted to flush terrain vertices " + std::to_string(first) + " to " + std::to_string(first + count) + ", this is out of bounds; the terrain has '" + std::to_string(size) + "' vertices");
+			return;
+		}
+
+		int last = first + count;
+		for (int i = first; i < last; ++i)
+		{
+			vertices_.at(i).position.y = -heights_.at(i);
+		}
+
+		for (int i = first; i < last; ++i)
+		{
+			SetNormals(i % width_, i / width_);
+		}
+
+		// Normals of the neighbouring rows change too, so those are flushed along with the range
+		int flush_first = first - width_ - 1 < 0 ? 0 : first - width_ - 1;
+		int flush_last = last + width_ + 1 > size ? size : last + width_ + 1;
+
+		vertex_buffer_->UpdateRange(vertices_, flush_first, flush_last - flush_first);
+	}
+
 	//-------------------------------------------------------------------------------------------
 	void D3D11Terrain::SaveTexture(const std::string& path)
 	{
@@ -659,6 +700,7 @@ namespace snuffbox
   //-------------------------------------------------------------------------------------------
 	D3D11Terrain::~D3D11Terrain()
   {
+		height_data_.Release();
 
   }
 
@@ -680,6 +722,7 @@ namespace snuffbox
       { "brushTexture", JSBrushTexture },
       { "setTextureTiling", JSSetTextureTiling },
 			{ "flush", JSFlush },
+			{ "heightData", JSHeightData },
 			{ "saveTexture", JSSaveTexture },
 			{ "loadTexture", JSLoadTexture }
 		};
@@ -868,9 +911,34 @@ namespace snuffbox
 		JSWrapper wrapper(args);
 		D3D11Terrain* self = wrapper.GetPointer<D3D11Terrain>(args.This());
 
+		if (args.Length() >= 2 && wrapper.Check("NN") == true)
+		{
+			self->FlushRange(wrapper.GetValue<int>(0, 0), wrapper.GetValue<int>(1, 0));
+			return;
+		}
+
 		self->Flush();
 	}
 
+	//-------------------------------------------------------------------------------------------
+	void D3D11Terrain::JSHeightData(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		D3D11Terrain* self = wrapper.GetPointer<D3D11Terrain>(args.This());
+
+		std::vector<float>& heights = self->heights_;
+		if (heights.empty() == true)
+		{
+			SNUFF_LOG_WARNING("Attempted to retrieve the height data of a terrain without heights");
+			args.GetReturnValue().Set(v8::Float32Array::New(v8::ArrayBuffer::New(args.GetIsolate(), 0), 0, 0));
+			return;
+		}
+
+		v8::Local<v8::ArrayBuffer> buffer = self->height_data_.Get(&heights[0], sizeof(float) * heights.size(), args.This());
+
+		args.GetReturnValue().Set(v8::Float32Array::New(buffer, 0, heights.size()));
+	}
+
 	//-------------------------------------------------------------------------------------------
 	void D3D11Terrain::JSSaveTexture(JS_ARGS args)
 	{
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../d3d11/elements/d3d11_render_element.h"
+#include "../../js/js_external_buffer.h"
 #include <vector>
 
 namespace snuffbox
@@ -141,6 +142,13 @@ namespace snuffbox
 		/// Flushes the terrain after modification of heights
 		void Flush();
 
+		/**
+		* @brief Applies the height data of a range of vertices and flushes them, used after modifying the height data from script
+		* @param[in] first (const int&) The index of the first vertex, row-major
+		* @param[in] count (const int&) The number of vertices to apply
+		*/
+		void FlushRange(const int& first, const int& count);
+
 		/**
 		* @brief Saves the terrain texture to a path
 		* @param[in] path (const std::string&) The path to save to
@@ -192,6 +200,8 @@ namespace snuffbox
     D3D11Shader* brush_shader_; //!< The brush shader for this terrain to use
 		std::vector<Vertex> vertices_; //!< The vertices of this terrain
 		std::vector<int> indices_; //!< The indices of this terrain
+		std::vector<float> heights_; //!< The heights of every vertex, row-major
+		JSExternalBuffer height_data_; //!< The buffer aliasing the heights for scripts
 		int width_; //!< The width of the terrain
 		int height_; //!< The height of the terrain
     float texture_size_; //!< The default texture width of this terrain
@@ -211,6 +221,7 @@ namespace snuffbox
     static void JSBrushTexture(JS_ARGS args);
     static void JSSetTextureTiling(JS_ARGS args);
 		static void JSFlush(JS_ARGS args);
+		static void JSHeightData(JS_ARGS args);
 		static void JSSaveTexture(JS_ARGS args);
 		static void JSLoadTexture(JS_ARGS args);
   };
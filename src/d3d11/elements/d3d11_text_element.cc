@@ -346,12 +346,18 @@ namespace snuffbox
 		vertex_buffer_->Create(vertices_, indices_, false);
     vertex_buffer_->set_topology(D3D11_PRIMITIVE_TOPOLOGY::D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
 
+		size_t memory = sizeof(D3D11Text) + sizeof(Vertex) * vertices_.size() + sizeof(int) * indices_.size() + vertex_buffer_->size();
+
 		for (TextIcon& it : icon_buffer_)
 		{
 			it.vertex_buffer = AllocatedMemory::Instance().Construct<D3D11VertexBuffer>(D3D11VertexBuffer::VertexBufferType::kOther);
 			it.vertex_buffer->Create(it.vertices, it.indices, false);
+
+			memory += sizeof(Vertex) * it.vertices.size() + sizeof(int) * it.indices.size() + it.vertex_buffer->size();
 		}
 
+		ReportMemory(memory);
+
 		pen_.x = 0.0f;
 		pen_.y = 0.0f;
 
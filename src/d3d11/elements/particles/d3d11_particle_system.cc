@@ -3,6 +3,7 @@
 #include "../../../d3d11/d3d11_render_settings.h"
 #include "../../../d3d11/d3d11_camera.h"
 #include "../../../application/game.h"
+#include "../../../application/job_system.h"
 #include "../../../content/content_manager.h"
 
 namespace snuffbox
@@ -91,6 +92,7 @@ namespace snuffbox
 		}
 
 		vertex_buffer_->Create(vertices_, indices_, false);
+		ReportMemory(sizeof(D3D11ParticleSystem) + sizeof(Vertex) * vertices_.size() + sizeof(int) * indices_.size() + vertex_buffer_->size() + sizeof(D3D11Particle) * max_particles);
 	}
 
 	//---------------------------------------------------------------------------------------------------------
@@ -110,17 +112,11 @@ namespace snuffbox
 
 		elapsed_time_ += dt;
 
-		int vertex_offset = 0;
-		int index_offset = 0;
-
 		static const XMVECTOR top_left = XMVectorSet(-0.5f, -0.5f, 0.0f, 1.0f);
 		static const XMVECTOR top_right = XMVectorSet(0.5f, -0.5f, 0.0f, 1.0f);
 		static const XMVECTOR bottom_left = XMVectorSet(-0.5f, 0.5f, 0.0f, 1.0f);
 		static const XMVECTOR bottom_right = XMVectorSet(0.5f, 0.5f, 0.0f, 1.0f);
 
-		float size, angle;
-		XMVECTOR trans;
-
 		XMMATRIX billboard_matrix = XMMatrixInverse(&XMVectorSet(0.0f, 0.0f, 0.0f, 0.0f), camera->view());
 		XMFLOAT4X4 matrix;
 		XMStoreFloat4x4(&matrix, billboard_matrix);
@@ -146,6 +142,8 @@ namespace snuffbox
 			return XMVector4Transform(p, XMMatrixScalingFromVector(scale) * XMMatrixRotationZ(angle) * billboard_matrix * XMMatrixTranslationFromVector(trans - world_trans));
 		};
 
+		// Particles are removed from the front of the deque, so they are updated and removed serially before the vertices are built in parallel
+		int finished = 0;
 		for (int i = 0; i < num_particles_; ++i)
 		{
 			D3D11Particle& particle = particles_.at(i);
@@ -153,37 +151,48 @@ namespace snuffbox
 
 			if (particle.finished() == true)
 			{
-				particles_.pop_front();
-				--num_particles_;
-				++i;
-				continue;
+				++finished;
 			}
+		}
+
+		for (int i = 0; i < finished; ++i)
+		{
+			particles_.pop_front();
+			--num_particles_;
+		}
 
-			vertex_offset = i * VERTICES_PER_PARTICLE;
-			index_offset = i * INDICES_PER_PARTICLE;
+		int max_visible = static_cast<int>(vertices_.size()) / VERTICES_PER_PARTICLE;
+		int visible = num_particles_ < max_visible ? num_particles_ : max_visible;
 
-			if (vertex_offset >= vertices_.size())
+		JobSystem::Instance()->ParallelFor(visible, 256, [this, &billboard](const int& start, const int& end)
+		{
+			float size, angle;
+			XMVECTOR trans;
+			int vertex_offset;
+
+			for (int i = start; i < end; ++i)
 			{
-				continue;
-			}
+				const D3D11Particle& particle = particles_.at(i);
+				vertex_offset = i * VERTICES_PER_PARTICLE;
 
-			Vertex& v1 = vertices_.at(vertex_offset);
-			Vertex& v2 = vertices_.at(vertex_offset + 1);
-			Vertex& v3 = vertices_.at(vertex_offset + 2);
-			Vertex& v4 = vertices_.at(vertex_offset + 3);
+				Vertex& v1 = vertices_.at(vertex_offset);
+				Vertex& v2 = vertices_.at(vertex_offset + 1);
+				Vertex& v3 = vertices_.at(vertex_offset + 2);
+				Vertex& v4 = vertices_.at(vertex_offset + 3);
 
-			trans = XMLoadFloat3(&particle.position());
-			size = particle.size();
-			angle = particle.angle();
+				trans = XMLoadFloat3(&particle.position());
+				size = particle.size();
+				angle = particle.angle();
 
-			XMStoreFloat4(&v1.position, billboard(top_left, trans, size, angle));
-			XMStoreFloat4(&v2.position, billboard(bottom_left, trans, size, angle));
-			XMStoreFloat4(&v3.position, billboard(top_right, trans, size, angle));
-			XMStoreFloat4(&v4.position, billboard(bottom_right, trans, size, angle));
+				XMStoreFloat4(&v1.position, billboard(top_left, trans, size, angle));
+				XMStoreFloat4(&v2.position, billboard(bottom_left, trans, size, angle));
+				XMStoreFloat4(&v3.position, billboard(top_right, trans, size, angle));
+				XMStoreFloat4(&v4.position, billboard(bottom_right, trans, size, angle));
 
-			v1.position.w = v2.position.w = v3.position.w = v4.position.w = 1.0f;
-			v1.colour = v2.colour = v3.colour = v4.colour = particle.colour();
-		}
+				v1.position.w = v2.position.w = v3.position.w = v4.position.w = 1.0f;
+				v1.colour = v2.colour = v3.colour = v4.colour = particle.colour();
+			}
+		});
 
 		vertex_buffer_->set_num_indices(num_particles_ * 6);
 		vertex_buffer_->Update(vertices_, indices_, false);
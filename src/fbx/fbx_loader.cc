@@ -1,5 +1,6 @@
 #include "../fbx/fbx_loader.h"
 #include "../application/game.h"
+#include "../application/binary_log.h"
 
 #include "../d3d11/d3d11_vertex_buffer.h"
 
@@ -35,7 +36,7 @@ namespace snuffbox
 	{
 		fbx_manager_ = FbxManager::Create();
 		SNUFF_ASSERT_NOTNULL(fbx_manager_, "FBXLoader::Initialise::fbx_manager_");
-		SNUFF_LOG_INFO("FBX SDK version " + std::string(fbx_manager_->GetVersion()));
+		SNUFF_CLOG_INFO("fbx", "FBX SDK version " + std::string(fbx_manager_->GetVersion()));
 
 		FbxIOSettings* io_settings = FbxIOSettings::Create(fbx_manager_, IOSROOT);
 		fbx_manager_->SetIOSettings(io_settings);
@@ -86,7 +87,7 @@ namespace snuffbox
 
 		if (fbx_importer->IsFBX())
 		{
-			SNUFF_LOG_INFO("FBX file version " + std::to_string(file_major_version) + "." + std::to_string(file_minor_version) + "." + std::to_string(file_revision));
+			SNUFF_BLOG_INFO("fbx", "FBX file version {}.{}.{}", file_major_version, file_minor_version, file_revision);
 			fbx_manager_->GetIOSettings()->SetBoolProp(IMP_FBX_MATERIAL, false);
 			fbx_manager_->GetIOSettings()->SetBoolProp(IMP_FBX_TEXTURE, false);
 			fbx_manager_->GetIOSettings()->SetBoolProp(IMP_FBX_LINK, false);
@@ -121,7 +122,7 @@ namespace snuffbox
         if (ref_mode == FbxLayerElementMaterial::EReferenceMode::eIndexToDirect || ref_mode == FbxLayerElementMaterial::EReferenceMode::eIndex)
         {
           material_array = &layer_material->GetIndexArray();
-          SNUFF_LOG_INFO("Found " + std::to_string(material_array->GetCount()) + " material sub-groups");
+          SNUFF_BLOG_INFO("fbx", "Found {} material sub-groups", material_array->GetCount());
         }
       }
     }
@@ -260,7 +261,7 @@ namespace snuffbox
       data->materials.at(data->materials.size() - 1).end = static_cast<unsigned int>(data->indices.size());
     }
 
-		SNUFF_LOG_INFO("Vertices: " + std::to_string(data->vertices.size()));
+		SNUFF_BLOG_INFO("fbx", "Vertices: {}", data->vertices.size());
 	}
 
 	//----------------------------------------------------------------------------------------
@@ -1,4 +1,5 @@
 #include "../input/keyboard.h"
+#include "../application/replay.h"
 
 #include "../memory/allocated_memory.h"
 #include "../memory/shared_ptr.h"
@@ -34,6 +35,11 @@ namespace snuffbox
 	//-------------------------------------------------------------------------------------------
 	void Keyboard::Notify(const KeyData& data)
 	{
+		if (Replay::Instance()->Filter(data) == false)
+		{
+			return;
+		}
+
 		queue_.push(data);
 	}
 
@@ -1,14 +1,19 @@
 #include "../input/mouse.h"
+
+#ifndef SNUFF_BUILD_NULL
 #include "../input/mouse_area.h"
+#endif
 
 #include "../memory/allocated_memory.h"
 #include "../memory/shared_ptr.h"
 
-#include "../platform/platform_window.h"
+#ifndef SNUFF_BUILD_NULL
 #include "../d3d11/d3d11_render_device.h"
 #include "../d3d11/d3d11_viewport.h"
 #include "../d3d11/d3d11_render_settings.h"
+#endif
 #include "../application/game.h"
+#include "../application/replay.h"
 
 namespace snuffbox
 {
@@ -21,11 +26,13 @@ namespace snuffbox
 		return mouse_available_;
 	}
 
+#ifndef SNUFF_BUILD_NULL
   //-------------------------------------------------------------------------------------------
   bool Mouse::MouseAreaSorter::operator()(MouseArea* a, MouseArea* b)
   {
     return a->GetZ() > b->GetZ();
   }
+#endif
 
 	//-------------------------------------------------------------------------------------------
 	Mouse::Mouse() :
@@ -65,6 +72,11 @@ namespace snuffbox
 	//-------------------------------------------------------------------------------------------
 	void Mouse::Notify(Mouse::MouseData data)
 	{
+		if (Replay::Instance()->Filter(data) == false)
+		{
+			return;
+		}
+
 		queue_.push(data);
 	}
 
@@ -124,6 +136,7 @@ namespace snuffbox
 		prev_x_ = x_;
 		prev_y_ = y_;
 
+#ifndef SNUFF_BUILD_NULL
     std::sort(mouse_areas_.begin(), mouse_areas_.end(), MouseAreaSorter());
 
     bool do_callback = true;
@@ -141,6 +154,7 @@ namespace snuffbox
 				callback = false;
 			}
     }
+#endif
 	}
 
 	//-------------------------------------------------------------------------------------------
@@ -181,11 +195,12 @@ namespace snuffbox
 			return p;
 		}
 
-		Window* window = Game::Instance()->window();
-
-		float w = static_cast<float>(window->width());
-		float h = static_cast<float>(window->height());
+#ifdef SNUFF_BUILD_NULL
+		p.x = 0.0f;
+		p.y = 0.0f;
 
+		return p;
+#else
 		D3D11Viewport* vp = D3D11RenderDevice::Instance()->viewport();
 		
 		float x1 = vp->x();
@@ -238,6 +253,7 @@ namespace snuffbox
 		p.y = 0.0f;
 
 		return p;
+#endif
 	}
 
   //-------------------------------------------------------------------------------------------
@@ -3,6 +3,13 @@
 #include "../platform/platform_text_file.h"
 #include "../memory/shared_ptr.h"
 
+#ifdef SNUFF_WIN32
+#include <Windows.h>
+#else
+#include <sys/stat.h>
+#include <dirent.h>
+#endif
+
 namespace snuffbox
 {
 	//-------------------------------------------------------------------------------------------
@@ -51,12 +58,21 @@ namespace snuffbox
 	//-------------------------------------------------------------------------------------------
 	bool IOManager::DirectoryExists(const std::string& path)
 	{
+#ifdef SNUFF_WIN32
 		DWORD dir = GetFileAttributesA((Game::Instance()->path() + "/" + path).c_str());
 
 		if (dir != INVALID_FILE_ATTRIBUTES && dir & FILE_ATTRIBUTE_DIRECTORY)
 		{
 			return true;
 		}
+#else
+		struct stat info;
+
+		if (stat((Game::Instance()->path() + "/" + path).c_str(), &info) == 0 && S_ISDIR(info.st_mode))
+		{
+			return true;
+		}
+#endif
 
 		return false;
 	}
@@ -70,17 +86,23 @@ namespace snuffbox
 			return;
 		}
 
+#ifdef SNUFF_WIN32
 		CreateDirectoryA((Game::Instance()->path() + "/" + path).c_str(), 0);
+#else
+		mkdir((Game::Instance()->path() + "/" + path).c_str(), 0755);
+#endif
 	}
 
 	//-------------------------------------------------------------------------------------------
 	std::vector<std::string> IOManager::FilesInDirectory(const std::string& path, const bool& directories)
 	{
-		HANDLE dir;
-		WIN32_FIND_DATA file_data;
 		std::vector<std::string> out;
 		std::string directory = Game::Instance()->path() + "/" + path;
 
+#ifdef SNUFF_WIN32
+		HANDLE dir;
+		WIN32_FIND_DATA file_data;
+
 		if ((dir = FindFirstFileA((directory + "/*").c_str(), &file_data)) == INVALID_HANDLE_VALUE)
 		{
 			SNUFF_LOG_ERROR("Could not retrieve directory listing for directory '" + path + "'");
@@ -106,6 +128,39 @@ namespace snuffbox
 		} while (FindNextFile(dir, &file_data));
 
 		FindClose(dir);
+#else
+		DIR* dir = opendir(directory.c_str());
+
+		if (dir == nullptr)
+		{
+			SNUFF_LOG_ERROR("Could not retrieve directory listing for directory '" + path + "'");
+			return out;
+		}
+
+		struct dirent* entry;
+		struct stat info;
+
+		while ((entry = readdir(dir)) != nullptr)
+		{
+			std::string file_name = entry->d_name;
+
+			if (file_name[0] == '.')
+			{
+				continue;
+			}
+
+			bool is_directory = stat((directory + "/" + file_name).c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+
+			if (is_directory == true && directories == false)
+			{
+				continue;
+			}
+
+			out.push_back(path + "/" + file_name);
+		}
+
+		closedir(dir);
+#endif
 
 		return out;
 	}
@@ -0,0 +1,46 @@
+#include "../js/js_allocator.h"
+
+#include "../memory/allocated_memory.h"
+#include "../memory/shared_ptr.h"
+
+#include <cstdlib>
+
+namespace snuffbox
+{
+	//-------------------------------------------------------------------------------------------
+	JSAllocator::JSAllocator()
+	{
+
+	}
+
+	//-------------------------------------------------------------------------------------------
+	JSAllocator* JSAllocator::Instance()
+	{
+		static SharedPtr<JSAllocator> allocator = AllocatedMemory::Instance().Construct<JSAllocator>();
+		return allocator.get();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void* JSAllocator::Allocate(size_t length)
+	{
+		return calloc(length, 1);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void* JSAllocator::AllocateUninitialized(size_t length)
+	{
+		return malloc(length);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSAllocator::Free(void* data, size_t length)
+	{
+		free(data);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	JSAllocator::~JSAllocator()
+	{
+
+	}
+}
\ No newline at end of file
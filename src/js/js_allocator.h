@@ -0,0 +1,48 @@
+#pragma once
+
+#include <v8.h>
+
+namespace snuffbox
+{
+	/**
+	* @class snuffbox::JSAllocator
+	* @brief The allocator V8 uses for the backing stores of ArrayBuffers, shared by every isolate so buffers can be transferred between them
+	* @author Danil Konings
+	*/
+	class JSAllocator : public v8::ArrayBuffer::Allocator
+	{
+	public:
+		/// Default constructor
+		JSAllocator();
+
+		/**
+		* @brief Retrieves the singleton instance of this class
+		* @return snuffbox::JSAllocator* The pointer to the singleton
+		*/
+		static JSAllocator* Instance();
+
+		/**
+		* @brief Allocates a zero-initialised block of memory
+		* @param[in] length (size_t) The size of the block in bytes
+		* @return void* The allocated block
+		*/
+		virtual void* Allocate(size_t length);
+
+		/**
+		* @brief Allocates an uninitialised block of memory
+		* @param[in] length (size_t) The size of the block in bytes
+		* @return void* The allocated block
+		*/
+		virtual void* AllocateUninitialized(size_t length);
+
+		/**
+		* @brief Frees a block of memory allocated by this allocator
+		* @param[in] data (void*) The block to free
+		* @param[in] length (size_t) The size of the block in bytes
+		*/
+		virtual void Free(void* data, size_t length);
+
+		/// Default destructor
+		virtual ~JSAllocator();
+	};
+}
\ No newline at end of file
@@ -3,17 +3,57 @@
 #include "../js/js_wrapper.h"
 #include "../application/logging.h"
 
-#include <vector>
 
 namespace snuffbox
 {
+  /**
+  * @class snuffbox::JSCallbackBase
+  * @brief The base class of every callback, keeps the frame epoch callbacks use to know whether their cached receiver is from the current frame
+  * @author Danil Konings
+  */
+  class JSCallbackBase
+  {
+  public:
+    /// Default constructor
+    JSCallbackBase();
+
+    /// Default destructor
+    virtual ~JSCallbackBase();
+
+    /**
+    * @return unsigned int& The frame epoch, odd while a snuffbox::JSFrameScope is open
+    */
+    static unsigned int& epoch();
+  };
+
+  /**
+  * @class snuffbox::JSFrameScope
+  * @brief A handle scope that lives for an entire frame, callbacks called within this scope create their function handle and look up their receiver on their first call and reuse both for the rest of the frame
+  * @author Danil Konings
+  */
+  class JSFrameScope
+  {
+  public:
+    /**
+    * @brief Opens the frame handle scope and starts a new frame epoch
+    * @param[in] isolate (v8::Isolate*) The isolate to open the scope in
+    */
+    JSFrameScope(v8::Isolate* isolate);
+
+    /// Ends the frame epoch, so no receiver cached during the frame is used after it, and closes the frame handle scope
+    ~JSFrameScope();
+
+  private:
+    v8::HandleScope scope_; //!< The frame handle scope
+  };
+
   /**
   * @class snuffbox::JSCallback<...Args>
   * @brief Used to wrap callbacks to JavaScript
   * @author Danil Konings
   */
 	template <typename ...Args>
-  class JSCallback
+  class JSCallback : public JSCallbackBase
   {
   public:
     /// Default constructor
@@ -45,55 +85,107 @@ namespace snuffbox
     void Set(const v8::Handle<v8::Value>& cb);
 
     /**
-    * @brief Pushes a value into the value array, to pass to the call of the callback
-    * @param[in] arg (const T&) The argument to push
+    * @brief Calls the function JavaScript sided, the arguments are passed through a stack array so no allocations are made
+    * @remarks Within a snuffbox::JSFrameScope the handles are created in the frame scope, outside of it or when called from JavaScript a handle scope is opened for the call
+    * @param[in] args (const Args&...) The arguments to forward to JavaScript
     */
-    template <typename T>
-    void push(const T& arg);
+    void Call(const Args& ...args);
+
+		/// Clears the weak data of the persistent callback handle
+		void Clear();
+
+    /// Discards the cached receiver, it is looked up again on the next call
+    void Uncache();
 
     /**
-    * @brief The last function to break recursion of argument pushing
-    * @return int 0, as there are no more arguments to push
+    * @brief Sets whether the receiver may be cached for a frame, used to measure the cost of the lookup
+    * @param[in] cacheable (const bool&) Can the receiver be cached?
     */
-    int push_arg();
+    void set_cacheable(const bool& cacheable);
 
+    /// Default destructor
+    ~JSCallback();
+
+  private:
     /**
-    * @brief Pushes an argument when there is only one argument left
-    * @param[in] first (const T&) The argument that's left to be pushed
-    * @return int 1 Still arguments on the stack
+    * @brief Calls a function with the cached receiver and logs any exception it throws
+    * @param[in] func (const v8::Local<v8::Function>&) The function to call
+    * @param[in] args (const Args&...) The arguments to forward to JavaScript
     */
-    template <typename T>
-		int push_arg(const T& first);
+    void Invoke(const v8::Local<v8::Function>& func, const Args& ...args);
 
     /**
-    * @brief Pushes an argument when there are 2 or more arguments left
-    * @param[in] first (const T&) The argument that's next to be pushed
-    * @param[in] args (const Others&...) The rest of the arguments that are left to be pushed
-    * @return int 1 + previous argument count, Still arguments on the stack
+    * @brief Retrieves the function handle, created in the frame scope on the first call within a frame
+    * @return v8::Local<v8::Function> The function to call
     */
-    template <typename T, typename ... Others>
-		int push_arg(const T& first, const Others&...args);
+    v8::Local<v8::Function> CachedFunction();
 
     /**
-    * @brief Calls the function JavaScript sided
-    * @param[in] args (const Args&...) The arguments to forward to JavaScript
+    * @brief Retrieves the object to call a function on, the 'ctx' field of the function or the global object
+    * @param[in] func (const v8::Local<v8::Function>&) The function to retrieve the receiver of
+    * @return v8::Local<v8::Object> The receiver
     */
-    void Call(const Args& ...args);
+    static v8::Local<v8::Object> Receiver(const v8::Local<v8::Function>& func);
 
-		/// Clears the weak data of the persistent callback handle
-		void Clear();
+    /**
+    * @brief Retrieves the receiver to call the function on, cached for the rest of the frame on the first call within a frame
+    * @param[in] func (const v8::Local<v8::Function>&) The function to retrieve the receiver of
+    * @return v8::Local<v8::Object> The receiver
+    */
+    v8::Local<v8::Object> CachedReceiver(const v8::Local<v8::Function>& func);
+
+    /// Called when the cached receiver is garbage collected
+    static void JSWeakReceiver(const v8::WeakCallbackData<v8::Object, JSCallback<Args...>>& data);
 
-    /// Default destructor
-    ~JSCallback();
   private:
     v8::Persistent<v8::Function> callback_; //!< A persistent handle containing the callback if any
-    std::vector<v8::Handle<v8::Value>> values_; //!< The arguments to call with JavaScript sided
+    v8::Persistent<v8::Object> receiver_; //!< The receiver cached for the current frame, held weakly as it usually holds the function, empty for the global object
+    v8::Local<v8::Function> function_; //!< The function handle created in the frame scope of the current frame
+    unsigned int function_epoch_; //!< The frame epoch the function handle was created in, 0 if there is none
+    unsigned int cached_epoch_; //!< The frame epoch the receiver was cached in, 0 if it isn't cached
+    bool cacheable_; //!< Can the receiver be cached for a frame?
     bool valid_; //!< Is this callback valid?
   };
 
+  //-------------------------------------------------------------------------------------------
+  inline JSCallbackBase::JSCallbackBase()
+  {
+
+  }
+
+  //-------------------------------------------------------------------------------------------
+  inline JSCallbackBase::~JSCallbackBase()
+  {
+
+  }
+
+  //-------------------------------------------------------------------------------------------
+  inline unsigned int& JSCallbackBase::epoch()
+  {
+    static unsigned int epoch = 0;
+    return epoch;
+  }
+
+  //-------------------------------------------------------------------------------------------
+  inline JSFrameScope::JSFrameScope(v8::Isolate* isolate) :
+    scope_(isolate)
+  {
+    unsigned int& epoch = JSCallbackBase::epoch();
+    epoch += (epoch & 1) == 0 ? 1 : 2;
+  }
+
+  //-------------------------------------------------------------------------------------------
+  inline JSFrameScope::~JSFrameScope()
+  {
+    ++JSCallbackBase::epoch();
+  }
+
   //-------------------------------------------------------------------------------------------
   template<typename ... Args>
   inline JSCallback<Args...>::JSCallback() :
+    cached_epoch_(0),
+    function_epoch_(0),
+    cacheable_(true),
     valid_(false)
   {
 
@@ -126,6 +218,8 @@ namespace snuffbox
 		callback_.SetWeak(static_cast<JSCallback<Args...>*>(this), JSWeak);
     valid_ = true;
 
+    Uncache();
+
     return true;
   }
 
@@ -171,6 +265,8 @@ namespace snuffbox
 		callback_.SetWeak(static_cast<JSCallback<Args...>*>(this), JSWeak);
     valid_ = true;
 
+    Uncache();
+
     return true;
   }
 
@@ -182,36 +278,8 @@ namespace snuffbox
 		callback_.Reset(JSStateWrapper::Instance()->isolate(), value.As<v8::Function>());
 		callback_.SetWeak(static_cast<JSCallback<Args...>*>(this), JSWeak);
     valid_ = true;
-  }
-
-  //-------------------------------------------------------------------------------------------
-  template<typename ... Args> template<typename T>
-  inline void JSCallback<Args...>::push(const T& arg)
-  {
-    values_.push_back(JSWrapper::CastValue<T>(arg));
-  }
-
-  //-------------------------------------------------------------------------------------------
-  template <typename ... Args>
-  inline int JSCallback<Args...>::push_arg()
-  {
-    return 0;
-  }
 
-  //-------------------------------------------------------------------------------------------
-  template <typename ... Args> template <typename T>
-  inline int JSCallback<Args...>::push_arg(const T& first)
-  {
-    push(first);
-    return 1;
-  }
-
-  //-------------------------------------------------------------------------------------------
-  template <typename ... Args> template <typename T, typename ... Others>
-  inline int JSCallback<Args...>::push_arg(const T& first, const Others&...args)
-  {
-    push(first);
-    return push_arg(args...) + 1;
+    Uncache();
   }
 
   //-------------------------------------------------------------------------------------------
@@ -223,30 +291,34 @@ namespace snuffbox
       return;
     }
 
-    JSStateWrapper* wrapper = JSStateWrapper::Instance();
-    v8::Isolate* isolate = wrapper->isolate();
+    v8::Isolate* isolate = JSStateWrapper::Instance()->isolate();
+
+    // The frame scope outlives every call within the frame, so the handles of a call don't need a scope of their own
+    // Calls made from JavaScript are in the handle scope of the caller instead, which closes before the frame does
+    if ((JSCallbackBase::epoch() & 1) == 1 && isolate->GetCallingContext().IsEmpty() == true)
+    {
+      Invoke(CachedFunction(), args...);
+      return;
+    }
+
     v8::HandleScope scope(isolate);
 
-    v8::TryCatch try_catch;
+    Invoke(v8::Local<v8::Function>::New(isolate, callback_), args...);
+  }
 
-    values_.clear();
-    int nargs = push_arg(args...);
+  //-------------------------------------------------------------------------------------------
+  template <typename ...Args>
+  inline void JSCallback<Args...>::Invoke(const v8::Local<v8::Function>& func, const Args& ...args)
+  {
+    v8::TryCatch try_catch;
 
-    v8::Local<v8::Function> func = v8::Local<v8::Function>::New(isolate, callback_);
-		v8::Local<v8::Value> ctx = func->Get(v8::String::NewFromUtf8(isolate, "ctx"));
+    v8::Local<v8::Object> receiver = CachedReceiver(func);
 
-    nargs != 0 ? func->Call(
-			ctx->IsUndefined() == false && ctx->IsObject() == true ? 
-			ctx->ToObject() : wrapper->global(), nargs, &values_[0]) 
-			
-			: 
-			
-			func->Call(
-			ctx->IsUndefined() == false && ctx->IsObject() == true ?
-			ctx->ToObject() : wrapper->global(), 0, 0);
+    v8::Handle<v8::Value> argv[sizeof...(Args) + 1] = { JSWrapper::CastValue<Args>(args)... };
+    func->Call(receiver, static_cast<int>(sizeof...(Args)), argv);
 
     std::string exception;
-    bool failed = wrapper->GetException(&try_catch, &exception);
+    bool failed = JSStateWrapper::Instance()->GetException(&try_catch, &exception);
 
     if (failed == true)
     {
@@ -268,8 +340,97 @@ namespace snuffbox
 			callback_.ClearWeak();
 			callback_.Reset();
 		}
+
+		Uncache();
 	}
 
+  //-------------------------------------------------------------------------------------------
+  template<typename ... Args>
+  inline void JSCallback<Args...>::Uncache()
+  {
+    if (receiver_.IsEmpty() == false)
+    {
+      receiver_.ClearWeak();
+      receiver_.Reset();
+    }
+
+    cached_epoch_ = 0;
+
+    function_ = v8::Local<v8::Function>();
+    function_epoch_ = 0;
+  }
+
+  //-------------------------------------------------------------------------------------------
+  template<typename ... Args>
+  inline void JSCallback<Args...>::set_cacheable(const bool& cacheable)
+  {
+    cacheable_ = cacheable;
+    Uncache();
+  }
+
+  //-------------------------------------------------------------------------------------------
+  template<typename ... Args>
+  inline v8::Local<v8::Function> JSCallback<Args...>::CachedFunction()
+  {
+    unsigned int epoch = JSCallbackBase::epoch();
+
+    if (function_epoch_ != epoch)
+    {
+      function_ = v8::Local<v8::Function>::New(JSStateWrapper::Instance()->isolate(), callback_);
+      function_epoch_ = epoch;
+    }
+
+    return function_;
+  }
+
+  //-------------------------------------------------------------------------------------------
+  template<typename ... Args>
+  inline v8::Local<v8::Object> JSCallback<Args...>::CachedReceiver(const v8::Local<v8::Function>& func)
+  {
+    unsigned int epoch = JSCallbackBase::epoch();
+
+    // Outside of a frame scope there is no frame to cache for
+    if (cacheable_ == false || (epoch & 1) == 0)
+    {
+      return Receiver(func);
+    }
+
+    JSStateWrapper* wrapper = JSStateWrapper::Instance();
+
+    if (cached_epoch_ == epoch)
+    {
+      return receiver_.IsEmpty() == true ? wrapper->global() : v8::Local<v8::Object>::New(wrapper->isolate(), receiver_);
+    }
+
+    v8::Local<v8::Object> receiver = Receiver(func);
+
+    if (receiver_.IsEmpty() == false)
+    {
+      receiver_.ClearWeak();
+      receiver_.Reset();
+    }
+
+    if (receiver != wrapper->global())
+    {
+      receiver_.Reset(wrapper->isolate(), receiver);
+      receiver_.SetWeak(this, JSWeakReceiver);
+    }
+
+    cached_epoch_ = epoch;
+
+    return receiver;
+  }
+
+  //-------------------------------------------------------------------------------------------
+  template<typename ... Args>
+  inline v8::Local<v8::Object> JSCallback<Args...>::Receiver(const v8::Local<v8::Function>& func)
+  {
+    JSStateWrapper* wrapper = JSStateWrapper::Instance();
+    v8::Local<v8::Value> ctx = func->Get(v8::String::NewFromUtf8(wrapper->isolate(), "ctx"));
+
+    return ctx->IsUndefined() == false && ctx->IsObject() == true ? ctx->ToObject() : wrapper->global();
+  }
+
   //-------------------------------------------------------------------------------------------
   template<typename ... Args>
   inline JSCallback<Args...>::~JSCallback()
@@ -278,6 +439,16 @@ namespace snuffbox
 		valid_ = false;
   }
 
+	//-------------------------------------------------------------------------------------------
+	template<typename ... Args>
+	inline void JSCallback<Args...>::JSWeakReceiver(const v8::WeakCallbackData<v8::Object, JSCallback<Args...>>& data)
+	{
+		// Only reachable when the script reassigned 'ctx' during the frame, the new receiver is looked up on the next call
+		JSCallback* ptr = data.GetParameter();
+		ptr->receiver_.Reset();
+		ptr->cached_epoch_ = 0;
+	}
+
 	//-------------------------------------------------------------------------------------------
 	template<typename ... Args> template<typename ... CArgs>
 	inline void JSCallback<Args...>::JSWeak(const v8::WeakCallbackData<v8::Function, JSCallback<CArgs...>>& data)
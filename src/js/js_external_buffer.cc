@@ -0,0 +1,72 @@
+#include "../js/js_external_buffer.h"
+#include "../js/js_state_wrapper.h"
+
+using namespace v8;
+
+namespace snuffbox
+{
+	//-------------------------------------------------------------------------------------------
+	JSExternalBuffer::JSExternalBuffer() :
+		data_(nullptr),
+		length_(0)
+	{
+
+	}
+
+	//-------------------------------------------------------------------------------------------
+	Local<ArrayBuffer> JSExternalBuffer::Get(void* data, const size_t& length, const Handle<Object>& owner)
+	{
+		Isolate* isolate = JSStateWrapper::Instance()->isolate();
+
+		if (buffer_.IsEmpty() == false && data_ == data && length_ == length)
+		{
+			return Local<ArrayBuffer>::New(isolate, buffer_);
+		}
+
+		Release();
+
+		Local<ArrayBuffer> buffer = ArrayBuffer::New(isolate, data, length);
+		buffer->SetHiddenValue(String::NewFromUtf8(isolate, "__owner"), owner);
+
+		buffer_.Reset(isolate, buffer);
+		buffer_.SetWeak(this, OnCollected);
+		data_ = data;
+		length_ = length;
+
+		return buffer;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSExternalBuffer::Release()
+	{
+		if (buffer_.IsEmpty() == true)
+		{
+			return;
+		}
+
+		Isolate* isolate = JSStateWrapper::Instance()->isolate();
+		HandleScope scope(isolate);
+
+		Local<ArrayBuffer>::New(isolate, buffer_)->Neuter();
+		buffer_.Reset();
+
+		data_ = nullptr;
+		length_ = 0;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSExternalBuffer::OnCollected(const WeakCallbackData<ArrayBuffer, JSExternalBuffer>& data)
+	{
+		JSExternalBuffer* self = data.GetParameter();
+
+		self->buffer_.Reset();
+		self->data_ = nullptr;
+		self->length_ = 0;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	JSExternalBuffer::~JSExternalBuffer()
+	{
+		Release();
+	}
+}
\ No newline at end of file
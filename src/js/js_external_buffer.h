@@ -0,0 +1,47 @@
+#pragma once
+
+#include <v8.h>
+
+namespace snuffbox
+{
+	/**
+	* @class snuffbox::JSExternalBuffer
+	* @brief An ArrayBuffer that aliases native memory, so that scripts can read and write native data through typed arrays without copying
+	* @remarks The buffer is neutered when the native memory moves or is freed, any typed array viewing it will have a length of 0 after that.
+	* The buffer is only held weakly, as it keeps its owner alive; a strong handle would keep both alive forever
+	* @author Danil Konings
+	*/
+	class JSExternalBuffer
+	{
+	public:
+		/// Default constructor
+		JSExternalBuffer();
+
+		/**
+		* @brief Retrieves the ArrayBuffer aliasing a block of native memory, the previous buffer is reused if it aliases the same block
+		* @param[in] data (void*) The native memory to alias
+		* @param[in] length (const size_t&) The length of the memory block in bytes
+		* @param[in] owner (const v8::Handle<v8::Object>&) The object owning the memory, kept alive for as long as the buffer is reachable
+		* @return v8::Local<v8::ArrayBuffer> The aliasing buffer
+		*/
+		v8::Local<v8::ArrayBuffer> Get(void* data, const size_t& length, const v8::Handle<v8::Object>& owner);
+
+		/// Neuters the current buffer, should be called whenever the aliased memory is moved or freed
+		void Release();
+
+		/// Default destructor, neuters the current buffer
+		~JSExternalBuffer();
+
+	private:
+		/**
+		* @brief Called when the current buffer is garbage collected, forgets the buffer so a new one is created on the next retrieval
+		* @param[in] data (const v8::WeakCallbackData<v8::ArrayBuffer, snuffbox::JSExternalBuffer>&) The collected buffer and its native counterpart
+		*/
+		static void OnCollected(const v8::WeakCallbackData<v8::ArrayBuffer, JSExternalBuffer>& data);
+
+	private:
+		v8::Persistent<v8::ArrayBuffer> buffer_; //!< The current aliasing buffer, if any, held weakly
+		void* data_; //!< The native memory the current buffer aliases
+		size_t length_; //!< The length of the aliased memory in bytes
+	};
+}
\ No newline at end of file
@@ -30,4 +30,29 @@ namespace snuffbox
       obj->Set(v8::String::NewFromUtf8(isolate, funcs[i].name.c_str()), func);
     }
   }
+
+  //---------------------------------------------------------------------------------------------------------
+  void JSFunctionRegister::QualifyNames(const v8::Handle<v8::Object>& obj, const std::string& class_name)
+  {
+    JSStateWrapper* wrapper = JSStateWrapper::Instance();
+    v8::Isolate* isolate = wrapper->isolate();
+
+    v8::Local<v8::Array> names = obj->GetOwnPropertyNames();
+    v8::Local<v8::Value> key, value;
+
+    for (unsigned int i = 0; i < names->Length(); ++i)
+    {
+      key = names->Get(i);
+      value = obj->Get(key);
+
+      std::string field = *v8::String::Utf8Value(key);
+      if (value->IsFunction() == false || field == "constructor")
+      {
+        continue;
+      }
+
+      std::string name = class_name + "." + field;
+      v8::Local<v8::Function>::Cast(value)->SetName(v8::String::NewFromUtf8(isolate, name.c_str()));
+    }
+  }
 }
\ No newline at end of file
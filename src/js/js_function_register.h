@@ -31,5 +31,13 @@ namespace snuffbox
     * @param[in] obj (const v8::Handle<v8::Object>&) The object to register the functions to
     */
     static void Register(JSFunctionRegister* funcs, const int& num, const v8::Handle<v8::Object>& obj);
+
+    /**
+    * @brief Prefixes the names of all functions on an object with the name of the class that owns them
+    * @remarks V8's CPU profiler names native callbacks after their function, this makes sure 'Quad.setTranslation' and 'Camera.setTranslation' are attributed separately
+    * @param[in] obj (const v8::Handle<v8::Object>&) The object containing the registered functions
+    * @param[in] class_name (const std::string&) The name of the owning class
+    */
+    static void QualifyNames(const v8::Handle<v8::Object>& obj, const std::string& class_name);
   };
 }
\ No newline at end of file
@@ -0,0 +1,502 @@
+#include "../js/js_message.h"
+#include "../js/js_allocator.h"
+
+#include <mutex>
+#include <cstring>
+
+using namespace v8;
+
+namespace snuffbox
+{
+	//-------------------------------------------------------------------------------------------
+	namespace
+	{
+		/**
+		* @struct snuffbox::AttachedBuffer
+		* @brief A transferred buffer that is owned by an isolate, freed when its ArrayBuffer is collected
+		* @author Danil Konings
+		*/
+		struct AttachedBuffer
+		{
+			Persistent<ArrayBuffer> handle; //!< The weak handle to the ArrayBuffer wrapping the contents
+			Isolate* isolate; //!< The isolate that owns the buffer
+			JSMessage::Buffer contents; //!< The contents of the buffer
+		};
+
+		std::mutex attached_mutex_;
+		std::vector<AttachedBuffer*> attached_;
+
+		//-------------------------------------------------------------------------------------------
+		void RemoveAttached(AttachedBuffer* buffer)
+		{
+			std::lock_guard<std::mutex> lock(attached_mutex_);
+			for (unsigned int i = 0; i < attached_.size(); ++i)
+			{
+				if (attached_.at(i) == buffer)
+				{
+					attached_.erase(attached_.begin() + i);
+					break;
+				}
+			}
+		}
+
+		//-------------------------------------------------------------------------------------------
+		void OnAttachedCollected(const WeakCallbackData<ArrayBuffer, AttachedBuffer>& data)
+		{
+			AttachedBuffer* buffer = data.GetParameter();
+			RemoveAttached(buffer);
+
+			buffer->handle.Reset();
+			JSAllocator::Instance()->Free(buffer->contents.data, buffer->contents.length);
+			delete buffer;
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	JSMessage::JSMessage()
+	{
+
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool JSMessage::Write(Isolate* isolate, const Handle<Value>& value, const Handle<Value>& transfer, std::string* error)
+	{
+		transfer_.clear();
+		detach_.clear();
+		identities_.clear();
+		objects_.clear();
+
+		if (transfer.IsEmpty() == false && transfer->IsArray() == true)
+		{
+			Local<Array> list = Local<Array>::Cast(transfer);
+			Local<Value> item;
+
+			for (unsigned int i = 0; i < list->Length(); ++i)
+			{
+				item = list->Get(i);
+				if (item->IsArrayBuffer() == false)
+				{
+					*error = "Only ArrayBuffers can be transferred";
+					return false;
+				}
+
+				transfer_.push_back(Local<ArrayBuffer>::Cast(item));
+			}
+		}
+
+		bool success = WriteNode(isolate, value, &root_, error);
+
+		for (unsigned int i = 0; i < detach_.size() && success == true; ++i)
+		{
+			Node* node = detach_.at(i).first;
+			Local<ArrayBuffer> buffer = detach_.at(i).second;
+
+			Buffer contents;
+			if (Detach(isolate, buffer, &contents) == false)
+			{
+				ArrayBuffer::Contents copy = buffer->GetContents();
+				node->type = Types::kArrayBuffer;
+				node->data.assign(static_cast<const char*>(copy.Data()), copy.ByteLength());
+				continue;
+			}
+
+			node->type = Types::kTransferred;
+			node->index = static_cast<int>(buffers_.size());
+			buffers_.push_back(contents);
+		}
+
+		transfer_.clear();
+		detach_.clear();
+		identities_.clear();
+		objects_.clear();
+
+		return success;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool JSMessage::WriteNode(Isolate* isolate, const Handle<Value>& value, Node* node, std::string* error)
+	{
+		if (value.IsEmpty() == true || value->IsUndefined() == true)
+		{
+			node->type = Types::kUndefined;
+			return true;
+		}
+
+		if (value->IsNull() == true)
+		{
+			node->type = Types::kNull;
+			return true;
+		}
+
+		if (value->IsBoolean() == true)
+		{
+			node->type = Types::kBoolean;
+			node->number = value->BooleanValue() == true ? 1.0 : 0.0;
+			return true;
+		}
+
+		if (value->IsNumber() == true)
+		{
+			node->type = Types::kNumber;
+			node->number = value->NumberValue();
+			return true;
+		}
+
+		if (value->IsString() == true)
+		{
+			String::Utf8Value str(value);
+			node->type = Types::kString;
+			node->data.assign(*str, str.length());
+			return true;
+		}
+
+		if (value->IsFunction() == true)
+		{
+			*error = "Functions can not be cloned";
+			return false;
+		}
+
+		if (value->IsObject() == false)
+		{
+			*error = "Unsupported value type in message";
+			return false;
+		}
+
+		Local<Object> obj = value->ToObject();
+		int hash = obj->GetIdentityHash();
+
+		typedef std::multimap<int, size_t>::const_iterator Identity;
+		std::pair<Identity, Identity> range = identities_.equal_range(hash);
+
+		for (Identity it = range.first; it != range.second; ++it)
+		{
+			if (objects_.at(it->second) == obj)
+			{
+				node->type = Types::kReference;
+				node->index = static_cast<int>(it->second);
+				return true;
+			}
+		}
+
+		identities_.insert(std::make_pair(hash, objects_.size()));
+		objects_.push_back(obj);
+
+		if (value->IsArrayBuffer() == true)
+		{
+			Local<ArrayBuffer> buffer = Local<ArrayBuffer>::Cast(value);
+
+			for (unsigned int i = 0; i < transfer_.size(); ++i)
+			{
+				if (transfer_.at(i) != buffer)
+				{
+					continue;
+				}
+
+				if (CanDetach(isolate, buffer) == false)
+				{
+					break;
+				}
+
+				node->type = Types::kTransferred;
+				detach_.push_back(std::make_pair(node, buffer));
+				return true;
+			}
+
+			ArrayBuffer::Contents contents = buffer->GetContents();
+			node->type = Types::kArrayBuffer;
+			node->data.assign(static_cast<const char*>(contents.Data()), contents.ByteLength());
+			return true;
+		}
+
+		if (value->IsArrayBufferView() == true)
+		{
+			Local<ArrayBufferView> view = Local<ArrayBufferView>::Cast(value);
+
+			node->type = Types::kView;
+			node->offset = view->ByteOffset();
+
+			if (value->IsDataView() == true)
+			{
+				node->index = Views::kDataView;
+				node->length = view->ByteLength();
+			}
+			else
+			{
+				node->length = Local<TypedArray>::Cast(value)->Length();
+
+				if (value->IsInt8Array() == true) { node->index = Views::kInt8; }
+				else if (value->IsUint8Array() == true) { node->index = Views::kUint8; }
+				else if (value->IsUint8ClampedArray() == true) { node->index = Views::kUint8Clamped; }
+				else if (value->IsInt16Array() == true) { node->index = Views::kInt16; }
+				else if (value->IsUint16Array() == true) { node->index = Views::kUint16; }
+				else if (value->IsInt32Array() == true) { node->index = Views::kInt32; }
+				else if (value->IsUint32Array() == true) { node->index = Views::kUint32; }
+				else if (value->IsFloat32Array() == true) { node->index = Views::kFloat32; }
+				else { node->index = Views::kFloat64; }
+			}
+
+			node->children.resize(1);
+			return WriteNode(isolate, view->Buffer(), &node->children.at(0), error);
+		}
+
+		if (value->IsArray() == true)
+		{
+			Local<Array> arr = Local<Array>::Cast(value);
+			unsigned int length = arr->Length();
+
+			node->type = Types::kArray;
+			node->children.resize(length);
+
+			for (unsigned int i = 0; i < length; ++i)
+			{
+				if (WriteNode(isolate, arr->Get(i), &node->children.at(i), error) == false)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		Local<Array> names = obj->GetOwnPropertyNames();
+		unsigned int length = names->Length();
+
+		node->type = Types::kObject;
+		node->keys.resize(length);
+		node->children.resize(length);
+
+		Local<Value> key;
+		for (unsigned int i = 0; i < length; ++i)
+		{
+			key = names->Get(i);
+			node->keys.at(i) = *String::Utf8Value(key);
+
+			if (WriteNode(isolate, obj->Get(key), &node->children.at(i), error) == false)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	Local<Value> JSMessage::Read(Isolate* isolate)
+	{
+		objects_.clear();
+		Local<Value> value = ReadNode(isolate, root_);
+		objects_.clear();
+
+		return value;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	Local<Value> JSMessage::ReadNode(Isolate* isolate, const Node& node)
+	{
+		switch (node.type)
+		{
+		case Types::kNull:
+			return Null(isolate);
+
+		case Types::kBoolean:
+			return Boolean::New(isolate, node.number != 0.0);
+
+		case Types::kNumber:
+			return Number::New(isolate, node.number);
+
+		case Types::kString:
+			return String::NewFromUtf8(isolate, node.data.c_str(), String::kNormalString, static_cast<int>(node.data.size()));
+
+		case Types::kReference:
+			return objects_.at(node.index);
+
+		case Types::kArrayBuffer:
+		{
+			Local<ArrayBuffer> buffer = ArrayBuffer::New(isolate, node.data.size());
+			memcpy(buffer->GetContents().Data(), node.data.data(), node.data.size());
+
+			objects_.push_back(buffer);
+			return buffer;
+		}
+
+		case Types::kTransferred:
+		{
+			Buffer& contents = buffers_.at(node.index);
+			Local<ArrayBuffer> buffer = Attach(isolate, contents);
+			contents.data = nullptr;
+
+			objects_.push_back(buffer);
+			return buffer;
+		}
+
+		case Types::kView:
+		{
+			Local<Object> placeholder = Object::New(isolate);
+			size_t index = objects_.size();
+			objects_.push_back(placeholder);
+
+			Local<ArrayBuffer> buffer = Local<ArrayBuffer>::Cast(ReadNode(isolate, node.children.at(0)));
+			Local<Object> view;
+
+			switch (node.index)
+			{
+			case Views::kInt8: view = Int8Array::New(buffer, node.offset, node.length); break;
+			case Views::kUint8: view = Uint8Array::New(buffer, node.offset, node.length); break;
+			case Views::kUint8Clamped: view = Uint8ClampedArray::New(buffer, node.offset, node.length); break;
+			case Views::kInt16: view = Int16Array::New(buffer, node.offset, node.length); break;
+			case Views::kUint16: view = Uint16Array::New(buffer, node.offset, node.length); break;
+			case Views::kInt32: view = Int32Array::New(buffer, node.offset, node.length); break;
+			case Views::kUint32: view = Uint32Array::New(buffer, node.offset, node.length); break;
+			case Views::kFloat32: view = Float32Array::New(buffer, node.offset, node.length); break;
+			case Views::kFloat64: view = Float64Array::New(buffer, node.offset, node.length); break;
+			default: view = DataView::New(buffer, node.offset, node.length); break;
+			}
+
+			objects_.at(index) = view;
+			return view;
+		}
+
+		case Types::kArray:
+		{
+			Local<Array> arr = Array::New(isolate, static_cast<int>(node.children.size()));
+			objects_.push_back(arr);
+
+			for (unsigned int i = 0; i < node.children.size(); ++i)
+			{
+				arr->Set(i, ReadNode(isolate, node.children.at(i)));
+			}
+
+			return arr;
+		}
+
+		case Types::kObject:
+		{
+			Local<Object> obj = Object::New(isolate);
+			objects_.push_back(obj);
+
+			for (unsigned int i = 0; i < node.children.size(); ++i)
+			{
+				obj->Set(String::NewFromUtf8(isolate, node.keys.at(i).c_str()), ReadNode(isolate, node.children.at(i)));
+			}
+
+			return obj;
+		}
+
+		default:
+			return Undefined(isolate);
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool JSMessage::CanDetach(Isolate* isolate, const Handle<ArrayBuffer>& buffer)
+	{
+		if (buffer->IsExternal() == false)
+		{
+			return true;
+		}
+
+		std::lock_guard<std::mutex> lock(attached_mutex_);
+		for (unsigned int i = 0; i < attached_.size(); ++i)
+		{
+			if (attached_.at(i)->isolate == isolate && attached_.at(i)->handle == buffer)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool JSMessage::Detach(Isolate* isolate, const Handle<ArrayBuffer>& buffer, Buffer* contents)
+	{
+		if (buffer->IsExternal() == false)
+		{
+			ArrayBuffer::Contents external = buffer->Externalize();
+			contents->data = external.Data();
+			contents->length = external.ByteLength();
+
+			buffer->Neuter();
+			return true;
+		}
+
+		AttachedBuffer* attached = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(attached_mutex_);
+			for (unsigned int i = 0; i < attached_.size(); ++i)
+			{
+				if (attached_.at(i)->isolate == isolate && attached_.at(i)->handle == buffer)
+				{
+					attached = attached_.at(i);
+					attached_.erase(attached_.begin() + i);
+					break;
+				}
+			}
+		}
+
+		if (attached == nullptr)
+		{
+			return false;
+		}
+
+		*contents = attached->contents;
+		attached->handle.ClearWeak();
+		attached->handle.Reset();
+		delete attached;
+
+		buffer->Neuter();
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	Local<ArrayBuffer> JSMessage::Attach(Isolate* isolate, const Buffer& contents)
+	{
+		Local<ArrayBuffer> buffer = ArrayBuffer::New(isolate, contents.data, contents.length);
+
+		AttachedBuffer* attached = new AttachedBuffer();
+		attached->isolate = isolate;
+		attached->contents = contents;
+		attached->handle.Reset(isolate, buffer);
+		attached->handle.SetWeak(attached, OnAttachedCollected);
+
+		std::lock_guard<std::mutex> lock(attached_mutex_);
+		attached_.push_back(attached);
+
+		return buffer;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSMessage::ReleaseBuffers(Isolate* isolate)
+	{
+		std::lock_guard<std::mutex> lock(attached_mutex_);
+		AttachedBuffer* attached = nullptr;
+
+		for (int i = static_cast<int>(attached_.size()) - 1; i >= 0; --i)
+		{
+			attached = attached_.at(i);
+			if (attached->isolate != isolate)
+			{
+				continue;
+			}
+
+			attached->handle.ClearWeak();
+			attached->handle.Reset();
+			JSAllocator::Instance()->Free(attached->contents.data, attached->contents.length);
+
+			delete attached;
+			attached_.erase(attached_.begin() + i);
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	JSMessage::~JSMessage()
+	{
+		for (unsigned int i = 0; i < buffers_.size(); ++i)
+		{
+			if (buffers_.at(i).data != nullptr)
+			{
+				JSAllocator::Instance()->Free(buffers_.at(i).data, buffers_.at(i).length);
+			}
+		}
+	}
+}
\ No newline at end of file
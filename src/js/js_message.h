@@ -0,0 +1,171 @@
+#pragma once
+
+#include <v8.h>
+
+#include <string>
+#include <vector>
+#include <map>
+
+namespace snuffbox
+{
+	/**
+	* @class snuffbox::JSMessage
+	* @brief A structured clone of a JavaScript value that can be passed between isolates, ArrayBuffers can be transferred instead of copied
+	* @author Danil Konings
+	*/
+	class JSMessage
+	{
+	public:
+		/**
+		* @enum snuffbox::JSMessage::Types
+		* @brief The different value types a message can contain
+		* @author Danil Konings
+		*/
+		enum Types
+		{
+			kUndefined,
+			kNull,
+			kBoolean,
+			kNumber,
+			kString,
+			kArray,
+			kObject,
+			kArrayBuffer,
+			kTransferred,
+			kView,
+			kReference
+		};
+
+		/**
+		* @enum snuffbox::JSMessage::Views
+		* @brief The different typed array views a message can contain
+		* @author Danil Konings
+		*/
+		enum Views
+		{
+			kInt8,
+			kUint8,
+			kUint8Clamped,
+			kInt16,
+			kUint16,
+			kInt32,
+			kUint32,
+			kFloat32,
+			kFloat64,
+			kDataView
+		};
+
+		/**
+		* @struct snuffbox::JSMessage::Node
+		* @brief A single value in the cloned value tree
+		* @author Danil Konings
+		*/
+		struct Node
+		{
+			/// Default constructor
+			Node() : type(kUndefined), number(0.0), index(0), offset(0), length(0){}
+
+			Types type; //!< The type of this value
+			double number; //!< The numerical value, or boolean value for booleans
+			std::string data; //!< The string value, or the copied bytes for ArrayBuffers
+			int index; //!< The referenced object for references, the transferred buffer for transferred ArrayBuffers, the view type for views
+			size_t offset; //!< The byte offset of a view
+			size_t length; //!< The element length of a view
+			std::vector<std::string> keys; //!< The keys of an object
+			std::vector<Node> children; //!< The elements of an array or object, or the buffer of a view
+		};
+
+		/**
+		* @struct snuffbox::JSMessage::Buffer
+		* @brief The contents of a transferred ArrayBuffer, owned by the message until it is read
+		* @author Danil Konings
+		*/
+		struct Buffer
+		{
+			void* data; //!< The backing store, allocated by the snuffbox::JSAllocator
+			size_t length; //!< The length in bytes
+		};
+
+	public:
+		/// Default constructor
+		JSMessage();
+
+		/// Default destructor, frees any transferred buffers that were never read
+		~JSMessage();
+
+		/**
+		* @brief Clones a value into this message
+		* @param[in] isolate (v8::Isolate*) The isolate the value lives in
+		* @param[in] value (const v8::Handle<v8::Value>&) The value to clone
+		* @param[in] transfer (const v8::Handle<v8::Value>&) An array of ArrayBuffers to transfer instead of copy, can be undefined
+		* @param[out] error (std::string*) The reason the value could not be cloned
+		* @return bool Was the value succesfully cloned?
+		*/
+		bool Write(v8::Isolate* isolate, const v8::Handle<v8::Value>& value, const v8::Handle<v8::Value>& transfer, std::string* error);
+
+		/**
+		* @brief Creates the cloned value in a given isolate, transferred buffers are handed over to that isolate
+		* @param[in] isolate (v8::Isolate*) The isolate to create the value in, must have an entered context
+		* @return v8::Local<v8::Value> The created value
+		*/
+		v8::Local<v8::Value> Read(v8::Isolate* isolate);
+
+		/**
+		* @brief Frees all transferred buffers that are still alive in an isolate, should be called before disposing it
+		* @param[in] isolate (v8::Isolate*) The isolate that is being disposed
+		*/
+		static void ReleaseBuffers(v8::Isolate* isolate);
+
+	private:
+		/**
+		* @brief Clones a single value into a node
+		* @param[in] isolate (v8::Isolate*) The isolate the value lives in
+		* @param[in] value (const v8::Handle<v8::Value>&) The value to clone
+		* @param[out] node (snuffbox::JSMessage::Node*) The node to write to
+		* @param[out] error (std::string*) The reason the value could not be cloned
+		* @return bool Was the value succesfully cloned?
+		*/
+		bool WriteNode(v8::Isolate* isolate, const v8::Handle<v8::Value>& value, Node* node, std::string* error);
+
+		/**
+		* @brief Creates a value from a node
+		* @param[in] isolate (v8::Isolate*) The isolate to create the value in
+		* @param[in] node (const snuffbox::JSMessage::Node&) The node to read
+		* @return v8::Local<v8::Value> The created value
+		*/
+		v8::Local<v8::Value> ReadNode(v8::Isolate* isolate, const Node& node);
+
+		/**
+		* @brief Checks whether an ArrayBuffer can be detached, without detaching it
+		* @param[in] isolate (v8::Isolate*) The isolate the buffer lives in
+		* @param[in] buffer (const v8::Handle<v8::ArrayBuffer>&) The buffer to check
+		* @return bool Can the buffer be detached? Buffers that alias native memory can't be
+		*/
+		static bool CanDetach(v8::Isolate* isolate, const v8::Handle<v8::ArrayBuffer>& buffer);
+
+		/**
+		* @brief Detaches an ArrayBuffer from its isolate so that its contents can be transferred
+		* @param[in] isolate (v8::Isolate*) The isolate the buffer lives in
+		* @param[in] buffer (const v8::Handle<v8::ArrayBuffer>&) The buffer to detach
+		* @param[out] contents (snuffbox::JSMessage::Buffer*) The detached contents
+		* @return bool Could the buffer be detached? Buffers that alias native memory can't be
+		*/
+		static bool Detach(v8::Isolate* isolate, const v8::Handle<v8::ArrayBuffer>& buffer, Buffer* contents);
+
+		/**
+		* @brief Wraps transferred contents in an ArrayBuffer owned by an isolate
+		* @param[in] isolate (v8::Isolate*) The isolate to attach to
+		* @param[in] contents (const snuffbox::JSMessage::Buffer&) The contents to attach
+		* @return v8::Local<v8::ArrayBuffer> The created buffer
+		*/
+		static v8::Local<v8::ArrayBuffer> Attach(v8::Isolate* isolate, const Buffer& contents);
+
+	private:
+		Node root_; //!< The root value of this message
+		std::vector<Buffer> buffers_; //!< The transferred buffers of this message
+		std::vector<v8::Local<v8::Object>> objects_; //!< The objects that were visited during a write or created during a read, used for references
+		std::multimap<int, size_t> identities_; //!< The visited objects by identity hash during a write, maps to indices in snuffbox::JSMessage::objects_
+		std::vector<v8::Local<v8::ArrayBuffer>> transfer_; //!< The buffers to transfer during a write
+		std::vector<std::pair<Node*, v8::Local<v8::ArrayBuffer>>> detach_; //!< The nodes of the buffers that will be detached once the whole value has been cloned
+	};
+}
\ No newline at end of file
@@ -0,0 +1,297 @@
+#include "../js/js_module_registry.h"
+#include "../js/js_state_wrapper.h"
+
+#include "../application/logging.h"
+#include "../application/game.h"
+
+#include "../platform/platform_text_file.h"
+#include "../content/content_manager.h"
+
+#include "../memory/allocated_memory.h"
+
+using namespace v8;
+
+namespace snuffbox
+{
+	//-------------------------------------------------------------------------------------------
+	JSModuleRegistry::JSModuleRegistry()
+	{
+
+	}
+
+	//-------------------------------------------------------------------------------------------
+	JSModuleRegistry* JSModuleRegistry::Instance()
+	{
+		static SharedPtr<JSModuleRegistry> registry = AllocatedMemory::Instance().Construct<JSModuleRegistry>();
+		return registry.get();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	Local<Value> JSModuleRegistry::Require(const std::string& path)
+	{
+		Isolate* isolate = JSStateWrapper::Instance()->isolate();
+		EscapableHandleScope scope(isolate);
+
+		SharedPtr<Module> module;
+		bool first = false;
+
+		std::map<std::string, SharedPtr<Module>>::iterator it = modules_.find(path);
+		if (it == modules_.end())
+		{
+			module = AllocatedMemory::Instance().Construct<Module>();
+			modules_.emplace(path, module);
+			first = true;
+		}
+		else
+		{
+			module = it->second;
+		}
+
+		if (loading_.empty() == false)
+		{
+			const std::string& parent = loading_.back();
+			modules_.find(parent)->second->dependencies.insert(path);
+			module->dependents.insert(parent);
+		}
+
+		switch (module->state)
+		{
+		case States::kLoading:
+			SNUFF_LOG_WARNING("Circular require " + Chain(path) + ", the exports of '" + path + "' are incomplete at this point");
+			break;
+
+		case States::kUnloaded:
+			if (module->script.IsEmpty() == true && Compile(path, module.get()) == false)
+			{
+				module->state = States::kFailed;
+				break;
+			}
+
+			Evaluate(path, module.get());
+			break;
+
+		default:
+			break;
+		}
+
+		if (first == true)
+		{
+			ContentManager::Instance()->Notify(ContentManager::Events::kLoad, ContentTypes::kScript, path);
+		}
+
+		if (module->exports.IsEmpty() == true)
+		{
+			return scope.Escape(Local<Value>::New(isolate, Undefined(isolate)));
+		}
+
+		return scope.Escape(Local<Value>::New(isolate, module->exports));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool JSModuleRegistry::Reload(const std::string& path)
+	{
+		std::map<std::string, SharedPtr<Module>>::iterator it = modules_.find(path);
+		if (it == modules_.end())
+		{
+			return false;
+		}
+
+		HandleScope scope(JSStateWrapper::Instance()->isolate());
+
+		Module* module = it->second.get();
+		module->script.Reset();
+		module->state = States::kUnloaded;
+
+		std::vector<std::string> stale;
+		stale.push_back(path);
+		Invalidate(path, &stale);
+
+		// Dependents require their stale dependencies again while being evaluated, so every module is evaluated after the modules it depends on
+		for (unsigned int i = 0; i < stale.size(); ++i)
+		{
+			module = modules_.find(stale.at(i))->second.get();
+
+			if (module->state != States::kUnloaded)
+			{
+				continue;
+			}
+
+			if (module->script.IsEmpty() == true && Compile(stale.at(i), module) == false)
+			{
+				module->state = States::kFailed;
+				continue;
+			}
+
+			Evaluate(stale.at(i), module);
+		}
+
+		SNUFF_LOG_INFO("Hot reloaded module '" + path + "' and " + std::to_string(stale.size() - 1) + " dependent module(s)");
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool JSModuleRegistry::Contains(const std::string& path) const
+	{
+		return modules_.find(path) != modules_.end();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSModuleRegistry::Clear()
+	{
+		modules_.clear();
+		loading_.clear();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool JSModuleRegistry::Compile(const std::string& path, Module* module)
+	{
+		JSStateWrapper* wrapper = JSStateWrapper::Instance();
+		Isolate* isolate = wrapper->isolate();
+		HandleScope scope(isolate);
+
+		TextFile file;
+
+		std::string full_path = Game::Instance()->path() + "/" + path;
+		bool success = file.Open(full_path);
+
+		SNUFF_XASSERT(success == true, "The file '" + path + "' could not be opened!", "JSModuleRegistry::Compile");
+
+		TryCatch try_catch;
+
+		ScriptOrigin origin(String::NewFromUtf8(isolate, path.c_str()));
+		ScriptCompiler::Source source(String::NewFromUtf8(isolate, file.Read().c_str()), origin);
+		Local<UnboundScript> script = ScriptCompiler::CompileUnbound(isolate, &source);
+
+		if (script.IsEmpty() == true)
+		{
+			std::string error;
+			if (wrapper->GetException(&try_catch, &error) == true)
+			{
+				SNUFF_LOG_ERROR(error);
+			}
+
+			return false;
+		}
+
+		module->script.Reset(isolate, script);
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool JSModuleRegistry::Evaluate(const std::string& path, Module* module)
+	{
+		JSStateWrapper* wrapper = JSStateWrapper::Instance();
+		Isolate* isolate = wrapper->isolate();
+		HandleScope scope(isolate);
+
+		Local<Object> global = wrapper->global();
+		Local<String> module_key = String::NewFromUtf8(isolate, "module");
+		Local<String> exports_key = String::NewFromUtf8(isolate, "exports");
+
+		Local<Value> previous_module = global->Get(module_key);
+		Local<Value> previous_exports = global->Get(exports_key);
+
+		Local<Object> module_object = Object::New(isolate);
+		Local<Object> exports = Object::New(isolate);
+		module_object->Set(exports_key, exports);
+
+		for (std::set<std::string>::iterator it = module->dependencies.begin(); it != module->dependencies.end(); ++it)
+		{
+			std::map<std::string, SharedPtr<Module>>::iterator dependency = modules_.find(*it);
+			if (dependency != modules_.end())
+			{
+				dependency->second->dependents.erase(path);
+			}
+		}
+
+		module->dependencies.clear();
+		module->exports.Reset(isolate, exports);
+		module->state = States::kLoading;
+
+		global->Set(module_key, module_object);
+		global->Set(exports_key, exports);
+
+		loading_.push_back(path);
+
+		TryCatch try_catch;
+		Local<Value> result = Local<UnboundScript>::New(isolate, module->script)->BindToCurrentContext()->Run();
+
+		loading_.pop_back();
+
+		global->Set(module_key, previous_module);
+		global->Set(exports_key, previous_exports);
+
+		if (result.IsEmpty() == true)
+		{
+			std::string error;
+			if (wrapper->GetException(&try_catch, &error) == true)
+			{
+				SNUFF_LOG_ERROR(error);
+			}
+
+			module->state = States::kFailed;
+			return false;
+		}
+
+		module->exports.Reset(isolate, module_object->Get(exports_key));
+		module->state = States::kLoaded;
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSModuleRegistry::Invalidate(const std::string& path, std::vector<std::string>* stale)
+	{
+		std::map<std::string, SharedPtr<Module>>::iterator it = modules_.find(path);
+		if (it == modules_.end())
+		{
+			return;
+		}
+
+		std::set<std::string>& dependents = it->second->dependents;
+		Module* dependent = nullptr;
+
+		for (std::set<std::string>::iterator dep = dependents.begin(); dep != dependents.end(); ++dep)
+		{
+			dependent = modules_.find(*dep)->second.get();
+
+			if (dependent->state == States::kUnloaded)
+			{
+				continue;
+			}
+
+			dependent->state = States::kUnloaded;
+			stale->push_back(*dep);
+
+			Invalidate(*dep, stale);
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	std::string JSModuleRegistry::Chain(const std::string& path) const
+	{
+		std::string result;
+		bool found = false;
+
+		for (unsigned int i = 0; i < loading_.size(); ++i)
+		{
+			if (loading_.at(i) == path)
+			{
+				found = true;
+			}
+
+			if (found == true)
+			{
+				result += "'" + loading_.at(i) + "' -> ";
+			}
+		}
+
+		return result + "'" + path + "'";
+	}
+
+	//-------------------------------------------------------------------------------------------
+	JSModuleRegistry::~JSModuleRegistry()
+	{
+
+	}
+}
\ No newline at end of file
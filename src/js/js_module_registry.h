@@ -0,0 +1,128 @@
+#pragma once
+
+#include <v8.h>
+
+#include <string>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "../memory/shared_ptr.h"
+
+namespace snuffbox
+{
+	/**
+	* @class snuffbox::JSModuleRegistry
+	* @brief Keeps track of every module loaded through 'require', modules are compiled and evaluated once and their exports are cached
+	* @remarks A module runs in the global scope like any other script, but has 'module' and 'exports' available while it is being evaluated
+	* @author Danil Konings
+	*/
+	class JSModuleRegistry
+	{
+	public:
+		/**
+		* @enum snuffbox::JSModuleRegistry::States
+		* @brief The different states a module can be in
+		* @author Danil Konings
+		*/
+		enum States
+		{
+			kUnloaded,
+			kLoading,
+			kLoaded,
+			kFailed
+		};
+
+		/**
+		* @struct snuffbox::JSModuleRegistry::Module
+		* @brief A single module, its compiled script, its exports and the modules it is related to
+		* @author Danil Konings
+		*/
+		struct Module
+		{
+			/// Default constructor
+			Module() : state(kUnloaded){}
+
+			/// Default destructor, releases the persistent handles
+			~Module(){ script.Reset(); exports.Reset(); }
+
+			States state; //!< The current state of this module
+			v8::Persistent<v8::UnboundScript> script; //!< The compiled script of this module, recompiled only when the file changed
+			v8::Persistent<v8::Value> exports; //!< The cached exports of this module
+			std::set<std::string> dependencies; //!< The modules this module requires
+			std::set<std::string> dependents; //!< The modules that require this module
+		};
+
+	public:
+		/// Default constructor
+		JSModuleRegistry();
+
+		/**
+		* @brief Retrieves the singleton instance of this class
+		* @return snuffbox::JSModuleRegistry* The pointer to the singleton
+		*/
+		static JSModuleRegistry* Instance();
+
+		/**
+		* @brief Requires a module, evaluating it only if it wasn't loaded yet
+		* @param[in] path (const std::string&) The path of the module file, relative to the game path
+		* @return v8::Local<v8::Value> The exports of the module
+		*/
+		v8::Local<v8::Value> Require(const std::string& path);
+
+		/**
+		* @brief Reloads a changed module and re-evaluates every module that depends on it
+		* @param[in] path (const std::string&) The path of the module file that changed
+		* @return bool Was the path a known module?
+		*/
+		bool Reload(const std::string& path);
+
+		/**
+		* @brief Checks if a path is a known module
+		* @param[in] path (const std::string&) The path of the module file
+		* @return bool Is the module known?
+		*/
+		bool Contains(const std::string& path) const;
+
+		/// Releases all modules, should be called before the isolate is disposed
+		void Clear();
+
+		/// Default destructor
+		~JSModuleRegistry();
+
+	private:
+		/**
+		* @brief Compiles a module from its file
+		* @param[in] path (const std::string&) The path of the module file
+		* @param[in] module (snuffbox::JSModuleRegistry::Module*) The module to compile
+		* @return bool Was the module succesfully compiled?
+		*/
+		bool Compile(const std::string& path, Module* module);
+
+		/**
+		* @brief Evaluates a compiled module, providing it with fresh 'module' and 'exports' objects
+		* @param[in] path (const std::string&) The path of the module file
+		* @param[in] module (snuffbox::JSModuleRegistry::Module*) The module to evaluate
+		* @return bool Was the module succesfully evaluated?
+		*/
+		bool Evaluate(const std::string& path, Module* module);
+
+		/**
+		* @brief Marks every module that directly or indirectly depends on a module as unloaded
+		* @param[in] path (const std::string&) The path of the module
+		* @param[out] stale (std::vector<std::string>*) The modules that were marked, in the order they were found
+		*/
+		void Invalidate(const std::string& path, std::vector<std::string>* stale);
+
+		/**
+		* @brief Creates a readable require chain for cycle errors
+		* @param[in] path (const std::string&) The module that closes the cycle
+		* @return std::string The stringified chain
+		*/
+		std::string Chain(const std::string& path) const;
+
+	private:
+		std::map<std::string, SharedPtr<Module>> modules_; //!< All modules by path
+		std::vector<std::string> loading_; //!< The stack of modules that are currently being evaluated
+	};
+}
\ No newline at end of file
@@ -6,7 +6,7 @@
 
 #define JS_SINGLETON const v8::Handle<v8::Object>&
 #define JS_CONSTRUCTABLE const v8::Handle<v8::ObjectTemplate>&
-#define JS_NAME(name) static const char* js_name(){ return ##name; }
+#define JS_NAME(name) static const char* js_name(){ return name; }
 
 namespace snuffbox
 {
@@ -18,6 +18,9 @@ namespace snuffbox
 	class JSObject
 	{
 	public:
+		/// Default constructor
+		JSObject() : external_memory_(0), reported_memory_(0){};
+
 		virtual ~JSObject(){};
 
     /**
@@ -25,8 +28,27 @@ namespace snuffbox
     */
     v8::Persistent<v8::Object>& object();
 
+    /**
+    * @brief Sets the native memory this object holds on to, V8 is notified of the change once this object is wrapped
+    * @param[in] size (const size_t&) The size in bytes, including buffers and GPU resources
+    */
+    void ReportMemory(const size_t& size);
+
+    /// Notifies V8 of any difference between the native memory of this object and what was last reported
+    void UpdateExternalMemory();
+
+    /// Removes the reported native memory of this object from V8
+    void ReleaseExternalMemory();
+
+    /**
+    * @return const size_t& The native memory this object holds on to in bytes
+    */
+    const size_t& external_memory() const;
+
   private:
     v8::Persistent<v8::Object> object_;
+    size_t external_memory_; //!< The native memory this object holds on to
+    int64_t reported_memory_; //!< The native memory that was last reported to V8
 	};
 
   //---------------------------------------------------------------------------------------------------------
@@ -34,4 +56,44 @@ namespace snuffbox
   {
     return object_;
   }
+
+  //---------------------------------------------------------------------------------------------------------
+  inline void JSObject::ReportMemory(const size_t& size)
+  {
+    external_memory_ = size;
+    UpdateExternalMemory();
+  }
+
+  //---------------------------------------------------------------------------------------------------------
+  inline void JSObject::UpdateExternalMemory()
+  {
+    if (object_.IsEmpty() == true)
+    {
+      return;
+    }
+
+    int64_t difference = static_cast<int64_t>(external_memory_) - reported_memory_;
+
+    if (difference != 0)
+    {
+      JSStateWrapper::Instance()->isolate()->AdjustAmountOfExternalAllocatedMemory(difference);
+      reported_memory_ += difference;
+    }
+  }
+
+  //---------------------------------------------------------------------------------------------------------
+  inline void JSObject::ReleaseExternalMemory()
+  {
+    if (reported_memory_ != 0)
+    {
+      JSStateWrapper::Instance()->isolate()->AdjustAmountOfExternalAllocatedMemory(-reported_memory_);
+      reported_memory_ = 0;
+    }
+  }
+
+  //---------------------------------------------------------------------------------------------------------
+  inline const size_t& JSObject::external_memory() const
+  {
+    return external_memory_;
+  }
 }
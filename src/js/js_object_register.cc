@@ -2,17 +2,23 @@
 
 #include "../application/game.h"
 #include "../application/logging.h"
+#include "../application/scheduler.h"
+#include "../application/job_system.h"
+#include "../application/system_scheduler.h"
+#include "../application/replay.h"
 
 #include "../cvar/cvar.h"
 
 #include "../input/keyboard.h"
 #include "../input/mouse.h"
-#include "../input/mouse_area.h"
 
 #include "../content/content_manager.h"
 
 #include "../io/io_manager.h"
 
+#ifndef SNUFF_BUILD_NULL
+#include "../input/mouse_area.h"
+
 #include "../d3d11/d3d11_render_target.h"
 #include "../d3d11/d3d11_render_settings.h"
 #include "../d3d11/d3d11_camera.h"
@@ -30,9 +36,13 @@
 #include "../d3d11/elements/d3d11_polygon_element.h"
 #include "../d3d11/elements/particles/d3d11_particle_system.h"
 
-#include "../js/js_object_register.h"
-
 #include "../platform/platform_window.h"
+#endif
+
+#include "../js/js_object_register.h"
+#include "../js/js_profiler.h"
+#include "../js/js_worker.h"
+#include "../js/js_pool.h"
 
 #include "../fmod/fmod_sound_system.h"
 
@@ -48,16 +58,28 @@ namespace snuffbox
 		JSObjectRegister<Mouse>::RegisterSingleton();
 		JSObjectRegister<ContentManager>::RegisterSingleton();
 		JSObjectRegister<IOManager>::RegisterSingleton();
+#ifndef SNUFF_BUILD_NULL
     JSObjectRegister<D3D11RenderSettings>::RegisterSingleton();
 		JSObjectRegister<D3D11Lighting>::RegisterSingleton();
 		JSObjectRegister<D3D11Uniforms>::RegisterSingleton();
     JSObjectRegister<Window>::RegisterSingleton();
+#endif
     JSObjectRegister<SoundSystem>::RegisterSingleton();
+		JSObjectRegister<JSProfiler>::RegisterSingleton();
+		JSObjectRegister<Scheduler>::RegisterSingleton();
+		JSObjectRegister<JobSystem>::RegisterSingleton();
+		JSObjectRegister<SystemScheduler>::RegisterSingleton();
+		JSObjectRegister<Replay>::RegisterSingleton();
   }
 
   //-------------------------------------------------------------------------------------------
   void JSRegister::RegisterConstructables()
   {
+		JSObjectRegister<JSWorker>::Register();
+		JSObjectRegister<JSPool>::Register();
+		JSPool::RegisterCreate();
+
+#ifndef SNUFF_BUILD_NULL
     JSObjectRegister<MouseArea>::Register();
 
 		JSObjectRegister<D3D11RenderTarget>::Register();
@@ -75,6 +97,7 @@ namespace snuffbox
 		JSObjectRegister<D3D11ParticleSystem>::Register();
 
 		JSObjectRegister<SpriteAnimation>::Register();
+#endif
   }
 
   //-------------------------------------------------------------------------------------------
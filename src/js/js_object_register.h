@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../js/js_wrapper.h"
+#include "../application/logging.h"
 
 namespace snuffbox
 {
@@ -42,6 +43,9 @@ namespace snuffbox
 		/// Uses to set the to string function of each Snuffbox exposed class
 		template <typename Y>
 		static void ToString(JS_ARGS args);
+
+		/// Destructs the object before it is garbage collected, exposed as 'dispose' on every constructable
+		static void Dispose(JS_ARGS args);
   };
 
   //---------------------------------------------------------------------------------------------------------
@@ -57,6 +61,8 @@ namespace snuffbox
     T::RegisterJS(object);
 
 		object->Set(v8::String::NewFromUtf8(isolate, "toString"), v8::Function::New(isolate, JSObjectRegister::ToString<T>));
+    JSFunctionRegister::QualifyNames(object, T::js_name());
+
     wrapper->RegisterGlobal(T::js_name(), object);
   }
 
@@ -73,10 +79,14 @@ namespace snuffbox
     T::RegisterJS(object->PrototypeTemplate());
 
 		object->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "toString"), v8::Function::New(isolate, JSObjectRegister::ToString<T>));
+		object->PrototypeTemplate()->Set(isolate, "dispose", v8::FunctionTemplate::New(isolate, JSObjectRegister::Dispose));
     object->SetCallHandler(JSStateWrapper::JSNew<T>);
     object->SetClassName(v8::String::NewFromUtf8(isolate, T::js_name()));
 
-    wrapper->RegisterGlobal(T::js_name(), object->GetFunction());
+    v8::Local<v8::Function> func = object->GetFunction();
+    JSFunctionRegister::QualifyNames(func->Get(v8::String::NewFromUtf8(isolate, "prototype"))->ToObject(), T::js_name());
+
+    wrapper->RegisterGlobal(T::js_name(), func);
   }
 
 	//---------------------------------------------------------------------------------------------------------
@@ -87,4 +97,33 @@ namespace snuffbox
 
 		wrapper.ReturnValue<std::string>(Y::js_name());
 	}
+
+	//---------------------------------------------------------------------------------------------------------
+	template <typename T>
+	inline void JSObjectRegister<T>::Dispose(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+
+		// The hidden pointer holds a T*, which is not the address of the JSObject base when JSObject is not the first base of T
+		T* self = wrapper.GetPointer<T>(args.This());
+
+		if (self == nullptr)
+		{
+			SNUFF_LOG_WARNING("Attempted to dispose an object that was already disposed");
+			return;
+		}
+
+		v8::Isolate* isolate = args.GetIsolate();
+		v8::Local<v8::Object> obj = args.This();
+		JSObject* ptr = static_cast<JSObject*>(self);
+
+		ptr->ReleaseExternalMemory();
+		ptr->object().ClearWeak();
+		ptr->object().Reset();
+		AllocatedMemory::Instance().Destruct<T>(self);
+
+		// Detach the prototype, so calling a method on a disposed object throws instead of using a destructed pointer
+		obj->SetHiddenValue(v8::String::NewFromUtf8(isolate, "__ptr"), v8::Null(isolate));
+		obj->SetPrototype(v8::Object::New(isolate));
+	}
 }
\ No newline at end of file
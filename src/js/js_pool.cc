@@ -0,0 +1,251 @@
+#include "../js/js_pool.h"
+
+#include "../application/logging.h"
+
+using namespace v8;
+
+namespace snuffbox
+{
+	//-------------------------------------------------------------------------------------------
+	static const char* kPoolKey = "__pool";
+	static const char* kPoolIndexKey = "__pool_index";
+
+	//-------------------------------------------------------------------------------------------
+	JSPool::JSPool(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		Isolate* isolate = args.GetIsolate();
+
+		objects_.Reset(isolate, Array::New(isolate));
+
+		if (wrapper.Check("S") == false)
+		{
+			return;
+		}
+
+		name_ = wrapper.GetValue<std::string>(0, "undefined");
+		Local<Value> constructor = JSStateWrapper::Instance()->global()->Get(String::NewFromUtf8(isolate, name_.c_str()));
+
+		if (constructor.IsEmpty() == true || constructor->IsFunction() == false)
+		{
+			SNUFF_LOG_ERROR("Could not create a pool of '" + name_ + "', it is not a constructable type");
+			return;
+		}
+
+		constructor_.Reset(isolate, constructor.As<Function>());
+		Reserve(wrapper.GetValue<int>(1, 0));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	Local<Object> JSPool::Acquire()
+	{
+		Isolate* isolate = JSStateWrapper::Instance()->isolate();
+		EscapableHandleScope scope(isolate);
+
+		if (free_.empty() == true && Grow() == false)
+		{
+			return Local<Object>();
+		}
+
+		int index = free_.back();
+		free_.pop_back();
+		in_use_.at(index) = true;
+
+		return scope.Escape(Local<Array>::New(isolate, objects_)->Get(index)->ToObject());
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool JSPool::Release(const Handle<Object>& obj)
+	{
+		Isolate* isolate = JSStateWrapper::Instance()->isolate();
+		HandleScope scope(isolate);
+
+		Local<Value> pool = obj->GetHiddenValue(String::NewFromUtf8(isolate, kPoolKey));
+		if (pool.IsEmpty() == true || pool->IsExternal() == false || pool.As<External>()->Value() != this)
+		{
+			SNUFF_LOG_WARNING("Attempted to release an object into a pool it doesn't belong to");
+			return false;
+		}
+
+		int index = obj->GetHiddenValue(String::NewFromUtf8(isolate, kPoolIndexKey))->Int32Value();
+		if (in_use_.at(index) == false)
+		{
+			SNUFF_LOG_WARNING("Attempted to release an object of a '" + name_ + "' pool that was already released");
+			return false;
+		}
+
+		Local<Value> destroy = obj->Get(String::NewFromUtf8(isolate, "destroy"));
+		if (destroy->IsFunction() == true)
+		{
+			destroy.As<Function>()->Call(obj, 0, nullptr);
+		}
+
+		in_use_.at(index) = false;
+		free_.push_back(index);
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSPool::Reserve(const int& size)
+	{
+		while (static_cast<int>(in_use_.size()) < size)
+		{
+			if (Grow() == false)
+			{
+				return;
+			}
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool JSPool::Grow()
+	{
+		if (constructor_.IsEmpty() == true)
+		{
+			return false;
+		}
+
+		Isolate* isolate = JSStateWrapper::Instance()->isolate();
+		HandleScope scope(isolate);
+
+		Local<Object> obj = Local<Function>::New(isolate, constructor_)->NewInstance();
+		if (obj.IsEmpty() == true)
+		{
+			SNUFF_LOG_ERROR("Could not create a new instance of '" + name_ + "' for a pool");
+			return false;
+		}
+
+		int index = static_cast<int>(in_use_.size());
+
+		obj->SetHiddenValue(String::NewFromUtf8(isolate, kPoolKey), External::New(isolate, this));
+		obj->SetHiddenValue(String::NewFromUtf8(isolate, kPoolIndexKey), Integer::New(isolate, index));
+
+		Local<Array>::New(isolate, objects_)->Set(index, obj);
+		in_use_.push_back(false);
+		free_.push_back(index);
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	int JSPool::size() const
+	{
+		return static_cast<int>(in_use_.size());
+	}
+
+	//-------------------------------------------------------------------------------------------
+	int JSPool::available() const
+	{
+		return static_cast<int>(free_.size());
+	}
+
+	//-------------------------------------------------------------------------------------------
+	JSPool::~JSPool()
+	{
+		constructor_.Reset();
+		objects_.Reset();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSPool::RegisterJS(JS_CONSTRUCTABLE obj)
+	{
+		JSFunctionRegister funcs[] = {
+			{ "acquire", JSAcquire },
+			{ "release", JSRelease },
+			{ "reserve", JSReserve },
+			{ "size", JSSize },
+			{ "available", JSAvailable }
+		};
+
+		JSFunctionRegister::Register(funcs, sizeof(funcs) / sizeof(JSFunctionRegister), obj);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSPool::RegisterCreate()
+	{
+		JSStateWrapper* wrapper = JSStateWrapper::Instance();
+		Isolate* isolate = wrapper->isolate();
+		HandleScope scope(isolate);
+
+		Local<Value> constructor = wrapper->global()->Get(String::NewFromUtf8(isolate, js_name()));
+		constructor->ToObject()->Set(String::NewFromUtf8(isolate, "create"), Function::New(isolate, JSCreate));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSPool::JSCreate(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		if (wrapper.Check("S") == false)
+		{
+			return;
+		}
+
+		Isolate* isolate = args.GetIsolate();
+		Local<Function> constructor = JSStateWrapper::Instance()->global()->Get(String::NewFromUtf8(isolate, js_name())).As<Function>();
+
+		Handle<Value> argv[] = { args[0], args[1] };
+		args.GetReturnValue().Set(constructor->NewInstance(2, argv));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSPool::JSAcquire(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		JSPool* self = wrapper.GetPointer<JSPool>(args.This());
+
+		Local<Object> obj = self->Acquire();
+		if (obj.IsEmpty() == true)
+		{
+			return;
+		}
+
+		wrapper.ReturnValue<Handle<Object>>(obj);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSPool::JSRelease(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		JSPool* self = wrapper.GetPointer<JSPool>(args.This());
+
+		if (wrapper.Check("O") == false)
+		{
+			return;
+		}
+
+		wrapper.ReturnValue<bool>(self->Release(args[0]->ToObject()));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSPool::JSReserve(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		JSPool* self = wrapper.GetPointer<JSPool>(args.This());
+
+		if (wrapper.Check("N") == false)
+		{
+			return;
+		}
+
+		self->Reserve(wrapper.GetValue<int>(0, 0));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSPool::JSSize(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		JSPool* self = wrapper.GetPointer<JSPool>(args.This());
+
+		wrapper.ReturnValue<int>(self->size());
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSPool::JSAvailable(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		JSPool* self = wrapper.GetPointer<JSPool>(args.This());
+
+		wrapper.ReturnValue<int>(self->available());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "../js/js_object.h"
+
+#include <vector>
+
+namespace snuffbox
+{
+	/**
+	* @class snuffbox::JSPool
+	* @brief Recycles instances of an exposed class, pooled objects are kept alive by the pool so spawning and despawning never goes through the garbage collector
+	* @author Danil Konings
+	*/
+	class JSPool : public JSObject
+	{
+	public:
+		/**
+		* @brief Construct through JavaScript, expects the name of the class to pool and optionally the number of instances to create up front
+		* @param[in] args (JS_ARGS) The arguments passed by JavaScript
+		*/
+		JSPool(JS_ARGS args);
+
+		/**
+		* @brief Retrieves a free instance, a new instance is created if there are none left
+		* @return v8::Local<v8::Object> The instance, empty if no instance could be created
+		*/
+		v8::Local<v8::Object> Acquire();
+
+		/**
+		* @brief Returns an instance to the pool, render elements are destroyed so they stop rendering
+		* @param[in] obj (const v8::Handle<v8::Object>&) The instance to return
+		* @return bool Was the object an instance in use by this pool?
+		*/
+		bool Release(const v8::Handle<v8::Object>& obj);
+
+		/**
+		* @brief Creates new instances until the pool holds a given number of instances
+		* @param[in] size (const int&) The number of instances the pool should hold
+		*/
+		void Reserve(const int& size);
+
+		/**
+		* @return int The number of instances this pool holds
+		*/
+		int size() const;
+
+		/**
+		* @return int The number of instances that are free to acquire
+		*/
+		int available() const;
+
+		/// Default destructor, the instances become collectable
+		virtual ~JSPool();
+
+	private:
+		/**
+		* @brief Creates a new instance and adds it to the free list
+		* @return bool Was the instance created?
+		*/
+		bool Grow();
+
+	private:
+		std::string name_; //!< The name of the pooled class
+		v8::Persistent<v8::Function> constructor_; //!< The constructor of the pooled class
+		v8::Persistent<v8::Array> objects_; //!< Every instance this pool holds, keeping them alive
+		std::vector<int> free_; //!< The indices of the instances that are free to acquire
+		std::vector<bool> in_use_; //!< Which instances are currently in use?
+
+	public:
+		JS_NAME("Pool");
+		static void RegisterJS(JS_CONSTRUCTABLE obj);
+		static void RegisterCreate();
+		static void JSCreate(JS_ARGS args);
+		static void JSAcquire(JS_ARGS args);
+		static void JSRelease(JS_ARGS args);
+		static void JSReserve(JS_ARGS args);
+		static void JSSize(JS_ARGS args);
+		static void JSAvailable(JS_ARGS args);
+	};
+}
\ No newline at end of file
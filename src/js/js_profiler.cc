@@ -0,0 +1,430 @@
+#include <v8-profiler.h>
+
+#include "../js/js_profiler.h"
+#include "../js/js_callback.h"
+
+#include "../application/logging.h"
+#include "../application/cpu_profiler.h"
+#include "../cvar/cvar.h"
+#include "../io/io_manager.h"
+
+#include "../memory/allocated_memory.h"
+#include "../memory/shared_ptr.h"
+
+#include <chrono>
+
+using namespace v8;
+
+namespace snuffbox
+{
+	//-------------------------------------------------------------------------------------------
+	static const char* kProfileTitle = "snuffbox";
+
+	//-------------------------------------------------------------------------------------------
+	JSProfiler::JSProfiler() :
+		running_(false),
+		frames_(0),
+		interval_(1000),
+		launch_path_("launch.cpuprofile")
+	{
+
+	}
+
+	//-------------------------------------------------------------------------------------------
+	JSProfiler* JSProfiler::Instance()
+	{
+		static SharedPtr<JSProfiler> profiler = AllocatedMemory::Instance().Construct<JSProfiler>();
+		return profiler.get();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSProfiler::Initialise()
+	{
+		CVar* cvar = CVar::Instance();
+		bool found = false;
+
+		CVar::Value* interval = cvar->Get("profile_interval", &found);
+		if (found == true && interval->IsNumber() == true)
+		{
+			interval_ = static_cast<int>(interval->As<CVar::Number>()->value());
+		}
+
+		CVar::Value* path = cvar->Get("profile_path", &found);
+		if (found == true && path->IsString() == true)
+		{
+			launch_path_ = path->As<CVar::String>()->value();
+		}
+
+		CVar::Value* frames = cvar->Get("profile_frames", &found);
+		if (found == false || frames->IsNumber() == false)
+		{
+			return;
+		}
+
+		frames_ = static_cast<int>(frames->As<CVar::Number>()->value());
+
+		if (frames_ > 0 && Start() == true)
+		{
+			SNUFF_LOG_INFO("Profiling the first " + std::to_string(frames_) + " frames to '" + launch_path_ + "'");
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool JSProfiler::Start()
+	{
+		if (running_ == true)
+		{
+			SNUFF_LOG_WARNING("Attempted to start the profiler, but it is already running");
+			return false;
+		}
+
+		Isolate* isolate = JSStateWrapper::Instance()->isolate();
+		HandleScope scope(isolate);
+
+		CpuProfiler* profiler = isolate->GetCpuProfiler();
+		profiler->SetSamplingInterval(interval_);
+		profiler->StartProfiling(String::NewFromUtf8(isolate, kProfileTitle), true);
+
+		running_ = true;
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool JSProfiler::Stop(const std::string& path)
+	{
+		if (running_ == false)
+		{
+			SNUFF_LOG_WARNING("Attempted to stop the profiler, but it was never started");
+			return false;
+		}
+
+		Isolate* isolate = JSStateWrapper::Instance()->isolate();
+		HandleScope scope(isolate);
+
+		CpuProfile* profile = isolate->GetCpuProfiler()->StopProfiling(String::NewFromUtf8(isolate, kProfileTitle));
+		running_ = false;
+		frames_ = 0;
+
+		if (profile == nullptr)
+		{
+			SNUFF_LOG_ERROR("The CPU profiler did not return a profile");
+			return false;
+		}
+
+		bool success = IOManager::Instance()->Write(path, Serialise(profile));
+		profile->Delete();
+
+		if (success == false)
+		{
+			SNUFF_LOG_ERROR("Could not write CPU profile to '" + path + "'");
+			return false;
+		}
+
+		SNUFF_LOG_SUCCESS("Wrote CPU profile to '" + path + "'");
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSProfiler::Update()
+	{
+		if (frames_ <= 0 || running_ == false)
+		{
+			return;
+		}
+
+		if (--frames_ == 0)
+		{
+			Stop(launch_path_);
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	const bool& JSProfiler::running() const
+	{
+		return running_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	std::string JSProfiler::Serialise(const CpuProfile* profile)
+	{
+		std::string result = "{\"nodes\":[";
+		SerialiseNode(profile->GetTopDownRoot(), &result);
+
+		int64_t start = profile->GetStartTime();
+		result += "],\"startTime\":" + std::to_string(start);
+		result += ",\"endTime\":" + std::to_string(profile->GetEndTime());
+
+		int count = profile->GetSamplesCount();
+		std::string samples;
+		std::string deltas;
+
+		int64_t last = start;
+		int64_t timestamp = 0;
+
+		for (int i = 0; i < count; ++i)
+		{
+			if (i > 0)
+			{
+				samples += ",";
+				deltas += ",";
+			}
+
+			timestamp = profile->GetSampleTimestamp(i);
+
+			samples += std::to_string(profile->GetSample(i)->GetNodeId());
+			deltas += std::to_string(timestamp - last);
+
+			last = timestamp;
+		}
+
+		result += ",\"samples\":[" + samples + "],\"timeDeltas\":[" + deltas + "]}";
+		return result;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSProfiler::SerialiseNode(const CpuProfileNode* node, std::string* buffer)
+	{
+		std::string& result = *buffer;
+		std::string name = *String::Utf8Value(node->GetFunctionName());
+		std::string url = *String::Utf8Value(node->GetScriptResourceName());
+
+		if (result.back() != '[')
+		{
+			result += ",";
+		}
+
+		result += "{\"id\":" + std::to_string(node->GetNodeId());
+		result += ",\"callFrame\":{\"functionName\":\"" + Escape(name) + "\"";
+		result += ",\"scriptId\":\"" + std::to_string(node->GetScriptId()) + "\"";
+		result += ",\"url\":\"" + Escape(url) + "\"";
+		result += ",\"lineNumber\":" + std::to_string(node->GetLineNumber() - 1);
+		result += ",\"columnNumber\":" + std::to_string(node->GetColumnNumber() - 1) + "}";
+		result += ",\"hitCount\":" + std::to_string(node->GetHitCount());
+		result += ",\"children\":[";
+
+		int children = node->GetChildrenCount();
+		for (int i = 0; i < children; ++i)
+		{
+			if (i > 0)
+			{
+				result += ",";
+			}
+			result += std::to_string(node->GetChild(i)->GetNodeId());
+		}
+
+		result += "]}";
+
+		for (int i = 0; i < children; ++i)
+		{
+			SerialiseNode(node->GetChild(i), buffer);
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	std::string JSProfiler::Escape(const std::string& str)
+	{
+		std::string result;
+		result.reserve(str.size());
+
+		char c;
+		for (unsigned int i = 0; i < str.size(); ++i)
+		{
+			c = str.at(i);
+
+			switch (c)
+			{
+			case '"':
+				result += "\\\"";
+				break;
+			case '\\':
+				result += "\\\\";
+				break;
+			case '\n':
+				result += "\\n";
+				break;
+			case '\r':
+				result += "\\r";
+				break;
+			case '\t':
+				result += "\\t";
+				break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20)
+				{
+					const char* hex = "0123456789abcdef";
+					result += "\\u00";
+					result += hex[(c >> 4) & 0xF];
+					result += hex[c & 0xF];
+					break;
+				}
+
+				result += c;
+				break;
+			}
+		}
+
+		return result;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSProfiler::BenchmarkCallback(const Handle<Value>& func, const int& iterations, double* uncached, double* cached)
+	{
+		typedef std::chrono::high_resolution_clock Clock;
+
+		Isolate* isolate = JSStateWrapper::Instance()->isolate();
+		HandleScope scope(isolate);
+
+		JSCallback<double> callback;
+		callback.Set(func);
+		callback.set_cacheable(false);
+
+		Clock::time_point start = Clock::now();
+		for (int i = 0; i < iterations; ++i)
+		{
+			callback.Call(static_cast<double>(i));
+		}
+		*uncached = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+
+		callback.set_cacheable(true);
+
+		start = Clock::now();
+		for (int i = 0; i < iterations; ++i)
+		{
+			callback.Call(static_cast<double>(i));
+		}
+		*cached = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	JSProfiler::~JSProfiler()
+	{
+
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSProfiler::RegisterJS(JS_SINGLETON obj)
+	{
+		JSFunctionRegister funcs[] = {
+			{ "start", JSStart },
+			{ "stop", JSStop },
+			{ "running", JSRunning },
+			{ "gcStats", JSGCStats },
+			{ "benchmarkCallback", JSBenchmarkCallback },
+			{ "capture", JSCapture },
+			{ "frameStats", JSFrameStats }
+		};
+
+		JSFunctionRegister::Register(funcs, sizeof(funcs) / sizeof(JSFunctionRegister), obj);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSProfiler::JSStart(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		wrapper.ReturnValue<bool>(JSProfiler::Instance()->Start());
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSProfiler::JSStop(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		if (wrapper.Check("S") == false)
+		{
+			return;
+		}
+
+		wrapper.ReturnValue<bool>(JSProfiler::Instance()->Stop(wrapper.GetValue<std::string>(0, "profile.cpuprofile")));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSProfiler::JSRunning(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		wrapper.ReturnValue<bool>(JSProfiler::Instance()->running());
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSProfiler::JSGCStats(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		const JSStateWrapper::GCStats& stats = JSStateWrapper::Instance()->gc_stats();
+
+		v8::Handle<v8::Object> obj = JSWrapper::CreateObject();
+		JSWrapper::SetObjectValue<double>(obj, "collections", stats.collections);
+		JSWrapper::SetObjectValue<double>(obj, "idleCollections", stats.idle_collections);
+		JSWrapper::SetObjectValue<double>(obj, "gcTime", stats.gc_time);
+		JSWrapper::SetObjectValue<double>(obj, "idleGCTime", stats.idle_gc_time);
+		JSWrapper::SetObjectValue<double>(obj, "idleTime", stats.idle_time);
+		JSWrapper::SetObjectValue<double>(obj, "idleNotifications", stats.idle_notifications);
+		JSWrapper::SetObjectValue<double>(obj, "nativeAllocations", AllocatedMemory::Instance().allocations());
+
+		wrapper.ReturnValue<v8::Handle<v8::Object>>(obj);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSProfiler::JSBenchmarkCallback(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		if (wrapper.Check("F") == false)
+		{
+			return;
+		}
+
+		int iterations = wrapper.GetValue<int>(1, 100000);
+		if (iterations <= 0)
+		{
+			SNUFF_LOG_WARNING("Attempted to benchmark a callback with " + std::to_string(iterations) + " iterations");
+			return;
+		}
+
+		double uncached = 0.0;
+		double cached = 0.0;
+
+		JSProfiler::BenchmarkCallback(args[0], iterations, &uncached, &cached);
+
+		v8::Handle<v8::Object> obj = JSWrapper::CreateObject();
+		JSWrapper::SetObjectValue<double>(obj, "iterations", iterations);
+		JSWrapper::SetObjectValue<double>(obj, "uncached", uncached);
+		JSWrapper::SetObjectValue<double>(obj, "cached", cached);
+
+		wrapper.ReturnValue<v8::Handle<v8::Object>>(obj);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSProfiler::JSCapture(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+		if (wrapper.Check("NS") == false)
+		{
+			return;
+		}
+
+#ifdef SNUFF_BUILD_SHIPPING
+		SNUFF_LOG_WARNING("Profiling markers are compiled out of shipping builds");
+		wrapper.ReturnValue<bool>(false);
+#else
+		wrapper.ReturnValue<bool>(CPUProfiler::Instance()->Capture(wrapper.GetValue<int>(0, 1), wrapper.GetValue<std::string>(1, "capture.json")));
+#endif
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSProfiler::JSFrameStats(JS_ARGS args)
+	{
+		JSWrapper wrapper(args);
+
+		const std::map<std::string, CPUProfiler::Stat>& stats = CPUProfiler::Instance()->last_frame();
+		v8::Handle<v8::Object> obj = JSWrapper::CreateObject();
+		v8::Handle<v8::Object> stat;
+
+		for (std::map<std::string, CPUProfiler::Stat>::const_iterator it = stats.begin(); it != stats.end(); ++it)
+		{
+			stat = JSWrapper::CreateObject();
+			JSWrapper::SetObjectValue<double>(stat, "time", it->second.time);
+			JSWrapper::SetObjectValue<double>(stat, "calls", it->second.calls);
+
+			JSWrapper::SetObjectValue<v8::Handle<v8::Object>>(obj, it->first, stat);
+		}
+
+		wrapper.ReturnValue<v8::Handle<v8::Object>>(obj);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "../js/js_object.h"
+
+namespace v8
+{
+	class CpuProfile;
+	class CpuProfileNode;
+}
+
+namespace snuffbox
+{
+	/**
+	* @class snuffbox::JSProfiler
+	* @brief A sampling CPU profiler for JavaScript built on top of V8's CPU profiler, outputs .cpuprofile files that can be loaded in the Chrome DevTools
+	* @author Danil Konings
+	*/
+	class JSProfiler : public JSObject
+	{
+	public:
+		/// Default constructor
+		JSProfiler();
+
+		/**
+		* @brief Retrieves the singleton instance of this class
+		* @return snuffbox::JSProfiler* The pointer to the singleton
+		*/
+		static JSProfiler* Instance();
+
+		/// Default destructor
+		virtual ~JSProfiler();
+
+		/// Reads the profiling CVars and starts profiling from launch if 'profile_frames' was set
+		void Initialise();
+
+		/**
+		* @brief Starts profiling
+		* @return bool Was the profiler started? Returns false if there was already a profile running
+		*/
+		bool Start();
+
+		/**
+		* @brief Stops profiling and writes the result to a .cpuprofile file
+		* @param[in] path (const std::string&) The path to write the profile to, relative to the game path
+		* @return bool Was the profile succesfully written?
+		*/
+		bool Stop(const std::string& path);
+
+		/// Counts the frames of a launch profile and stops it when the requested number of frames has been reached
+		void Update();
+
+		/**
+		* @return const bool& Is the profiler currently running?
+		*/
+		const bool& running() const;
+
+		/**
+		* @brief Converts a V8 CPU profile to the JSON format Chrome DevTools uses
+		* @param[in] profile (const v8::CpuProfile*) The profile to convert
+		* @return std::string The stringified profile
+		*/
+		static std::string Serialise(const v8::CpuProfile* profile);
+
+		/**
+		* @brief Measures the dispatch cost of a snuffbox::JSCallback, both with and without its receiver cached for the frame
+		* @param[in] func (const v8::Handle<v8::Value>&) The function to call, receives the iteration index
+		* @param[in] iterations (const int&) The number of calls to time
+		* @param[out] uncached (double*) The average cost of a call without a frame cache in nanoseconds
+		* @param[out] cached (double*) The average cost of a call with a frame cache in nanoseconds
+		*/
+		static void BenchmarkCallback(const v8::Handle<v8::Value>& func, const int& iterations, double* uncached, double* cached);
+
+	private:
+		/**
+		* @brief Appends a node and all of its children to a JSON node list
+		* @param[in] node (const v8::CpuProfileNode*) The node to append
+		* @param[out] buffer (std::string*) The buffer to append to
+		*/
+		static void SerialiseNode(const v8::CpuProfileNode* node, std::string* buffer);
+
+		/**
+		* @brief Escapes a string for use in a JSON string literal
+		* @param[in] str (const std::string&) The string to escape
+		* @return std::string The escaped string
+		*/
+		static std::string Escape(const std::string& str);
+
+	private:
+		bool running_; //!< Is the profiler currently running?
+		int frames_; //!< The number of frames still to profile from launch, 0 if there is no launch profile
+		int interval_; //!< The sampling interval in microseconds
+		std::string launch_path_; //!< The path to write the launch profile to
+
+	public:
+		JS_NAME("Profiler");
+		static void RegisterJS(JS_SINGLETON obj);
+		static void JSStart(JS_ARGS args);
+		static void JSStop(JS_ARGS args);
+		static void JSRunning(JS_ARGS args);
+		static void JSGCStats(JS_ARGS args);
+		static void JSBenchmarkCallback(JS_ARGS args);
+		static void JSCapture(JS_ARGS args);
+		static void JSFrameStats(JS_ARGS args);
+	};
+}
\ No newline at end of file
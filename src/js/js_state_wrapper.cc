@@ -5,6 +5,8 @@
 #include "../application/game.h"
 
 #include "../js/js_state_wrapper.h"
+#include "../js/js_allocator.h"
+#include "../js/js_module_registry.h"
 
 #include "../platform/platform_text_file.h"
 #include "../cvar/cvar.h"
@@ -28,7 +30,8 @@ namespace snuffbox
 	//-------------------------------------------------------------------------------------------
   JSStateWrapper::JSStateWrapper() :
     platform_(nullptr),
-    running_(false)
+    running_(false),
+		idle_(false)
 	{
 		
 	}
@@ -47,10 +50,14 @@ namespace snuffbox
 		V8::Initialize();
 		platform_ = platform::CreateDefaultPlatform();
 		V8::InitializePlatform(platform_);
+		V8::SetArrayBufferAllocator(JSAllocator::Instance());
 
 		isolate_ = Isolate::New();
 		isolate_->Enter();
 
+		isolate_->AddGCPrologueCallback(OnGCPrologue);
+		isolate_->AddGCEpilogueCallback(OnGCEpilogue);
+
 		Isolate::Scope isolate_scope(isolate_);
 
 		HandleScope scope(isolate_);
@@ -219,6 +226,23 @@ namespace snuffbox
 		obj->Set(String::NewFromUtf8(isolate_, name.c_str()), value);
 	}
 
+	//-------------------------------------------------------------------------------------------
+	void JSStateWrapper::IdleNotification(const double& idle_time)
+	{
+		int ms = static_cast<int>(idle_time);
+		if (ms < 1)
+		{
+			return;
+		}
+
+		idle_ = true;
+		isolate_->IdleNotification(ms);
+		idle_ = false;
+
+		gc_stats_.idle_time += ms;
+		++gc_stats_.idle_notifications;
+	}
+
 	//-------------------------------------------------------------------------------------------
 	void JSStateWrapper::Destroy()
 	{
@@ -249,6 +273,7 @@ namespace snuffbox
 		stack_dump_available_ = false;
 		SNUFF_LOG_INFO("Disposing V8 and its state");
 
+    JSModuleRegistry::Instance()->Clear();
     Destroy();
 
 		//SNUFF_LOG_WARNING("This is where it really happens, collecting dat_garbage");
@@ -297,9 +322,9 @@ namespace snuffbox
   }
 
 	//-------------------------------------------------------------------------------------------
-	std::map<std::string, bool>& JSStateWrapper::required()
+	const JSStateWrapper::GCStats& JSStateWrapper::gc_stats() const
 	{
-		return required_;
+		return gc_stats_;
 	}
 
 	//-------------------------------------------------------------------------------------------
@@ -320,6 +345,30 @@ namespace snuffbox
 		return stack_dump_available_;
 	}
 
+	//-------------------------------------------------------------------------------------------
+	void JSStateWrapper::OnGCPrologue(Isolate* isolate, GCType type, GCCallbackFlags flags)
+	{
+		JSStateWrapper::Instance()->gc_start_ = std::chrono::high_resolution_clock::now();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSStateWrapper::OnGCEpilogue(Isolate* isolate, GCType type, GCCallbackFlags flags)
+	{
+		JSStateWrapper* wrapper = JSStateWrapper::Instance();
+		GCStats& stats = wrapper->gc_stats_;
+
+		double elapsed = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - wrapper->gc_start_).count();
+
+		++stats.collections;
+		stats.gc_time += elapsed;
+
+		if (wrapper->idle_ == true)
+		{
+			++stats.idle_collections;
+			stats.idle_gc_time += elapsed;
+		}
+	}
+
 	//-------------------------------------------------------------------------------------------
 	void JSStateWrapper::JSRegisterFunctions()
 	{
@@ -332,12 +381,11 @@ namespace snuffbox
   {
     JSObject* ptr = data.GetParameter();
 
-    int64_t size = -static_cast<int64_t>(sizeof(ptr));
+		ptr->ReleaseExternalMemory();
 		ptr->object().ClearWeak();
     ptr->object().Reset();
     AllocatedMemory::Instance().Destruct<JSObject>(ptr);
 		data.GetValue().Clear();
-    JSStateWrapper::Instance()->isolate()->AdjustAmountOfExternalAllocatedMemory(size);
   }
 
 	//-------------------------------------------------------------------------------------------
@@ -347,8 +395,6 @@ namespace snuffbox
 		JSWrapper wrapper(args);
 		bool check = wrapper.Check("S");
 
-		JSStateWrapper* instance = JSStateWrapper::Instance();
-		
 		if (check == false)
 		{
 			return;
@@ -356,15 +402,7 @@ namespace snuffbox
 		else
 		{
 			std::string path = wrapper.GetValue<std::string>(0, "");
-			std::map<std::string, bool>& required = instance->required();
-
-			if (required.find(path) != required.end())
-			{
-				return;
-			}
-
-			instance->CompileAndRun(path + ".js");
-			required.emplace(path, true);
+			args.GetReturnValue().Set(JSModuleRegistry::Instance()->Require(path + ".js"));
 		}
 	}
 
@@ -2,7 +2,7 @@
 
 #include <v8.h>
 #include <string>
-#include <map>
+#include <chrono>
 
 #include "../memory/allocated_memory.h"
 
@@ -22,6 +22,25 @@ namespace snuffbox
 	*/
 	class JSStateWrapper
 	{
+	public:
+		/**
+		* @struct snuffbox::JSStateWrapper::GCStats
+		* @brief Statistics about the garbage collections V8 performed and how much of that work was done in idle time
+		* @author Danil Konings
+		*/
+		struct GCStats
+		{
+			/// Default constructor
+			GCStats() : collections(0), idle_collections(0), gc_time(0.0), idle_gc_time(0.0), idle_time(0.0), idle_notifications(0){}
+
+			unsigned int collections; //!< The total number of garbage collections
+			unsigned int idle_collections; //!< The number of garbage collections that ran during an idle notification
+			double gc_time; //!< The total time spent collecting garbage in milliseconds
+			double idle_gc_time; //!< The time spent collecting garbage during idle notifications in milliseconds
+			double idle_time; //!< The total idle time handed to V8 in milliseconds
+			unsigned int idle_notifications; //!< The number of idle notifications sent to V8
+		};
+
 	public:
 		/// Default constructor
 		JSStateWrapper();
@@ -93,6 +112,12 @@ namespace snuffbox
 		*/
 		void RegisterToObject(const v8::Handle<v8::Object>& obj, const std::string& name, const v8::Handle<v8::Value>& value);
 
+		/**
+		* @brief Hands the remaining time of a frame to V8 so it can do incremental marking and sweeping
+		* @param[in] idle_time (const double&) The idle time left in this frame in milliseconds
+		*/
+		void IdleNotification(const double& idle_time);
+
 		/// Destroys the state wrapper
 		void Destroy();
 
@@ -117,9 +142,9 @@ namespace snuffbox
     const bool& running() const;
 
 		/**
-		* @return std::map<std::string, bool>& The map of required JavaScript files
+		* @return const snuffbox::JSStateWrapper::GCStats& The garbage collection statistics
 		*/
-		std::map<std::string, bool>& required();
+		const GCStats& gc_stats() const;
 
 		/// Default destructor
 		~JSStateWrapper();
@@ -132,13 +157,31 @@ namespace snuffbox
 		*/
 		static bool StackDumpAvailable();
 
+		/**
+		* @brief Called by V8 before a garbage collection
+		* @param[in] isolate (v8::Isolate*) The isolate that is being collected
+		* @param[in] type (v8::GCType) The type of garbage collection
+		* @param[in] flags (v8::GCCallbackFlags) The garbage collection flags
+		*/
+		static void OnGCPrologue(v8::Isolate* isolate, v8::GCType type, v8::GCCallbackFlags flags);
+
+		/**
+		* @brief Called by V8 after a garbage collection, records the garbage collection statistics
+		* @param[in] isolate (v8::Isolate*) The isolate that was collected
+		* @param[in] type (v8::GCType) The type of garbage collection
+		* @param[in] flags (v8::GCCallbackFlags) The garbage collection flags
+		*/
+		static void OnGCEpilogue(v8::Isolate* isolate, v8::GCType type, v8::GCCallbackFlags flags);
+
 	private:
 		v8::Isolate*	isolate_; //!< Used to create the isolated JavaScript state for this instance of the engine
 		v8::Persistent<v8::Context> context_; //!< The context we will use for this JavaScript state
 		v8::Persistent<v8::ObjectTemplate> global_; //!< The global scope for use with the JavaScript state
 		v8::Platform* platform_; //!< The win32 platform
     bool running_; //!< Is the JavaScript engine still running?
-		std::map<std::string, bool> required_; //!< Already required files
+		GCStats gc_stats_; //!< The garbage collection statistics
+		bool idle_; //!< Is V8 currently handling an idle notification?
+		std::chrono::high_resolution_clock::time_point gc_start_; //!< The start time of the current garbage collection
 
 	public:
 		/// Registers basic functions (require, assert, etc.)
@@ -164,9 +207,13 @@ namespace snuffbox
 		ptr->object().SetWeak(static_cast<JSObject*>(ptr), JSDestroy);
 		ptr->object().MarkIndependent();
 		obj->SetHiddenValue(v8::String::NewFromUtf8(isolate, "__ptr"), v8::External::New(isolate, static_cast<void*>(ptr)));
-		int64_t size = static_cast<int64_t>(sizeof(ptr));
 
-		isolate->AdjustAmountOfExternalAllocatedMemory(size);
+		if (ptr->external_memory() == 0)
+		{
+			ptr->ReportMemory(sizeof(T));
+		}
+
+		ptr->UpdateExternalMemory();
 		args.GetReturnValue().Set(obj);
 	}
 }
\ No newline at end of file
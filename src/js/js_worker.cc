@@ -0,0 +1,486 @@
+#include "../js/js_worker.h"
+
+#include "../application/logging.h"
+#include "../application/game.h"
+
+#include <fstream>
+#include <iterator>
+
+using namespace v8;
+
+namespace snuffbox
+{
+	//-------------------------------------------------------------------------------------------
+	std::vector<JSWorker*> JSWorker::workers_;
+
+	//-------------------------------------------------------------------------------------------
+	static std::string ExceptionToString(TryCatch* try_catch)
+	{
+		std::string error = *String::Utf8Value(try_catch->Exception());
+		Local<Message> message = try_catch->Message();
+
+		if (message.IsEmpty() == true)
+		{
+			return error;
+		}
+
+		return std::string(*String::Utf8Value(message->GetScriptResourceName())) + ":" + std::to_string(message->GetLineNumber()) + ": " + error;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	JSWorker::JSWorker(JS_ARGS args) :
+		terminated_(false),
+		finished_(false),
+		isolate_(nullptr)
+	{
+		JSWrapper wrapper(args);
+
+		path_ = wrapper.Check("S") == true ? wrapper.GetValue<std::string>(0, "") : "";
+		root_ = Game::Instance()->path();
+
+		workers_.push_back(this);
+
+		if (path_.empty() == true)
+		{
+			terminated_ = true;
+			finished_ = true;
+			return;
+		}
+
+		self_.Reset(args.GetIsolate(), args.This());
+		thread_ = std::thread(&JSWorker::Run, this);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSWorker::PostMessage(JSMessage* message)
+	{
+		if (terminated_ == true)
+		{
+			delete message;
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			inbox_.push(message);
+		}
+
+		signal_.notify_one();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSWorker::Terminate()
+	{
+		terminated_ = true;
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			if (isolate_ != nullptr)
+			{
+				V8::TerminateExecution(isolate_);
+			}
+		}
+
+		signal_.notify_one();
+
+		if (thread_.joinable() == true)
+		{
+			thread_.join();
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			while (inbox_.empty() == false)
+			{
+				delete inbox_.front();
+				inbox_.pop();
+			}
+		}
+
+		self_.Reset();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSWorker::Update()
+	{
+		for (unsigned int i = 0; i < workers_.size(); ++i)
+		{
+			workers_.at(i)->Flush();
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSWorker::TerminateAll()
+	{
+		for (unsigned int i = 0; i < workers_.size(); ++i)
+		{
+			workers_.at(i)->Terminate();
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSWorker::Run()
+	{
+		Isolate* isolate = Isolate::New();
+		isolate->SetData(0, this);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			isolate_ = isolate;
+		}
+
+		{
+			Isolate::Scope isolate_scope(isolate);
+			HandleScope handle_scope(isolate);
+
+			Local<Context> context = CreateContext(isolate);
+			Context::Scope context_scope(context);
+
+			bool running = RunScript(isolate, path_);
+			JSMessage* message = nullptr;
+
+			while (running == true)
+			{
+				{
+					std::unique_lock<std::mutex> lock(mutex_);
+					signal_.wait(lock, [this](){ return terminated_ == true || inbox_.empty() == false; });
+
+					if (terminated_ == true)
+					{
+						break;
+					}
+
+					message = inbox_.front();
+					inbox_.pop();
+				}
+
+				HandleScope scope(isolate);
+				TryCatch try_catch;
+
+				Local<Value> data = message->Read(isolate);
+				delete message;
+
+				Local<Object> global = context->Global();
+				Local<Value> callback = global->Get(String::NewFromUtf8(isolate, "onmessage"));
+
+				if (callback->IsFunction() == false)
+				{
+					continue;
+				}
+
+				Local<Value> argv[] = { data };
+				Local<Function>::Cast(callback)->Call(global, 1, argv);
+
+				if (try_catch.HasCaught() == true && terminated_ == false)
+				{
+					Log(DebugLogging::LogType::kError, ExceptionToString(&try_catch));
+				}
+			}
+		}
+
+		JSMessage::ReleaseBuffers(isolate);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			isolate_ = nullptr;
+		}
+
+		isolate->Dispose();
+		finished_ = true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	Local<Context> JSWorker::CreateContext(Isolate* isolate)
+	{
+		EscapableHandleScope scope(isolate);
+		Local<ObjectTemplate> global = ObjectTemplate::New(isolate);
+
+		global->Set(isolate, "postMessage", FunctionTemplate::New(isolate, JSWorkerPostMessage));
+		global->Set(isolate, "close", FunctionTemplate::New(isolate, JSWorkerClose));
+		global->Set(isolate, "importScripts", FunctionTemplate::New(isolate, JSWorkerImportScripts));
+
+		struct { const char* name; DebugLogging::LogType type; } levels[] = {
+			{ "debug", DebugLogging::LogType::kDebug },
+			{ "info", DebugLogging::LogType::kInfo },
+			{ "warning", DebugLogging::LogType::kWarning },
+			{ "success", DebugLogging::LogType::kSuccess },
+			{ "error", DebugLogging::LogType::kError }
+		};
+
+		Local<ObjectTemplate> log = ObjectTemplate::New(isolate);
+		for (unsigned int i = 0; i < sizeof(levels) / sizeof(levels[0]); ++i)
+		{
+			log->Set(isolate, levels[i].name, FunctionTemplate::New(isolate, JSWorkerLog, Integer::New(isolate, levels[i].type)));
+		}
+		global->Set(isolate, "Log", log);
+
+		Local<ObjectTemplate> io = ObjectTemplate::New(isolate);
+		io->Set(isolate, "read", FunctionTemplate::New(isolate, JSWorkerRead));
+		io->Set(isolate, "write", FunctionTemplate::New(isolate, JSWorkerWrite));
+		io->Set(isolate, "exists", FunctionTemplate::New(isolate, JSWorkerExists));
+		global->Set(isolate, "IO", io);
+
+		return scope.Escape(Context::New(isolate, NULL, global));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool JSWorker::RunScript(Isolate* isolate, const std::string& path)
+	{
+		std::ifstream fin(root_ + "/" + path, std::ios::binary);
+
+		if (!fin)
+		{
+			Log(DebugLogging::LogType::kError, "Could not open worker script '" + path + "'");
+			return false;
+		}
+
+		std::string src((std::istreambuf_iterator<char>(fin)), std::istreambuf_iterator<char>());
+
+		HandleScope scope(isolate);
+		TryCatch try_catch;
+
+		Local<Script> script = Script::Compile(String::NewFromUtf8(isolate, src.c_str()), String::NewFromUtf8(isolate, path.c_str()));
+
+		if (script.IsEmpty() == true || script->Run().IsEmpty() == true)
+		{
+			if (terminated_ == false)
+			{
+				Log(DebugLogging::LogType::kError, ExceptionToString(&try_catch));
+			}
+			return false;
+		}
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSWorker::Log(const int& type, const std::string& message)
+	{
+		LogEntry entry;
+		entry.type = type;
+		entry.message = message;
+
+		std::lock_guard<std::mutex> lock(mutex_);
+		logs_.push(entry);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSWorker::Flush()
+	{
+		bool finished = finished_;
+		std::queue<JSMessage*> messages;
+		std::queue<LogEntry> logs;
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			std::swap(messages, outbox_);
+			std::swap(logs, logs_);
+		}
+
+		while (logs.empty() == false)
+		{
+			DebugLogging::Log(static_cast<DebugLogging::LogType>(logs.front().type), "[Worker: " + path_ + "] " + logs.front().message);
+			logs.pop();
+		}
+
+		if (messages.empty() == true)
+		{
+			if (finished == true)
+			{
+				self_.Reset();
+			}
+			return;
+		}
+
+		JSStateWrapper* wrapper = JSStateWrapper::Instance();
+		Isolate* isolate = wrapper->isolate();
+		HandleScope scope(isolate);
+
+		Local<Object> obj = Local<Object>::New(isolate, object());
+		Local<Value> callback = obj->Get(String::NewFromUtf8(isolate, "onmessage"));
+
+		while (messages.empty() == false)
+		{
+			JSMessage* message = messages.front();
+			messages.pop();
+
+			if (callback->IsFunction() == false)
+			{
+				delete message;
+				continue;
+			}
+
+			TryCatch try_catch;
+			Local<Value> argv[] = { message->Read(isolate) };
+			delete message;
+
+			Local<Function>::Cast(callback)->Call(obj, 1, argv);
+
+			std::string error;
+			if (wrapper->GetException(&try_catch, &error) == true)
+			{
+				SNUFF_LOG_ERROR(error);
+			}
+		}
+
+		if (finished == true)
+		{
+			self_.Reset();
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	JSWorker* JSWorker::FromArgs(JS_ARGS args)
+	{
+		return static_cast<JSWorker*>(args.GetIsolate()->GetData(0));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	JSWorker::~JSWorker()
+	{
+		Terminate();
+
+		for (unsigned int i = 0; i < workers_.size(); ++i)
+		{
+			if (workers_.at(i) == this)
+			{
+				workers_.erase(workers_.begin() + i);
+				break;
+			}
+		}
+
+		while (outbox_.empty() == false)
+		{
+			delete outbox_.front();
+			outbox_.pop();
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSWorker::RegisterJS(JS_CONSTRUCTABLE obj)
+	{
+		JSFunctionRegister funcs[] = {
+			{ "postMessage", JSPostMessage },
+			{ "terminate", JSTerminate }
+		};
+
+		JSFunctionRegister::Register(funcs, sizeof(funcs) / sizeof(JSFunctionRegister), obj);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSWorker::JSPostMessage(JS_ARGS args)
+	{
+		JS_SETUP(JSWorker);
+
+		JSMessage* message = new JSMessage();
+		std::string error;
+
+		if (message->Write(args.GetIsolate(), args[0], args[1], &error) == false)
+		{
+			delete message;
+			SNUFF_LOG_ERROR("Could not post a message to worker '" + self->path_ + "', " + error);
+			return;
+		}
+
+		self->PostMessage(message);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSWorker::JSTerminate(JS_ARGS args)
+	{
+		JS_SETUP(JSWorker);
+		self->Terminate();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSWorker::JSWorkerPostMessage(JS_ARGS args)
+	{
+		Isolate* isolate = args.GetIsolate();
+		JSWorker* worker = FromArgs(args);
+
+		JSMessage* message = new JSMessage();
+		std::string error;
+
+		if (message->Write(isolate, args[0], args[1], &error) == false)
+		{
+			delete message;
+			isolate->ThrowException(Exception::Error(String::NewFromUtf8(isolate, error.c_str())));
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(worker->mutex_);
+		worker->outbox_.push(message);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSWorker::JSWorkerClose(JS_ARGS args)
+	{
+		FromArgs(args)->terminated_ = true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSWorker::JSWorkerImportScripts(JS_ARGS args)
+	{
+		JSWorker* worker = FromArgs(args);
+		bool success = true;
+
+		for (int i = 0; i < args.Length() && success == true; ++i)
+		{
+			success = worker->RunScript(args.GetIsolate(), *String::Utf8Value(args[i]));
+		}
+
+		args.GetReturnValue().Set(success);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSWorker::JSWorkerLog(JS_ARGS args)
+	{
+		std::string message;
+		for (int i = 0; i < args.Length(); ++i)
+		{
+			message += (i > 0 ? " " : "") + std::string(*String::Utf8Value(args[i]));
+		}
+
+		FromArgs(args)->Log(args.Data()->Int32Value(), message);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSWorker::JSWorkerRead(JS_ARGS args)
+	{
+		Isolate* isolate = args.GetIsolate();
+		std::ifstream fin(FromArgs(args)->root_ + "/" + *String::Utf8Value(args[0]), std::ios::binary);
+
+		if (!fin)
+		{
+			args.GetReturnValue().SetNull();
+			return;
+		}
+
+		std::string contents((std::istreambuf_iterator<char>(fin)), std::istreambuf_iterator<char>());
+		args.GetReturnValue().Set(String::NewFromUtf8(isolate, contents.c_str(), String::kNormalString, static_cast<int>(contents.size())));
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSWorker::JSWorkerWrite(JS_ARGS args)
+	{
+		std::ofstream out(FromArgs(args)->root_ + "/" + *String::Utf8Value(args[0]), std::ios::binary);
+
+		if (!out)
+		{
+			args.GetReturnValue().Set(false);
+			return;
+		}
+
+		String::Utf8Value src(args[1]);
+		out.write(*src, src.length());
+
+		args.GetReturnValue().Set(true);
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void JSWorker::JSWorkerExists(JS_ARGS args)
+	{
+		std::ifstream fin(FromArgs(args)->root_ + "/" + *String::Utf8Value(args[0]));
+		args.GetReturnValue().Set(static_cast<bool>(fin));
+	}
+}
\ No newline at end of file
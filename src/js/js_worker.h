@@ -0,0 +1,125 @@
+#pragma once
+
+#include "../js/js_object.h"
+#include "../js/js_message.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <queue>
+
+namespace snuffbox
+{
+	/**
+	* @class snuffbox::JSWorker
+	* @brief Runs a script on its own isolate and thread, communicating with the main isolate through structured clone messages
+	* @remarks Workers only have access to a restricted set of bindings (Math, IO and Log), as the engine bindings are not thread-safe
+	* @author Danil Konings
+	*/
+	class JSWorker : public JSObject
+	{
+	public:
+		/**
+		* @struct snuffbox::JSWorker::LogEntry
+		* @brief A log message sent from a worker, logged on the main thread
+		* @author Danil Konings
+		*/
+		struct LogEntry
+		{
+			int type; //!< The snuffbox::DebugLogging::LogType of this message
+			std::string message; //!< The message to log
+		};
+
+	public:
+		/**
+		* @brief Construct through JavaScript, expects the path to the script to run
+		* @param[in] args (JS_ARGS) The arguments passed by JavaScript
+		*/
+		JSWorker(JS_ARGS args);
+
+		/// Default destructor, terminates the worker
+		virtual ~JSWorker();
+
+		/**
+		* @brief Posts a message to the worker
+		* @param[in] message (snuffbox::JSMessage*) The message to post, ownership is transferred to the worker
+		*/
+		void PostMessage(JSMessage* message);
+
+		/// Stops the worker and waits for its thread to finish
+		void Terminate();
+
+		/// Delivers all messages and log entries the workers have sent to the main isolate
+		static void Update();
+
+		/// Terminates all running workers
+		static void TerminateAll();
+
+	private:
+		/// The entry point of the worker thread
+		void Run();
+
+		/**
+		* @brief Creates the restricted global scope of a worker isolate
+		* @param[in] isolate (v8::Isolate*) The worker isolate
+		* @return v8::Local<v8::Context> The created context
+		*/
+		v8::Local<v8::Context> CreateContext(v8::Isolate* isolate);
+
+		/**
+		* @brief Compiles and runs a script in the worker isolate
+		* @param[in] isolate (v8::Isolate*) The worker isolate
+		* @param[in] path (const std::string&) The path of the script, relative to the game path
+		* @return bool Did the script run without errors?
+		*/
+		bool RunScript(v8::Isolate* isolate, const std::string& path);
+
+		/**
+		* @brief Queues a log entry to be logged on the main thread
+		* @param[in] type (const int&) The snuffbox::DebugLogging::LogType of the message
+		* @param[in] message (const std::string&) The message
+		*/
+		void Log(const int& type, const std::string& message);
+
+		/// Delivers the outgoing messages of this worker to the main isolate, releases the JavaScript object once the worker thread has exited
+		void Flush();
+
+		/**
+		* @brief Retrieves the worker that owns the currently running worker isolate
+		* @param[in] args (JS_ARGS) The arguments of a worker sided callback
+		* @return snuffbox::JSWorker* The worker
+		*/
+		static JSWorker* FromArgs(JS_ARGS args);
+
+	private:
+		std::string path_; //!< The path to the script this worker runs
+		std::string root_; //!< The game path, copied so that the worker thread doesn't need the main thread's singletons
+		std::thread thread_; //!< The worker thread
+		std::mutex mutex_; //!< The mutex guarding the message queues
+		std::condition_variable signal_; //!< Signals the worker thread when a message arrives or it should terminate
+		std::queue<JSMessage*> inbox_; //!< Messages sent to the worker
+		std::queue<JSMessage*> outbox_; //!< Messages sent from the worker
+		std::queue<LogEntry> logs_; //!< Log entries sent from the worker
+		std::atomic<bool> terminated_; //!< Should the worker stop?
+		std::atomic<bool> finished_; //!< Has the worker thread exited?
+		v8::Persistent<v8::Object> self_; //!< A strong handle to the JavaScript object, keeps it from being collected while the worker thread is running
+		v8::Isolate* isolate_; //!< The worker isolate, only valid while the worker thread is running
+
+		static std::vector<JSWorker*> workers_; //!< All workers that are currently alive
+
+	public:
+		JS_NAME("Worker");
+		static void RegisterJS(JS_CONSTRUCTABLE obj);
+		static void JSPostMessage(JS_ARGS args);
+		static void JSTerminate(JS_ARGS args);
+
+		static void JSWorkerPostMessage(JS_ARGS args);
+		static void JSWorkerClose(JS_ARGS args);
+		static void JSWorkerImportScripts(JS_ARGS args);
+		static void JSWorkerLog(JS_ARGS args);
+		static void JSWorkerRead(JS_ARGS args);
+		static void JSWorkerWrite(JS_ARGS args);
+		static void JSWorkerExists(JS_ARGS args);
+	};
+}
\ No newline at end of file
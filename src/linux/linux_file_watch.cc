@@ -0,0 +1,147 @@
+#include "../linux/linux_file_watch.h"
+
+#include "../memory/shared_ptr.h"
+
+#include "../cvar/cvar.h"
+#include "../application/game.h"
+
+#include <sys/stat.h>
+
+namespace snuffbox
+{
+	//---------------------------------------------------------------------------------------------------------
+	LinuxFileWatch::LinuxFileWatch()
+	{
+		
+	}
+
+	//---------------------------------------------------------------------------------------------------------
+	LinuxFileWatch* LinuxFileWatch::Instance()
+	{
+		static SharedPtr<LinuxFileWatch> file_watch = AllocatedMemory::Instance().Construct<LinuxFileWatch>();
+		return file_watch.get();
+	}
+
+	//---------------------------------------------------------------------------------------------------------
+	bool LinuxFileWatch::Add(const std::string& path, const ContentTypes& type)
+	{
+		WatchedFile file;
+
+		bool success = GetLastEditedTime(path, &file.last_edited);
+		file.type = type;
+		file.path = path;
+
+		if (success == false)
+		{
+			SNUFF_LOG_ERROR("Could not add '" + path + "' to the file watch, file will not be hot reloaded");
+			return false;
+		}
+		
+		FileMap::iterator it = watched_files_.find(path);
+
+		if (it == watched_files_.end())
+		{
+			queue_.push(file);
+			return true;
+		}
+
+		SNUFF_LOG_WARNING("File '" + path + "' was already added to the file watch earlier, file will still be hot reloaded");
+		return true;
+	}
+
+	//---------------------------------------------------------------------------------------------------------
+	void LinuxFileWatch::Remove(const std::string& path)
+	{
+		FileMap::iterator it = watched_files_.find(path);
+
+		if (it == watched_files_.end())
+		{
+			SNUFF_LOG_ERROR("Attempted to remove file '" + path + "' from the file watch, but it was never added");
+			return;
+		}
+
+		to_remove_.push(path);
+	}
+
+	//---------------------------------------------------------------------------------------------------------
+	void LinuxFileWatch::Update()
+	{
+		bool success = false;
+		timespec time;
+		ContentManager* content_manager = ContentManager::Instance();
+
+		for (FileMap::iterator it = watched_files_.begin(); it != watched_files_.end(); ++it)
+		{
+			WatchedFile& file = it->second;
+			success = GetLastEditedTime(file.path, &time);
+
+			if (success == false)
+			{
+				continue;
+			}
+
+			if (file.last_edited.tv_sec != time.tv_sec || file.last_edited.tv_nsec != time.tv_nsec)
+			{
+				file.last_edited = time;
+				last_reloaded_ = file.path;
+				content_manager->Notify(ContentManager::Events::kReload, file.type, file.path);
+				Game::Instance()->Notify(Game::GameNotifications::kReload);
+			}
+		}
+	}
+
+	//---------------------------------------------------------------------------------------------------------
+	bool LinuxFileWatch::GetLastEditedTime(const std::string& path, timespec* time)
+	{
+		struct stat info;
+
+		std::string full_path = Game::Instance()->path() + "/" + path;
+
+		if (stat(full_path.c_str(), &info) != 0)
+		{
+			return false;
+		}
+
+		*time = info.st_mtim;
+		return true;
+	}
+
+	//---------------------------------------------------------------------------------------------------------
+	void LinuxFileWatch::Process()
+	{
+		while (queue_.empty() == false)
+		{
+			const WatchedFile& top = queue_.front();
+
+			watched_files_.emplace(top.path, top);
+
+			queue_.pop();
+		}
+
+		while (to_remove_.empty() == false)
+		{
+			const std::string& top = to_remove_.front();
+
+			FileMap::iterator it = watched_files_.find(top);
+
+			if (it != watched_files_.end())
+			{
+				watched_files_.erase(it);
+			}
+
+			to_remove_.pop();
+		}
+	}
+
+	//---------------------------------------------------------------------------------------------------------
+	const std::string& LinuxFileWatch::last_reloaded() const
+	{
+		return last_reloaded_;
+	}
+
+	//---------------------------------------------------------------------------------------------------------
+	LinuxFileWatch::~LinuxFileWatch()
+	{
+
+	}
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <time.h>
+
+#include <map>
+#include <queue>
+
+#include "../platform/platform_file_watch_base.h"
+
+namespace snuffbox
+{
+	/**
+	* @class snuffbox::LinuxFileWatch
+	* @brief Used to monitor files for changes on the Linux platform
+	* @author Danil Konings
+	*/
+	class LinuxFileWatch : public IFileWatchBase
+	{
+	public:
+		/**
+		* @struct snuffbox::LinuxFileWatch::WatchedFile
+		* @brief Contains information about a watched file to monitor it
+		* @author Danil Konings
+		*/ 
+		struct WatchedFile
+		{
+			std::string path;
+			ContentTypes type;
+			timespec last_edited;
+		};
+
+		/// Default constructor
+		LinuxFileWatch();
+
+		/**
+		* @brief Retrieves the singleton instance of this class
+		* @return snuffbox::LinuxFileWatch* The pointer to the singleton
+		*/
+		static LinuxFileWatch* Instance();
+
+		/**
+		* @see snuffbox::IFileWatchBase::Add
+		*/
+		bool Add(const std::string& path, const ContentTypes& type);
+
+		/**
+		* @see snuffbox::IFileWatchBase::Remove
+		*/
+		void Remove(const std::string& path);
+
+		/**
+		* @see snuffbox::IFileWatchBase::Update
+		*/
+		void Update();
+
+		/**
+		* @brief Retrieves the time a file was last edited
+		* @param[in] path (std::string) The path to the corresponding file
+		* @param[out] time (timespec*) The time buffer to store the resulting data in
+		* @return bool Was it a success or not?
+		*/
+		bool GetLastEditedTime(const std::string& path, timespec* time);
+
+		/// Processes the queue and adds new files into the map
+		void Process();
+
+		/**
+		* @see snuffbox::IFileWatchBase::last_reloaded
+		*/
+		const std::string& last_reloaded() const;
+
+		/// Default destructor
+		virtual ~LinuxFileWatch();
+
+	private:
+		typedef std::map<std::string, WatchedFile> FileMap;
+		FileMap watched_files_; //!< A map of watched files by path
+		std::queue<WatchedFile> queue_; //!< A queue to add files to without interfering with the content manager
+		std::queue<std::string> to_remove_; //!< A queue to remove files without interfering with the content manager
+		std::string last_reloaded_; //!< The last reloaded file
+	};
+}
\ No newline at end of file
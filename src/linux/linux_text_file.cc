@@ -0,0 +1,75 @@
+#include <fstream>
+
+#include "../linux/linux_text_file.h"
+
+#include "../application/logging.h"
+
+namespace snuffbox
+{
+	//-------------------------------------------------------------------------------------------
+	LinuxTextFile::LinuxTextFile() :
+		path_("undefined"),
+		valid_(false)
+	{
+		
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool LinuxTextFile::Open(const std::string& path)
+	{
+		path_ = path;
+		std::ifstream fin(path);
+
+		if (!fin)
+		{
+			return false;
+		}
+
+		fin.close();
+		
+		valid_ = true;
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	std::string LinuxTextFile::Read()
+	{
+		SNUFF_XASSERT(valid_ == true, "File was not succesfully opened initially, aborting! (" + path_ + ")", "LinuxTextFile::Read");
+		std::string contents = "";
+
+		char ch;
+		std::ifstream fin(path_);
+
+		while (fin >> std::noskipws >> ch)
+		{
+			contents += ch;
+		}
+
+		fin.close();
+		
+		return contents;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool LinuxTextFile::Write(const std::string& path, const std::string& src)
+	{
+		std::ofstream out(path);
+
+		if (!out)
+		{
+			SNUFF_LOG_ERROR("Could not save to location '" + path + "'");
+			return false;
+		}
+
+		out << std::noskipws << src;
+
+		out.close();
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	LinuxTextFile::~LinuxTextFile()
+	{
+
+	}
+}
\ No newline at end of file
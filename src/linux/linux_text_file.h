@@ -0,0 +1,34 @@
+#pragma once
+
+#include "../platform/platform_text_file_base.h"
+
+namespace snuffbox
+{
+	/**
+	* @class snuffbox::LinuxTextFile
+	* @brief A Linux specific text file class
+	* @author Danil Konings
+	*/
+	class LinuxTextFile : public ITextFileBase
+	{
+	public:
+		/// Default constructor
+		LinuxTextFile();
+
+		/// Default destructor
+		virtual ~LinuxTextFile();
+
+		/// @see snuffbox::ITextFileBase
+		bool Open(const std::string& path);
+
+		/// @see snuffbox::ITextFileBase
+		std::string Read();
+
+		/// @see snuffbox::ITextFileBase
+		bool Write(const std::string& path, const std::string& src);
+
+	private:
+		std::string path_; //!< The current path in use
+		bool valid_; //!< Is this text file valid?
+	};
+}
\ No newline at end of file
@@ -10,7 +10,8 @@ namespace snuffbox
 	//-------------------------------------------------------------------------------------------
 	AllocatedMemory::AllocatedMemory() : 
 		allocations_(0), 
-		allocated_memory_(0)
+		allocated_memory_(0),
+		total_allocations_(0)
 	{
 		
 	}
@@ -26,6 +27,7 @@ namespace snuffbox
 	void AllocatedMemory::IncreaseAllocations()
 	{
 		++allocations_;
+		++total_allocations_;
 	}
 
 	//-------------------------------------------------------------------------------------------
@@ -46,9 +48,22 @@ namespace snuffbox
 		allocated_memory_ -= size;
 	}
 
+	//-------------------------------------------------------------------------------------------
+	unsigned int AllocatedMemory::allocations() const
+	{
+		return allocations_.load();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	size_t AllocatedMemory::total_allocations() const
+	{
+		return total_allocations_.load();
+	}
+
+	//-------------------------------------------------------------------------------------------
   void AllocatedMemory::CheckForLeaks()
   {
-    SNUFF_XASSERT(allocations_ == 0 && allocated_memory_ == 0, "Detected a memory leak on the heap, allocations: " + std::to_string(allocations_) + ", allocated: " + std::to_string(allocated_memory_) + " bytes", "AllocatedMemory::CheckForLeaks");
+    SNUFF_XASSERT(allocations_ == 0 && allocated_memory_ == 0, "Detected a memory leak on the heap, allocations: " + std::to_string(allocations_.load()) + ", allocated: " + std::to_string(allocated_memory_.load()) + " bytes", "AllocatedMemory::CheckForLeaks");
     SNUFF_LOG_SUCCESS("No memory leaks detected");
 		SNUFF_LOG_SUCCESS("Shutdown succesful");
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 namespace snuffbox
 {
 	/**
@@ -52,6 +54,16 @@ namespace snuffbox
 		*/
 		void DecreaseUsedMemory(const size_t& size);
 
+		/**
+		* @return unsigned int The number of allocations that are still alive
+		*/
+		unsigned int allocations() const;
+
+		/**
+		* @return size_t The number of allocations made since startup, including the ones that have been freed
+		*/
+		size_t total_allocations() const;
+
     /// Checks the environment for memory leaks, if the console exists, keep it running to display the message
     void CheckForLeaks();
 
@@ -60,8 +72,9 @@ namespace snuffbox
 		/// Default constructor
 		AllocatedMemory();
 
-		unsigned int allocations_; //!< The number of allocations of this allocator
-		size_t allocated_memory_; //!< The total allocated memory in bytes of this allocator
+		std::atomic<unsigned int> allocations_; //!< The number of allocations of this allocator, atomic as subsystems are constructed in parallel on startup
+		std::atomic<size_t> allocated_memory_; //!< The total allocated memory in bytes of this allocator
+		std::atomic<size_t> total_allocations_; //!< The number of allocations made since startup
 	};
 
 	//---------------------------------------------------------------------------------------------------------
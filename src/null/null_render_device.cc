@@ -0,0 +1,113 @@
+#include "../null/null_render_device.h"
+
+#include "../application/game.h"
+#include "../application/logging.h"
+
+#include "../cvar/cvar.h"
+#include "../memory/allocated_memory.h"
+
+namespace snuffbox
+{
+	//-------------------------------------------------------------------------------------------
+	NullRenderDevice::NullRenderDevice() :
+		headless_(true)
+	{
+
+	}
+
+	//-------------------------------------------------------------------------------------------
+	NullRenderDevice* NullRenderDevice::Instance()
+	{
+		static SharedPtr<NullRenderDevice> render_device = AllocatedMemory::Instance().Construct<NullRenderDevice>();
+		return render_device.get();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	bool NullRenderDevice::Initialise()
+	{
+		bool found = false;
+		CVar::Value* record = CVar::Instance()->Get("record_draws", &found);
+
+		if (found == true && record->IsString() == true)
+		{
+			record_path_ = record->As<CVar::String>()->value();
+			record_.open(Game::Instance()->path() + "/" + record_path_, std::ios::binary | std::ios::trunc);
+
+			if (!record_)
+			{
+				SNUFF_LOG_ERROR("Could not open '" + record_path_ + "' to record the draw submissions to");
+				record_path_.clear();
+			}
+			else
+			{
+				record_ << "frame,draw_calls,indices,state_changes\n";
+			}
+		}
+
+		SNUFF_LOG_SUCCESS("Succesfully initialised the null render device, nothing will be drawn");
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void NullRenderDevice::StartDraw()
+	{
+
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void NullRenderDevice::Draw()
+	{
+		if (record_path_.empty() == false)
+		{
+			record_ << draw_stats_.frames << ",0,0,0\n";
+		}
+
+		++draw_stats_.frames;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void NullRenderDevice::ResizeBuffers(const int& w, const int& h)
+	{
+
+	}
+
+	//-------------------------------------------------------------------------------------------
+	void NullRenderDevice::Dispose()
+	{
+		if (record_path_.empty() == true)
+		{
+			return;
+		}
+
+		record_.close();
+
+		if (record_.fail() == false)
+		{
+			SNUFF_LOG_SUCCESS("Wrote the draw submissions of " + std::to_string(draw_stats_.frames) + " frames to '" + record_path_ + "'");
+		}
+		else
+		{
+			SNUFF_LOG_ERROR("Could not write the recorded draw submissions to '" + record_path_ + "'");
+		}
+
+		record_path_.clear();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	const bool& NullRenderDevice::headless() const
+	{
+		return headless_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	const NullRenderDevice::DrawStats& NullRenderDevice::draw_stats() const
+	{
+		return draw_stats_;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	NullRenderDevice::~NullRenderDevice()
+	{
+
+	}
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "../platform/platform_render_device_base.h"
+
+#include <string>
+#include <fstream>
+
+namespace snuffbox
+{
+	/**
+	* @class snuffbox::NullRenderDevice
+	* @brief A render device without a graphics API that never draws, for running headless on hosts without a GPU or a window system
+	* @remarks Frames are still counted and recorded to 'record_draws', so the frame statistics of a null build can be compared over time
+	* @author Danil Konings
+	*/
+	class NullRenderDevice : public IRenderDeviceBase
+	{
+	public:
+		/**
+		* @struct NullRenderDevice::DrawStats
+		* @brief The draw submissions counted by the device, always zero apart from the number of frames
+		* @author Danil Konings
+		*/
+		struct DrawStats
+		{
+			/// Default constructor
+			DrawStats() : frames(0), draw_calls(0), indices(0), state_changes(0), frame_draw_calls(0), frame_indices(0), frame_state_changes(0){}
+
+			int frames; //!< The number of presented frames
+			int draw_calls; //!< The total number of draw calls
+			int indices; //!< The total number of drawn indices
+			int state_changes; //!< The total number of pipeline state changes
+			int frame_draw_calls; //!< The number of draw calls of the last frame
+			int frame_indices; //!< The number of drawn indices of the last frame
+			int frame_state_changes; //!< The number of pipeline state changes of the last frame
+		};
+
+	public:
+		/// Default constructor
+		NullRenderDevice();
+
+		/**
+		* @brief Retrieves the singleton instance of this class
+		* @return snuffbox::NullRenderDevice* The pointer to the singleton
+		*/
+		static NullRenderDevice* Instance();
+
+		/// @see snuffbox::IRenderDeviceBase::Initialise
+		bool Initialise();
+
+		/// @see snuffbox::IRenderDeviceBase::StartDraw
+		void StartDraw();
+
+		/// @see snuffbox::IRenderDeviceBase::Draw
+		void Draw();
+
+		/// @see snuffbox::IRenderDeviceBase::ResizeBuffers
+		void ResizeBuffers(const int& w, const int& h);
+
+		/// @see snuffbox::IRenderDeviceBase::Dispose
+		void Dispose();
+
+		/**
+		* @return const bool& Is the device running without a window or swap chain? Always true
+		*/
+		const bool& headless() const;
+
+		/**
+		* @return const snuffbox::NullRenderDevice::DrawStats& The draw submissions counted by this device
+		*/
+		const DrawStats& draw_stats() const;
+
+		/// Default destructor
+		virtual ~NullRenderDevice();
+
+	private:
+		bool headless_; //!< Always true, a null device has nothing to present to
+		DrawStats draw_stats_; //!< The frames counted by this device
+		std::string record_path_; //!< The path to write the recorded frames to, empty if not recording
+		std::ofstream record_; //!< The file the frames are streamed to, one line per frame
+	};
+}
\ No newline at end of file
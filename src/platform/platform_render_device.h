@@ -1,6 +1,9 @@
 #pragma once
 
-#ifdef SNUFF_BUILD_OPENGL
+#ifdef SNUFF_BUILD_NULL
+#include "../null/null_render_device.h"
+namespace snuffbox { typedef NullRenderDevice PlatformRenderDevice; }
+#elif defined SNUFF_BUILD_OPENGL
 #include "../ogl/ogl_render_device.h"
 namespace snuffbox { typedef OGLRenderDevice PlatformRenderDevice; }
 #else
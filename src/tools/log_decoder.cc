@@ -0,0 +1,240 @@
+#include "../application/binary_log_format.h"
+
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <vector>
+
+using namespace snuffbox;
+
+/**
+* @struct DecodedFormat
+* @brief A format read from a format record
+* @author Danil Konings
+*/
+struct DecodedFormat
+{
+	uint8_t type; //!< The log type, as snuffbox::DebugLogging::LogType
+	std::string category; //!< The category of the message
+	std::string format; //!< The format
+};
+
+//-------------------------------------------------------------------------------------------
+template<typename T>
+static bool Read(std::ifstream& in, T* value)
+{
+	in.read(reinterpret_cast<char*>(value), sizeof(T));
+	return in.gcount() == sizeof(T);
+}
+
+//-------------------------------------------------------------------------------------------
+static bool ReadString(std::ifstream& in, std::string* value)
+{
+	uint16_t length = 0;
+	if (Read(in, &length) == false)
+	{
+		return false;
+	}
+
+	value->resize(length);
+
+	if (length == 0)
+	{
+		return true;
+	}
+
+	in.read(&(*value)[0], length);
+	return in.gcount() == length;
+}
+
+//-------------------------------------------------------------------------------------------
+static bool ReadArgument(std::ifstream& in, std::string* value)
+{
+	uint8_t type = 0;
+	if (Read(in, &type) == false)
+	{
+		return false;
+	}
+
+	switch (type)
+	{
+	case BinaryLogFormat::ArgumentTypes::kBool:
+	{
+		uint8_t b = 0;
+		if (Read(in, &b) == false) return false;
+		*value = b != 0 ? "true" : "false";
+		return true;
+	}
+
+	case BinaryLogFormat::ArgumentTypes::kInt:
+	{
+		int64_t i = 0;
+		if (Read(in, &i) == false) return false;
+		*value = std::to_string(i);
+		return true;
+	}
+
+	case BinaryLogFormat::ArgumentTypes::kUInt:
+	{
+		uint64_t u = 0;
+		if (Read(in, &u) == false) return false;
+		*value = std::to_string(u);
+		return true;
+	}
+
+	case BinaryLogFormat::ArgumentTypes::kDouble:
+	{
+		double d = 0.0;
+		if (Read(in, &d) == false) return false;
+		*value = std::to_string(d);
+		return true;
+	}
+
+	case BinaryLogFormat::ArgumentTypes::kString:
+		return ReadString(in, value);
+
+	default:
+		return false;
+	}
+}
+
+//-------------------------------------------------------------------------------------------
+static const char* TypeToString(const uint8_t& type)
+{
+	// Mirrors snuffbox::DebugLogging::TypeToString, indexed by snuffbox::DebugLogging::LogType
+	static const char* types[] = { "$", "#", "?", ">", "!", "!!!" };
+	return type < sizeof(types) / sizeof(const char*) ? types[type] : "unknown";
+}
+
+//-------------------------------------------------------------------------------------------
+static std::string Timestamp(const int64_t& start, const uint64_t& us)
+{
+	time_t seconds = static_cast<time_t>(start + static_cast<int64_t>(us / 1000000));
+	tm* local = localtime(&seconds);
+
+	char buffer[32];
+	if (local == nullptr || strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", local) == 0)
+	{
+		return std::to_string(us);
+	}
+
+	char fraction[8];
+	snprintf(fraction, sizeof(fraction), ".%06u", static_cast<unsigned int>(us % 1000000));
+
+	return std::string(buffer) + fraction;
+}
+
+//-------------------------------------------------------------------------------------------
+static bool Decode(const std::string& path, std::ostream& out)
+{
+	std::ifstream in(path, std::ios::binary);
+	uint32_t magic = 0, version = 0, index = 0;
+	int64_t start = 0;
+
+	if (!in || Read(in, &magic) == false || magic != BinaryLogFormat::kMagic || Read(in, &version) == false || version != BinaryLogFormat::kVersion ||
+		Read(in, &index) == false || Read(in, &start) == false)
+	{
+		std::cerr << "'" << path << "' does not exist or is not a version " << BinaryLogFormat::kVersion << " binary log" << std::endl;
+		return false;
+	}
+
+	out << "-- " << path << ", file " << index << " of the session started at " << Timestamp(start, 0) << std::endl;
+
+	std::map<uint16_t, DecodedFormat> formats;
+	std::vector<std::string> args;
+	uint8_t record;
+	bool truncated = false;
+
+	while (Read(in, &record) == true)
+	{
+		uint16_t id = 0;
+		if (Read(in, &id) == false)
+		{
+			truncated = true;
+			break;
+		}
+
+		if (record == BinaryLogFormat::RecordTypes::kFormat)
+		{
+			DecodedFormat format;
+			if (Read(in, &format.type) == false || ReadString(in, &format.category) == false || ReadString(in, &format.format) == false)
+			{
+				truncated = true;
+				break;
+			}
+
+			formats[id] = format;
+			continue;
+		}
+
+		if (record != BinaryLogFormat::RecordTypes::kMessage)
+		{
+			std::cerr << "'" << path << "' contains an unknown record type " << static_cast<unsigned int>(record) << ", stopping" << std::endl;
+			return false;
+		}
+
+		uint64_t us = 0;
+		uint8_t count = 0;
+
+		if (Read(in, &us) == false || Read(in, &count) == false)
+		{
+			truncated = true;
+			break;
+		}
+
+		args.resize(count);
+
+		bool complete = true;
+		for (uint8_t i = 0; i < count && complete == true; ++i)
+		{
+			complete = ReadArgument(in, &args.at(i));
+		}
+
+		if (complete == false)
+		{
+			truncated = true;
+			break;
+		}
+
+		std::map<uint16_t, DecodedFormat>::iterator it = formats.find(id);
+		if (it == formats.end())
+		{
+			out << "[" << Timestamp(start, us) << "] [?] unknown format " << id << BinaryLogFormat::Substitute("", args) << std::endl;
+			continue;
+		}
+
+		const DecodedFormat& format = it->second;
+		out << "[" << Timestamp(start, us) << "] [" << format.category << "] " << TypeToString(format.type) << " " << BinaryLogFormat::Substitute(format.format, args) << std::endl;
+	}
+
+	if (truncated == true)
+	{
+		out << "-- " << path << " ends in a truncated record" << std::endl;
+	}
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: snuffbox-log-decoder <file.snlog>..." << std::endl;
+		std::cerr << "Decodes binary logs to text, pass rotated files oldest first to read a session in order" << std::endl;
+		return 1;
+	}
+
+	int result = 0;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (Decode(argv[i], std::cout) == false)
+		{
+			result = 1;
+		}
+	}
+
+	return result;
+}
\ No newline at end of file
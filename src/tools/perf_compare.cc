@@ -0,0 +1,434 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+* @struct Value
+* @brief A parsed JSON value, only what the performance reports use
+* @author Danil Konings
+*/
+struct Value
+{
+	/// Default constructor
+	Value() : type(kNull), number(0.0), boolean(false){}
+
+	enum Types
+	{
+		kNull,
+		kBool,
+		kNumber,
+		kString,
+		kArray,
+		kObject
+	};
+
+	Types type; //!< The type of the value
+	double number; //!< The value of a number
+	bool boolean; //!< The value of a boolean
+	std::string string; //!< The value of a string
+	std::vector<Value> array; //!< The elements of an array
+	std::map<std::string, Value> object; //!< The fields of an object
+};
+
+/**
+* @struct Metric
+* @brief The comparison of a single metric
+* @author Danil Konings
+*/
+struct Metric
+{
+	std::string name; //!< The name of the metric
+	std::string unit; //!< The unit of the metric, 'ms' or 'count'
+	double baseline; //!< The median of the baseline
+	double current; //!< The median of the report
+	double tolerance; //!< The allowed increase in percent
+	std::string status; //!< 'ok', 'regressed', 'improved', 'missing' or 'new'
+};
+
+//-------------------------------------------------------------------------------------------
+static void SkipWhitespace(const std::string& src, size_t* pos)
+{
+	while (*pos < src.size() && (src[*pos] == ' ' || src[*pos] == '\t' || src[*pos] == '\n' || src[*pos] == '\r'))
+	{
+		++(*pos);
+	}
+}
+
+//-------------------------------------------------------------------------------------------
+static bool ParseValue(const std::string& src, size_t* pos, Value* value);
+
+//-------------------------------------------------------------------------------------------
+static bool ParseString(const std::string& src, size_t* pos, std::string* value)
+{
+	if (*pos >= src.size() || src[*pos] != '"')
+	{
+		return false;
+	}
+
+	++(*pos);
+	value->clear();
+
+	while (*pos < src.size() && src[*pos] != '"')
+	{
+		if (src[*pos] == '\\' && *pos + 1 < src.size())
+		{
+			++(*pos);
+		}
+
+		value->push_back(src[(*pos)++]);
+	}
+
+	if (*pos >= src.size())
+	{
+		return false;
+	}
+
+	++(*pos);
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------
+static bool ParseValue(const std::string& src, size_t* pos, Value* value)
+{
+	SkipWhitespace(src, pos);
+
+	if (*pos >= src.size())
+	{
+		return false;
+	}
+
+	char c = src[*pos];
+
+	if (c == '{' || c == '[')
+	{
+		bool object = c == '{';
+		char close = object == true ? '}' : ']';
+
+		value->type = object == true ? Value::Types::kObject : Value::Types::kArray;
+		++(*pos);
+		SkipWhitespace(src, pos);
+
+		if (*pos < src.size() && src[*pos] == close)
+		{
+			++(*pos);
+			return true;
+		}
+
+		while (*pos < src.size())
+		{
+			Value element;
+			std::string key;
+
+			if (object == true)
+			{
+				SkipWhitespace(src, pos);
+				if (ParseString(src, pos, &key) == false)
+				{
+					return false;
+				}
+
+				SkipWhitespace(src, pos);
+				if (*pos >= src.size() || src[(*pos)++] != ':')
+				{
+					return false;
+				}
+			}
+
+			if (ParseValue(src, pos, &element) == false)
+			{
+				return false;
+			}
+
+			if (object == true)
+			{
+				value->object[key] = element;
+			}
+			else
+			{
+				value->array.push_back(element);
+			}
+
+			SkipWhitespace(src, pos);
+			if (*pos < src.size() && src[*pos] == ',')
+			{
+				++(*pos);
+				continue;
+			}
+
+			if (*pos < src.size() && src[*pos] == close)
+			{
+				++(*pos);
+				return true;
+			}
+
+			return false;
+		}
+
+		return false;
+	}
+
+	if (c == '"')
+	{
+		value->type = Value::Types::kString;
+		return ParseString(src, pos, &value->string);
+	}
+
+	if (src.compare(*pos, 4, "true") == 0 || src.compare(*pos, 5, "false") == 0)
+	{
+		value->type = Value::Types::kBool;
+		value->boolean = c == 't';
+		*pos += value->boolean == true ? 4 : 5;
+		return true;
+	}
+
+	if (src.compare(*pos, 4, "null") == 0)
+	{
+		value->type = Value::Types::kNull;
+		*pos += 4;
+		return true;
+	}
+
+	const char* start = src.c_str() + *pos;
+	char* end = nullptr;
+
+	value->type = Value::Types::kNumber;
+	value->number = strtod(start, &end);
+
+	if (end == start)
+	{
+		return false;
+	}
+
+	*pos += end - start;
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------
+static bool Load(const std::string& path, Value* value)
+{
+	std::ifstream in(path, std::ios::binary);
+
+	if (!in)
+	{
+		std::cerr << "Could not open '" << path << "'" << std::endl;
+		return false;
+	}
+
+	std::stringstream buffer;
+	buffer << in.rdbuf();
+
+	std::string src = buffer.str();
+	size_t pos = 0;
+
+	if (ParseValue(src, &pos, value) == false || value->type != Value::Types::kObject || value->object["metrics"].type != Value::Types::kObject)
+	{
+		std::cerr << "'" << path << "' is not a performance report" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------
+static std::string Escape(const std::string& value)
+{
+	std::string result;
+	for (size_t i = 0; i < value.size(); ++i)
+	{
+		if (value[i] == '"' || value[i] == '\\')
+		{
+			result.push_back('\\');
+		}
+
+		result.push_back(value[i]);
+	}
+
+	return result;
+}
+
+//-------------------------------------------------------------------------------------------
+static std::string ToString(const double& value)
+{
+	char buffer[32];
+	snprintf(buffer, sizeof(buffer), "%.6g", value);
+	return buffer;
+}
+
+//-------------------------------------------------------------------------------------------
+static int Usage()
+{
+	std::cerr << "Usage: snuffbox-perf-compare <report.json> <baseline.json> [options]" << std::endl;
+	std::cerr << "Compares the medians of a performance report with a baseline, writes the result as JSON to stdout and returns 1 on a regression" << std::endl;
+	std::cerr << "  --tolerance <percent>        The allowed increase of timings, 10 by default" << std::endl;
+	std::cerr << "  --count-tolerance <percent>  The allowed increase of allocations and draw submissions, 0 by default" << std::endl;
+	std::cerr << "  --metric <name>=<percent>    The allowed increase of a single metric" << std::endl;
+	std::cerr << "  --min-ms <ms>                Timing changes smaller than this are never regressions, 0.05 by default" << std::endl;
+	std::cerr << "  --output <path>              Write the result to a file instead of stdout" << std::endl;
+	return 2;
+}
+
+//-------------------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		return Usage();
+	}
+
+	double tolerance = 10.0;
+	double count_tolerance = 0.0;
+	double min_ms = 0.05;
+	std::string output;
+	std::map<std::string, double> overrides;
+
+	for (int i = 3; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+
+		if (i + 1 >= argc)
+		{
+			return Usage();
+		}
+
+		std::string next = argv[++i];
+
+		if (arg == "--tolerance")
+		{
+			tolerance = atof(next.c_str());
+		}
+		else if (arg == "--count-tolerance")
+		{
+			count_tolerance = atof(next.c_str());
+		}
+		else if (arg == "--min-ms")
+		{
+			min_ms = atof(next.c_str());
+		}
+		else if (arg == "--output")
+		{
+			output = next;
+		}
+		else if (arg == "--metric" && next.find('=') != std::string::npos)
+		{
+			size_t split = next.rfind('=');
+			overrides[next.substr(0, split)] = atof(next.substr(split + 1).c_str());
+		}
+		else
+		{
+			return Usage();
+		}
+	}
+
+	Value report, baseline;
+	if (Load(argv[1], &report) == false || Load(argv[2], &baseline) == false)
+	{
+		return 2;
+	}
+
+	std::map<std::string, Value>& current_metrics = report.object["metrics"].object;
+	std::map<std::string, Value>& baseline_metrics = baseline.object["metrics"].object;
+
+	std::vector<Metric> metrics;
+	int regressions = 0;
+
+	for (std::map<std::string, Value>::iterator it = baseline_metrics.begin(); it != baseline_metrics.end(); ++it)
+	{
+		Metric metric;
+		metric.name = it->first;
+		metric.unit = it->second.object["unit"].string;
+		metric.baseline = it->second.object["median"].number;
+		metric.current = 0.0;
+
+		bool timing = metric.unit == "ms";
+		std::map<std::string, double>::iterator override_it = overrides.find(metric.name);
+		metric.tolerance = override_it != overrides.end() ? override_it->second : (timing == true ? tolerance : count_tolerance);
+
+		std::map<std::string, Value>::iterator found = current_metrics.find(metric.name);
+		if (found == current_metrics.end())
+		{
+			metric.status = "missing";
+			metrics.push_back(metric);
+			continue;
+		}
+
+		metric.current = found->second.object["median"].number;
+
+		double limit = metric.baseline * (1.0 + metric.tolerance / 100.0);
+		double floor = metric.baseline * (1.0 - metric.tolerance / 100.0);
+		double slack = timing == true ? min_ms : 0.0;
+
+		if (metric.current > limit && metric.current - metric.baseline > slack)
+		{
+			metric.status = "regressed";
+			++regressions;
+		}
+		else if (metric.current < floor && metric.baseline - metric.current > slack)
+		{
+			metric.status = "improved";
+		}
+		else
+		{
+			metric.status = "ok";
+		}
+
+		metrics.push_back(metric);
+	}
+
+	for (std::map<std::string, Value>::iterator it = current_metrics.begin(); it != current_metrics.end(); ++it)
+	{
+		if (baseline_metrics.find(it->first) == baseline_metrics.end())
+		{
+			Metric metric = { it->first, it->second.object["unit"].string, 0.0, it->second.object["median"].number, 0.0, "new" };
+			metrics.push_back(metric);
+		}
+	}
+
+	std::string result = "{\"report\":\"" + Escape(argv[1]) + "\",\"baseline\":\"" + Escape(argv[2]) + "\"";
+	result += ",\"scene\":\"" + Escape(report.object["scene"].string) + "\"";
+	result += ",\"passed\":" + std::string(regressions == 0 ? "true" : "false");
+	result += ",\"regressions\":" + std::to_string(regressions);
+	result += ",\"metrics\":[";
+
+	for (size_t i = 0; i < metrics.size(); ++i)
+	{
+		const Metric& metric = metrics.at(i);
+		double change = metric.baseline != 0.0 ? (metric.current - metric.baseline) / metric.baseline * 100.0 : 0.0;
+
+		result += i == 0 ? "" : ",";
+		result += "{\"name\":\"" + Escape(metric.name) + "\",\"unit\":\"" + metric.unit + "\",\"status\":\"" + metric.status + "\"";
+		result += ",\"baseline\":" + ToString(metric.baseline) + ",\"current\":" + ToString(metric.current);
+		result += ",\"change\":" + ToString(change) + ",\"tolerance\":" + ToString(metric.tolerance) + "}";
+
+		if (metric.status != "ok")
+		{
+			std::cerr << metric.status << ": " << metric.name << " " << ToString(metric.baseline) << " -> " << ToString(metric.current) << " " << metric.unit;
+			std::cerr << " (" << (change >= 0.0 ? "+" : "") << ToString(change) << "%, tolerance " << ToString(metric.tolerance) << "%)" << std::endl;
+		}
+	}
+
+	result += "]}";
+
+	if (output.empty() == true)
+	{
+		std::cout << result << std::endl;
+	}
+	else
+	{
+		std::ofstream out(output, std::ios::binary);
+		if (!out)
+		{
+			std::cerr << "Could not write '" << output << "'" << std::endl;
+			return 2;
+		}
+
+		out << result;
+	}
+
+	std::cerr << metrics.size() << " metric(s) compared, " << regressions << " regression(s)" << std::endl;
+	return regressions == 0 ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+# Runs every performance scene headless and compares its report with the baseline next to it
+#
+# Expects SNUFF_EXECUTABLE, SNUFF_COMPARE, SNUFF_GAME_DIR, SNUFF_PERF_SCENES (separated by '|'), SNUFF_PERF_FRAMES, SNUFF_PERF_TOLERANCE and
+# SNUFF_PERF_REQUIRE_BASELINE. The report of 'perf/<scene>.js' is written to 'perf/<scene>.report.json' and compared with 'perf/<scene>.baseline.json',
+# the result of the comparison is written to 'perf/<scene>.result.json'. A scene without a baseline fails when SNUFF_PERF_REQUIRE_BASELINE is set,
+# otherwise its report is stored as the baseline, to be committed once it was recorded on the reference machine.
+
+STRING (REPLACE "|" ";" SCENES "${SNUFF_PERF_SCENES}")
+SET (FAILED "")
+
+FOREACH (SCENE ${SCENES})
+	GET_FILENAME_COMPONENT (SCENE_DIR ${SCENE} DIRECTORY)
+	GET_FILENAME_COMPONENT (SCENE_NAME ${SCENE} NAME_WE)
+
+	SET (REPORT "${SCENE_DIR}/${SCENE_NAME}.report.json")
+	SET (BASELINE "${SNUFF_GAME_DIR}/${SCENE_DIR}/${SCENE_NAME}.baseline.json")
+	SET (RESULT "${SNUFF_GAME_DIR}/${SCENE_DIR}/${SCENE_NAME}.result.json")
+
+	FILE (REMOVE "${SNUFF_GAME_DIR}/${REPORT}")
+	MESSAGE (STATUS "Measuring ${SCENE} for ${SNUFF_PERF_FRAMES} frames")
+
+	EXECUTE_PROCESS (
+		COMMAND ${SNUFF_EXECUTABLE}
+			-src_directory ${SNUFF_GAME_DIR}
+			-headless true
+			-console false
+			-max_fps 0
+			-perf_frames ${SNUFF_PERF_FRAMES}
+			-perf_scene ${SCENE}
+			-perf_report ${REPORT}
+		WORKING_DIRECTORY ${SNUFF_GAME_DIR}
+		RESULT_VARIABLE RUN_RESULT)
+
+	IF (NOT EXISTS "${SNUFF_GAME_DIR}/${REPORT}")
+		MESSAGE (SEND_ERROR "${SCENE} did not write a report, the engine crashed or the scene quit early after a failed check (exit code '${RUN_RESULT}')")
+		LIST (APPEND FAILED ${SCENE})
+	ELSEIF (NOT EXISTS "${BASELINE}" AND SNUFF_PERF_REQUIRE_BASELINE)
+		MESSAGE (SEND_ERROR "${SCENE} has no baseline at '${BASELINE}', record one with SNUFF_PERF_REQUIRE_BASELINE off and commit it")
+		LIST (APPEND FAILED ${SCENE})
+	ELSEIF (NOT EXISTS "${BASELINE}")
+		CONFIGURE_FILE ("${SNUFF_GAME_DIR}/${REPORT}" "${BASELINE}" COPYONLY)
+		MESSAGE (WARNING "${SCENE} has no baseline yet, stored this run as '${BASELINE}'")
+	ELSE ()
+		EXECUTE_PROCESS (
+			COMMAND ${SNUFF_COMPARE} "${SNUFF_GAME_DIR}/${REPORT}" "${BASELINE}" --tolerance ${SNUFF_PERF_TOLERANCE} --output "${RESULT}"
+			RESULT_VARIABLE COMPARE_RESULT)
+
+		IF (NOT COMPARE_RESULT EQUAL 0)
+			LIST (APPEND FAILED ${SCENE})
+		ENDIF ()
+	ENDIF ()
+ENDFOREACH ()
+
+IF (FAILED)
+	MESSAGE (FATAL_ERROR "Performance regressions or errors in: ${FAILED}")
+ENDIF ()
\ No newline at end of file
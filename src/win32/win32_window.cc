@@ -449,7 +449,7 @@ namespace snuffbox
     JSWrapper wrapper(args);
     Window* self = Game::Instance()->window();
 
-    if (wrapper.Check("NN") == true)
+    if (self != nullptr && wrapper.Check("NN") == true)
     {
       self->SetSize(wrapper.GetValue<int>(0, 640), wrapper.GetValue<int>(1, 480));
     }
@@ -463,8 +463,18 @@ namespace snuffbox
 
     v8::Handle<v8::Object> obj = JSWrapper::CreateObject();
 
-    JSWrapper::SetObjectValue(obj, "w", self->width());
-    JSWrapper::SetObjectValue(obj, "h", self->height());
+    // Headless runs have no window, they report the size of their offscreen back buffer instead
+    if (self == nullptr)
+    {
+      XMFLOAT2 size = PlatformRenderDevice::Instance()->output_size();
+      JSWrapper::SetObjectValue(obj, "w", static_cast<int>(size.x));
+      JSWrapper::SetObjectValue(obj, "h", static_cast<int>(size.y));
+    }
+    else
+    {
+      JSWrapper::SetObjectValue(obj, "w", self->width());
+      JSWrapper::SetObjectValue(obj, "h", self->height());
+    }
 
     wrapper.ReturnValue<v8::Handle<v8::Object>>(obj);
   }
@@ -475,7 +485,7 @@ namespace snuffbox
     JSWrapper wrapper(args);
     Window* self = Game::Instance()->window();
 
-    wrapper.ReturnValue<std::string>(self->name());
+    wrapper.ReturnValue<std::string>(self == nullptr ? "" : self->name());
   }
 
   //-------------------------------------------------------------------------------------------
@@ -484,7 +494,7 @@ namespace snuffbox
     JSWrapper wrapper(args);
     Window* self = Game::Instance()->window();
 
-    if (wrapper.Check("S") == true)
+    if (self != nullptr && wrapper.Check("S") == true)
     {
       self->SetName(wrapper.GetValue<std::string>(0, self->name()));
     }
@@ -496,7 +506,7 @@ namespace snuffbox
     JSWrapper wrapper(args);
     Window* self = Game::Instance()->window();
 
-    if (wrapper.Check("B") == true)
+    if (self != nullptr && wrapper.Check("B") == true)
     {
       self->set_cursor_clip(wrapper.GetValue<bool>(0, false));
     }